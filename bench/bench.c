@@ -0,0 +1,533 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "../src/bmp8.h"
+#include "../src/color.h"
+#include "../src/histogram.h"
+#include "../src/morphology.h"
+#include "../src/trace.h"
+
+// Dossier où les fonctions de chargement / sauvegarde cherchent les fichiers (voir bmp8_loadImage)
+#define BENCH_IMAGES_DIR "../images/"
+#define BENCH_FILE_8 "bench_tmp_8.bmp"
+#define BENCH_FILE_24 "bench_tmp_24.bmp"
+
+#define BENCH_MAX_SIZES 16
+#define BENCH_MAX_REPS 1000
+
+typedef enum {
+    PATTERN_UNIFORM = 0,
+    PATTERN_NOISE,
+    PATTERN_GRADIENT,
+    PATTERN_COUNT
+} t_bench_pattern;
+
+static const char *patternNames[PATTERN_COUNT] = {"uniform", "noise", "gradient"};
+
+// Images d'un cas de mesure : la source reste intacte, la copie de travail est restaurée avant chaque répétition
+typedef struct {
+    t_bmp8 *src8;
+    t_bmp8 *work8;
+    t_bmp24 *src24;
+    t_bmp24 *work24;
+} t_bench_images;
+
+typedef struct {
+    const char *name;
+    int depth; // 8 ou 24
+    void (*run)(t_bench_images *images);
+} t_bench_op;
+
+typedef struct {
+    double sizes[BENCH_MAX_SIZES]; // En mégapixels
+    int sizeCount;
+    int reps;
+    int warmup;
+    int patterns[PATTERN_COUNT];
+    const char *filter; // Sous-chaîne du nom des opérations à mesurer, ou NULL
+    const char *jsonPath; // Fichier JSON de sortie, ou NULL
+    const char *label; // Étiquette de la version mesurée, reprise dans le JSON
+    const char *tracePath; // Fichier Chrome Trace des opérations, ou NULL
+    int counters; // Compteurs matériels relevés pendant le traçage
+} t_bench_options;
+
+/**
+ * Renvoie un instant de l'horloge monotone
+ *
+ * @return double: Temps en secondes
+ */
+static double bench_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * Générateur pseudo-aléatoire déterministe (xorshift32)
+ *
+ * @param state L'état du générateur (non nul)
+ * @return unsigned int: La valeur suivante
+ */
+static unsigned int bench_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Crée une image 8 bits synthétique
+ *
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param pattern Le motif (uniforme, bruit, dégradé)
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+static t_bmp8 *bench_makeBmp8(int width, int height, t_bench_pattern pattern) {
+    t_bmp8 *img = bmp8_allocate((unsigned int) width, (unsigned int) height);
+    if (img == NULL) return NULL;
+
+    unsigned int stride = bmp8_rowSize(img);
+    unsigned int seed = 0x12345678u;
+    for (int y = 0; y < height; y++) {
+        unsigned char *row = img->data + (size_t) y * stride;
+        for (int x = 0; x < width; x++) {
+            switch (pattern) {
+                case PATTERN_UNIFORM:
+                    row[x] = 128;
+                    break;
+                case PATTERN_NOISE:
+                    row[x] = (unsigned char) (bench_random(&seed) >> 24);
+                    break;
+                default:
+                    row[x] = (unsigned char) (((long) x * 255 / (width > 1 ? width - 1 : 1) +
+                                               (long) y * 255 / (height > 1 ? height - 1 : 1)) / 2);
+                    break;
+            }
+        }
+    }
+    return img;
+}
+
+/**
+ * Crée une image 24 bits synthétique (en-têtes compris, pour pouvoir la sauvegarder)
+ *
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param pattern Le motif (uniforme, bruit, dégradé)
+ * @return t_bmp24*: L'image ou NULL en cas d'erreur
+ */
+static t_bmp24 *bench_makeBmp24(int width, int height, t_bench_pattern pattern) {
+    t_bmp24 *img = bmp24_allocate(width, height, 24);
+    if (img == NULL) return NULL;
+
+    uint32_t rowSize = bmp24_rowSize(width, DEFAULT_DEPTH);
+    img->header.type = BMP_TYPE;
+    img->header.offset = HEADER_SIZE + INFO_SIZE;
+    img->header_info.size = INFO_SIZE;
+    img->header_info.width = width;
+    img->header_info.height = height;
+    img->header_info.planes = 1;
+    img->header_info.bits = DEFAULT_DEPTH;
+    img->header_info.imagesize = rowSize * (uint32_t) height;
+    img->header.size = img->header.offset + img->header_info.imagesize;
+
+    unsigned int seed = 0x9e3779b9u;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            t_pixel *p = &img->data[y][x];
+            p->alpha = 255;
+            switch (pattern) {
+                case PATTERN_UNIFORM:
+                    p->red = 64;
+                    p->green = 128;
+                    p->blue = 192;
+                    break;
+                case PATTERN_NOISE: {
+                    unsigned int r = bench_random(&seed);
+                    p->red = (uint8_t) r;
+                    p->green = (uint8_t) (r >> 8);
+                    p->blue = (uint8_t) (r >> 16);
+                    break;
+                }
+                default:
+                    p->red = (uint8_t) ((long) x * 255 / (width > 1 ? width - 1 : 1));
+                    p->green = (uint8_t) ((long) y * 255 / (height > 1 ? height - 1 : 1));
+                    p->blue = (uint8_t) (255 - p->red / 2 - p->green / 2);
+                    break;
+            }
+        }
+    }
+    return img;
+}
+
+/**
+ * Remet la copie de travail dans l'état de la source (hors mesure)
+ *
+ * @param images Les images du cas de mesure
+ * @param depth La profondeur mesurée (8 ou 24)
+ */
+static void bench_restore(t_bench_images *images, int depth) {
+    if (depth == 8) {
+        memcpy(images->work8->data, images->src8->data, images->src8->dataSize);
+        bmp8_invalidateCache(images->work8);
+    } else {
+        // Les rangées sont contiguës (voir bmp24_allocateDataPixels)
+        memcpy(images->work24->data[0], images->src24->data[0],
+               (size_t) images->src24->width * images->src24->height * sizeof(t_pixel));
+    }
+}
+
+// Opérations 8 bits
+static void op8_load(t_bench_images *images) { (void) images; bmp8_free(bmp8_loadImage(BENCH_FILE_8)); }
+static void op8_save(t_bench_images *images) { bmp8_saveImage(images->work8, BENCH_FILE_8); }
+static void op8_negative(t_bench_images *images) { bmp8_negative(images->work8); }
+static void op8_brightness(t_bench_images *images) { bmp8_brightness(images->work8, 40); }
+static void op8_threshold(t_bench_images *images) { bmp8_threshold(images->work8, 128); }
+static void op8_boxBlur(t_bench_images *images) { bmp8_box_blur(images->work8); }
+static void op8_gaussianBlur(t_bench_images *images) { bmp8_gaussian_blur(images->work8); }
+static void op8_outline(t_bench_images *images) { bmp8_outline(images->work8); }
+static void op8_emboss(t_bench_images *images) { bmp8_emboss(images->work8); }
+static void op8_sharpen(t_bench_images *images) { bmp8_sharpen(images->work8); }
+static void op8_erode(t_bench_images *images) { bmp8_erode(images->work8, 5, 5); }
+static void op8_dilate(t_bench_images *images) { bmp8_dilate(images->work8, 5, 5); }
+static void op8_equalize(t_bench_images *images) { bmp8_equalize(images->work8); }
+static void op8_clahe(t_bench_images *images) { bmp8_equalizeCLAHE(images->work8, 8, 8, 2.0f); }
+
+static void op8_histogram(t_bench_images *images) {
+    unsigned int histogram[256];
+    bmp8_computeHistogramInto(images->work8, histogram);
+}
+
+// Opérations 24 bits
+static void op24_load(t_bench_images *images) { (void) images; bmp24_free(bmp24_loadImage(BENCH_FILE_24)); }
+static void op24_save(t_bench_images *images) { bmp24_saveImage(images->work24, BENCH_FILE_24); }
+static void op24_negative(t_bench_images *images) { bmp24_negative(images->work24); }
+static void op24_grayscale(t_bench_images *images) { bmp24_grayscale(images->work24); }
+static void op24_brightness(t_bench_images *images) { bmp24_brightness(images->work24, 40); }
+static void op24_boxBlur(t_bench_images *images) { bmp24_boxBlur(images->work24); }
+static void op24_gaussianBlur(t_bench_images *images) { bmp24_gaussianBlur(images->work24); }
+static void op24_outline(t_bench_images *images) { bmp24_outline(images->work24); }
+static void op24_emboss(t_bench_images *images) { bmp24_emboss(images->work24); }
+static void op24_sharpen(t_bench_images *images) { bmp24_sharpen(images->work24); }
+static void op24_equalize(t_bench_images *images) { bmp24_equalize(images->work24); }
+static void op24_equalizeStreaming(t_bench_images *images) { bmp24_equalizeStreaming(images->work24); }
+static void op24_clahe(t_bench_images *images) { bmp24_equalizeCLAHE(images->work24, 8, 8, 2.0f); }
+
+static void op24_histograms(t_bench_images *images) {
+    unsigned int histY[256], histR[256], histG[256], histB[256];
+    bmp24_computeHistograms(images->work24, histY, histR, histG, histB);
+}
+
+// La sauvegarde précède le chargement : le fichier lu est celui qui vient d'être écrit
+static const t_bench_op ops[] = {
+    {"bmp8_saveImage", 8, op8_save},
+    {"bmp8_loadImage", 8, op8_load},
+    {"bmp8_negative", 8, op8_negative},
+    {"bmp8_brightness", 8, op8_brightness},
+    {"bmp8_threshold", 8, op8_threshold},
+    {"bmp8_box_blur", 8, op8_boxBlur},
+    {"bmp8_gaussian_blur", 8, op8_gaussianBlur},
+    {"bmp8_outline", 8, op8_outline},
+    {"bmp8_emboss", 8, op8_emboss},
+    {"bmp8_sharpen", 8, op8_sharpen},
+    {"bmp8_erode_5x5", 8, op8_erode},
+    {"bmp8_dilate_5x5", 8, op8_dilate},
+    {"bmp8_computeHistogram", 8, op8_histogram},
+    {"bmp8_equalize", 8, op8_equalize},
+    {"bmp8_equalizeCLAHE", 8, op8_clahe},
+    {"bmp24_saveImage", 24, op24_save},
+    {"bmp24_loadImage", 24, op24_load},
+    {"bmp24_negative", 24, op24_negative},
+    {"bmp24_grayscale", 24, op24_grayscale},
+    {"bmp24_brightness", 24, op24_brightness},
+    {"bmp24_boxBlur", 24, op24_boxBlur},
+    {"bmp24_gaussianBlur", 24, op24_gaussianBlur},
+    {"bmp24_outline", 24, op24_outline},
+    {"bmp24_emboss", 24, op24_emboss},
+    {"bmp24_sharpen", 24, op24_sharpen},
+    {"bmp24_computeHistograms", 24, op24_histograms},
+    {"bmp24_equalize", 24, op24_equalize},
+    {"bmp24_equalizeStreaming", 24, op24_equalizeStreaming},
+    {"bmp24_equalizeCLAHE", 24, op24_clahe},
+};
+
+#define OP_COUNT ((int) (sizeof(ops) / sizeof(ops[0])))
+
+/**
+ * Mesure une opération : répétitions de chauffe, puis répétitions chronométrées une à une
+ *
+ * @param op L'opération
+ * @param images Les images du cas de mesure
+ * @param options Les options du banc d'essai
+ * @param samples Tableau qui reçoit la durée de chaque répétition (en secondes)
+ */
+static void bench_measure(const t_bench_op *op, t_bench_images *images, const t_bench_options *options,
+                          double *samples) {
+    for (int i = 0; i < options->warmup; i++) {
+        bench_restore(images, op->depth);
+        op->run(images);
+    }
+    for (int i = 0; i < options->reps; i++) {
+        bench_restore(images, op->depth);
+        double start = bench_now();
+        op->run(images);
+        samples[i] = bench_now() - start;
+    }
+}
+
+/**
+ * Affiche l'aide du banc d'essai
+ *
+ * @param program Le nom de l'exécutable
+ */
+static void bench_usage(const char *program) {
+    printf("Usage: %s [options]\n", program);
+    printf("  --sizes a,b,...   Tailles des images en mégapixels (défaut: 0.3,1,4)\n");
+    printf("  --full            Toutes les tailles: 0.3,1,4,16,100\n");
+    printf("  --reps n          Répétitions chronométrées (défaut: 5)\n");
+    printf("  --warmup n        Répétitions de chauffe (défaut: 1)\n");
+    printf("  --patterns list   Motifs parmi uniform,noise,gradient (défaut: tous)\n");
+    printf("  --filter texte    Ne mesure que les opérations dont le nom contient ce texte\n");
+    printf("  --json fichier    Écrit les résultats en JSON dans ce fichier\n");
+    printf("  --label texte     Étiquette de la version mesurée (reprise dans le JSON)\n");
+    printf("  --trace fichier   Trace Chrome des opérations (compilation avec IMAGE_PROCESSING_TRACE)\n");
+    printf("  --counters        Avec --trace : compteurs matériels par opération (Linux)\n");
+}
+
+/**
+ * Lit les options de la ligne de commande
+ *
+ * @param argc Nombre d'arguments
+ * @param argv Les arguments
+ * @param options Les options à remplir
+ * @return int: 1 si les options sont valides, 0 sinon
+ */
+static int bench_parseOptions(int argc, char **argv, t_bench_options *options) {
+    const double defaultSizes[] = {0.3, 1.0, 4.0};
+    const double fullSizes[] = {0.3, 1.0, 4.0, 16.0, 100.0};
+
+    memcpy(options->sizes, defaultSizes, sizeof(defaultSizes));
+    options->sizeCount = 3;
+    options->reps = 5;
+    options->warmup = 1;
+    for (int p = 0; p < PATTERN_COUNT; p++) options->patterns[p] = 1;
+    options->filter = NULL;
+    options->jsonPath = NULL;
+    options->label = "";
+    options->tracePath = NULL;
+    options->counters = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--full") == 0) {
+            memcpy(options->sizes, fullSizes, sizeof(fullSizes));
+            options->sizeCount = 5;
+            continue;
+        }
+        if (strcmp(arg, "--counters") == 0) {
+            options->counters = 1;
+            continue;
+        }
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return 0;
+        }
+        if (value == NULL) {
+            fprintf(stderr, "Option inconnue ou valeur manquante: %s\n", arg);
+            return 0;
+        }
+        i++;
+
+        if (strcmp(arg, "--sizes") == 0) {
+            options->sizeCount = 0;
+            const char *p = value;
+            while (*p != '\0' && options->sizeCount < BENCH_MAX_SIZES) {
+                char *end;
+                double size = strtod(p, &end);
+                if (end == p || size <= 0.0) {
+                    fprintf(stderr, "Taille invalide: %s\n", value);
+                    return 0;
+                }
+                options->sizes[options->sizeCount++] = size;
+                p = *end == ',' ? end + 1 : end;
+            }
+        } else if (strcmp(arg, "--reps") == 0) {
+            options->reps = atoi(value);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options->warmup = atoi(value);
+        } else if (strcmp(arg, "--patterns") == 0) {
+            for (int p = 0; p < PATTERN_COUNT; p++) options->patterns[p] = strstr(value, patternNames[p]) != NULL;
+        } else if (strcmp(arg, "--filter") == 0) {
+            options->filter = value;
+        } else if (strcmp(arg, "--json") == 0) {
+            options->jsonPath = value;
+        } else if (strcmp(arg, "--label") == 0) {
+            options->label = value;
+        } else if (strcmp(arg, "--trace") == 0) {
+            options->tracePath = value;
+        } else {
+            fprintf(stderr, "Option inconnue: %s\n", arg);
+            return 0;
+        }
+    }
+
+    if (options->reps < 1 || options->reps > BENCH_MAX_REPS || options->warmup < 0) {
+        fprintf(stderr, "Nombre de répétitions invalide (1 à %d)\n", BENCH_MAX_REPS);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Écrit une chaîne JSON (les noms et étiquettes n'ont besoin que des échappements de base)
+ *
+ * @param out Le fichier de sortie
+ * @param text Le texte
+ */
+static void bench_jsonString(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const char *p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', out);
+        if ((unsigned char) *p >= 0x20) fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * Programme de mesure des performances sur des images synthétiques
+ */
+int main(int argc, char **argv) {
+    t_bench_options options;
+    if (!bench_parseOptions(argc, argv, &options)) {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    FILE *json = NULL;
+    if (options.jsonPath != NULL) {
+        // Pas de JSON sur la sortie standard : les sauvegardes y affichent le chemin du fichier
+        json = fopen(options.jsonPath, "w");
+        if (json == NULL) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", options.jsonPath);
+            return 1;
+        }
+        fprintf(json, "{\n  \"label\": ");
+        bench_jsonString(json, options.label);
+        fprintf(json, ",\n  \"reps\": %d,\n  \"warmup\": %d,\n  \"results\": [", options.reps, options.warmup);
+    }
+    if (options.tracePath != NULL && trace_start(1 << 20) != 0) {
+        options.tracePath = NULL;
+    }
+    if (options.tracePath != NULL && options.counters) {
+        trace_enableCounters(1);
+    }
+
+    double samples[BENCH_MAX_REPS];
+    int first = 1;
+
+    printf("%-24s %-8s %11s %10s %10s %10s %9s\n", "operation", "motif", "taille", "moy. ms", "écart ms",
+            "MP/s", "ns/px");
+
+    for (int s = 0; s < options.sizeCount; s++) {
+        int side = (int) (sqrt(options.sizes[s] * 1e6) + 0.5);
+        if (side < 1) side = 1;
+        double megapixels = (double) side * side / 1e6;
+
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            if (!options.patterns[p]) continue;
+
+            t_bench_images images = {NULL, NULL, NULL, NULL};
+            images.src8 = bench_makeBmp8(side, side, (t_bench_pattern) p);
+            images.work8 = bench_makeBmp8(side, side, (t_bench_pattern) p);
+            images.src24 = bench_makeBmp24(side, side, (t_bench_pattern) p);
+            images.work24 = bench_makeBmp24(side, side, (t_bench_pattern) p);
+            if (images.src8 == NULL || images.work8 == NULL || images.src24 == NULL || images.work24 == NULL) {
+                fprintf(stderr, "Mémoire insuffisante pour une image de %dx%d\n", side, side);
+                bmp8_free(images.src8);
+                bmp8_free(images.work8);
+                bmp24_free(images.src24);
+                bmp24_free(images.work24);
+                continue;
+            }
+
+            for (int o = 0; o < OP_COUNT; o++) {
+                const t_bench_op *op = &ops[o];
+                if (options.filter != NULL && strstr(op->name, options.filter) == NULL) continue;
+
+                bench_measure(op, &images, &options, samples);
+
+                double sum = 0.0, best = samples[0];
+                for (int i = 0; i < options.reps; i++) {
+                    sum += samples[i];
+                    if (samples[i] < best) best = samples[i];
+                }
+                double mean = sum / options.reps;
+                double variance = 0.0;
+                for (int i = 0; i < options.reps; i++) variance += (samples[i] - mean) * (samples[i] - mean);
+                variance = options.reps > 1 ? variance / (options.reps - 1) : 0.0;
+                double stddev = sqrt(variance);
+                double throughput = mean > 0.0 ? megapixels / mean : 0.0;
+                double nsPerPixel = mean * 1e9 / ((double) side * side);
+
+                char size[32];
+                snprintf(size, sizeof(size), "%dx%d", side, side);
+                printf("%-24s %-8s %11s %10.3f %10.3f %10.1f %9.2f\n", op->name, patternNames[p], size,
+                        mean * 1e3, stddev * 1e3, throughput, nsPerPixel);
+
+                if (json != NULL) {
+                    fprintf(json, "%s\n    {\"name\": ", first ? "" : ",");
+                    bench_jsonString(json, op->name);
+                    fprintf(json, ", \"depth\": %d, \"pattern\": \"%s\", \"width\": %d, \"height\": %d, "
+                                  "\"megapixels\": %.4f, \"mean_ms\": %.6f, \"min_ms\": %.6f, \"stddev_ms\": %.6f, "
+                                  "\"variance_ms2\": %.6f, \"mpixels_per_s\": %.3f, \"ns_per_pixel\": %.4f}",
+                            op->depth, patternNames[p], side, side, megapixels, mean * 1e3, best * 1e3,
+                            stddev * 1e3, variance * 1e6, throughput, nsPerPixel);
+                    first = 0;
+                }
+            }
+
+            bmp8_free(images.src8);
+            bmp8_free(images.work8);
+            bmp24_free(images.src24);
+            bmp24_free(images.work24);
+        }
+    }
+
+    if (options.tracePath != NULL) {
+        trace_stop();
+        printf("\n");
+        trace_printSummary();
+        trace_writeChrome(options.tracePath);
+        trace_free();
+    }
+
+    remove(BENCH_IMAGES_DIR BENCH_FILE_8);
+    remove(BENCH_IMAGES_DIR BENCH_FILE_24);
+
+    if (json != NULL) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    return 0;
+}
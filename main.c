@@ -1,17 +1,156 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
 #include <windows.h>
+#endif
 
 #include "./src/utils/utils.h"
 #include "./src/bmp8.h"
+#include "./src/cache.h"
 #include "./src/color.h"
 #include "./src/histogram.h"
+#include "./src/history.h"
+#include "./src/job.h"
+#include "./src/pnm.h"
+#include "./src/server.h"
+
+/**
+ * Mode filtre Unix : lit des images PGM (P5) ou PPM (P6) sur l'entrée standard,
+ * applique les filtres dans l'ordre et écrit chaque résultat sur la sortie standard
+ * Exemple : cat scan.pgm | ./Image_Processing --pipe egalisation nettete > out.pgm
+ *
+ * @param filters Les noms des filtres
+ * @param count Nombre de filtres
+ * @return int: Code de retour du programme
+ */
+static int main_pipe(char **filters, int count) {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    int images = 0;
+    t_pnm_stream stream;
+    int status;
+    while ((status = pnm_readHeader(&stream, stdin)) == 0) {
+        t_bmp8 *img = NULL;
+        t_bmp24 *img24 = NULL;
+        if (stream.channels == 1) img = bmp8_readPnm(&stream);
+        else img24 = bmp24_readPnm(&stream);
+        if (img == NULL && img24 == NULL) return 1;
+
+        for (int i = 0; i < count; i++) {
+            if (job_applyFilter(filters[i], img, img24) != 0) {
+                fprintf(stderr, "Filtre inconnu ou non applicable : %s\n", filters[i]);
+                bmp8_free(img);
+                bmp24_free(img24);
+                return 1;
+            }
+        }
+
+        int written = img != NULL ? bmp8_writePgm(img, stdout) : bmp24_writePpm(img24, stdout);
+        bmp8_free(img);
+        bmp24_free(img24);
+        if (written != 0) return 1;
+        images++;
+    }
+
+    if (status < 0) return 1;
+    if (images == 0) fprintf(stderr, "Aucune image PGM/PPM sur l'entrée standard\n");
+    return images == 0;
+}
+
+// Mémoire maximale de l'historique d'annulation du mode interactif
+#define MAIN_HISTORY_BYTES ((size_t) 512 << 20)
+
+// Taille maximale du dossier du cache de résultats du mode --apply
+#define MAIN_CACHE_DISK_BYTES ((size_t) 256 << 20)
+
+/**
+ * Mode traitement d'un fichier : charge une image BMP, applique les filtres dans l'ordre et sauvegarde
+ * le résultat. Avec --cache, le résultat est cherché d'abord dans le cache de résultats (clé : pixels
+ * de l'entrée et chaîne de filtres) et recopié tel quel s'il y est, sans aucun traitement.
+ * Exemple : ./Image_Processing --apply lena_gray.bmp sortie.bmp --cache /tmp/cache egalisation nettete
+ *
+ * @param input Le fichier d'entrée (dans ./images/...)
+ * @param output Le fichier de sortie (dans ./images/...)
+ * @param directory Le dossier du cache ou NULL
+ * @param filters Les noms des filtres
+ * @param count Nombre de filtres
+ * @return int: Code de retour du programme
+ */
+static int main_apply(const char *input, const char *output, const char *directory, char **filters, int count) {
+    // Un processus par requête : seul le cache disque (partagé entre processus) est utile ici
+    t_result_cache *cache = directory != NULL ? cache_create(directory, 0, MAIN_CACHE_DISK_BYTES) : NULL;
+
+    const char *error = NULL;
+    int status = job_run(input, output, filters, count, cache, NULL, &error);
+    if (status != 0) fprintf(stderr, "Échec du traitement de %s : %s\n", input, error);
+    cache_destroy(cache);
+    return status != 0;
+}
+
+/**
+ * Mode serveur : ./Image_Processing --server <socket> [-j threads] [--cache dossier]
+ * Mode client : ./Image_Processing --client <socket> [-n requêtes] [--compare] <entrée> <sortie> [filtre...]
+ *
+ * @param argc Nombre d'arguments
+ * @param argv Les arguments du programme (argv[1] vaut --server ou --client)
+ * @return int: Code de retour du programme
+ */
+static int main_server(int argc, char **argv) {
+    int server = strcmp(argv[1], "--server") == 0;
+    int threads = 4, requests = 100, compare = 0;
+    const char *directory = NULL;
+
+    int i = 3;
+    for (; i < argc; i++) {
+        if (server && strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (server && strcmp(argv[i], "--cache") == 0 && i + 1 < argc) directory = argv[++i];
+        else if (!server && strcmp(argv[i], "-n") == 0 && i + 1 < argc) requests = atoi(argv[++i]);
+        else if (!server && strcmp(argv[i], "--compare") == 0) compare = 1;
+        else break;
+    }
+
+    if (server) return server_run(argv[2], threads, directory);
+    return server_client(argv[2], requests, argv + i, argc - i, compare ? argv[0] : NULL);
+}
+
+/**
+ * Ajoute l'image courante à l'historique d'annulation. En cas d'échec l'historique est vidé :
+ * sa dernière étape ne correspondrait plus à l'image, et une annulation mélangerait les deux états
+ *
+ * @param history L'historique
+ * @param img Image 8 bits courante (ou NULL)
+ * @param img24 Image 24 bits courante (ou NULL)
+ */
+static void main_commitHistory(t_history *history, t_bmp8 *img, t_bmp24 *img24) {
+    int status = img24 != NULL ? history_commitBmp24(history, img24) : history_commitBmp8(history, img);
+    if (status != 0) {
+        history_clear(history);
+        printf("⚠️ Historique vidé : les opérations précédentes ne peuvent plus être annulées.\n\n");
+    }
+}
 
 /**
  * Fonction principale du programme de traitement d'images BMP
  */
-int main(void) {
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "--pipe") == 0) {
+        return main_pipe(argv + 2, argc - 2);
+    }
+    if (argc >= 4 && strcmp(argv[1], "--apply") == 0) {
+        int cached = argc >= 6 && strcmp(argv[4], "--cache") == 0;
+        return main_apply(argv[2], argv[3], cached ? argv[5] : NULL, argv + (cached ? 6 : 4), argc - (cached ? 6 : 4));
+    }
+    if (argc >= 3 && (strcmp(argv[1], "--server") == 0 || strcmp(argv[1], "--client") == 0)) {
+        return main_server(argc, argv);
+    }
+
+#ifdef _WIN32
     // Configurer la console pour utiliser l'UTF-8
     SetConsoleCP(CP_UTF8);
     SetConsoleOutputCP(CP_UTF8);
@@ -22,10 +161,15 @@ int main(void) {
     GetConsoleMode(hOut, &dwMode);
     dwMode |= ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING;
     SetConsoleMode(hOut, dwMode);
+#endif
 
     t_bmp8 *img = NULL;
     t_bmp24 *img24 = NULL;
 
+    // Une étape par opération. Les traitements du menu modifient toute l'image et ne déclarent donc
+    // pas de zone (history_markDirty) : chacune de leurs étapes copie toutes les tuiles
+    t_history *history = history_create(MAIN_HISTORY_BYTES);
+
     int choice;
     BMP_Type image_type = BMP_UNKNOWN;
 
@@ -34,7 +178,7 @@ int main(void) {
     while (1) {
         printf("#️⃣ Veuillez sélectionner une option : \n");
         printf(
-            "1. Ouvrir une image \n2. Sauvegarder l'image \n3. Appliquer un filtre \n4. Égaliser l'image \n5. Afficher les informations de l'image \n6. Quitter\n");
+            "1. Ouvrir une image \n2. Sauvegarder l'image \n3. Appliquer un filtre \n4. Égaliser l'image \n5. Afficher les informations de l'image \n6. Annuler \n7. Rétablir \n8. Quitter\n");
         printf(">>> Votre choix : ");
         scanf("%d", &choice);
 
@@ -54,15 +198,32 @@ int main(void) {
 
                 if (image_type == BMP_8BIT) {
                     printf("Chargement d'une image BMP 8-bit...\n");
-                    img = bmp8_loadImage(filename);
-                    if (img != NULL) printf("✨ Image chargée avec succès !\n\n");
+                    t_bmp8 *loaded = bmp8_loadImage(filename);
+                    if (loaded != NULL) {
+                        // L'image précédente et son historique sont remplacés
+                        bmp8_free(img);
+                        bmp24_free(img24);
+                        img24 = NULL;
+                        img = loaded;
+                        history_clear(history);
+                        main_commitHistory(history, img, NULL);
+                        printf("✨ Image chargée avec succès !\n\n");
+                    }
                     break;
                 }
 
                 if (image_type == BMP_24BIT) {
                     printf("Chargement d'une image BMP 24-bit...\n");
-                    img24 = bmp24_loadImage(filename);
-                    if (img24 != NULL) printf("✨ Image chargée avec succès !\n\n");
+                    t_bmp24 *loaded = bmp24_loadImage(filename);
+                    if (loaded != NULL) {
+                        bmp8_free(img);
+                        bmp24_free(img24);
+                        img = NULL;
+                        img24 = loaded;
+                        history_clear(history);
+                        main_commitHistory(history, NULL, img24);
+                        printf("✨ Image chargée avec succès !\n\n");
+                    }
                     break;
                 }
 
@@ -120,7 +281,17 @@ int main(void) {
                         break;
                     }
                     case 3: {
-                        if (image_type == BMP_24BIT) bmp24_grayscale(img24);
+                        if (image_type == BMP_24BIT) {
+                            // Conversion en véritable image 8 bits : la suite passe par les traitements bmp8_*
+                            t_bmp8 *gray = bmp24_toBmp8(img24);
+                            if (gray != NULL) {
+                                bmp24_free(img24);
+                                img24 = NULL;
+                                if (img != NULL) bmp8_free(img);
+                                img = gray;
+                                image_type = BMP_8BIT;
+                            }
+                        }
                         else bmp8_threshold(img, 128);
                         printf("✨ Filtre de binarisation appliqué !\n\n");
                         break;
@@ -160,6 +331,10 @@ int main(void) {
                     }
                 }
 
+                if (filter >= 1 && filter <= 8) {
+                    main_commitHistory(history, image_type == BMP_24BIT ? NULL : img,
+                                       image_type == BMP_24BIT ? img24 : NULL);
+                }
                 break;
             }
             case 4: {
@@ -170,12 +345,14 @@ int main(void) {
 
                 if (image_type == BMP_24BIT) {
                     bmp24_equalize(img24);
+                    main_commitHistory(history, NULL, img24);
                     printf("✨ Image égalisée avec succès !\n\n");
                     break;
                 }
 
                 if (image_type == BMP_8BIT) {
                     bmp8_equalize(img);
+                    main_commitHistory(history, img, NULL);
                     printf("✨ Image égalisée avec succès !\n\n");
                 }
 
@@ -190,13 +367,27 @@ int main(void) {
                 printf("------------- #️⃣ Informations sur l'image -------------\n");
                 if (image_type == BMP_24BIT) bmp24_printInfo(img24);
                 else bmp8_printInfo(img);
+                history_printStats(history);
                 printf("------------------------------------------------\n\n");
                 break;
             }
-            case 6: {
+            case 6:
+            case 7: {
+                // Seules les tuiles qui diffèrent entre les deux étapes sont recopiées dans l'image
+                int status = choice == 6 ? history_undo(history, &img, &img24) : history_redo(history, &img, &img24);
+                if (status != 0) {
+                    printf(choice == 6 ? "⚠️ Rien à annuler.\n\n" : "⚠️ Rien à rétablir.\n\n");
+                    break;
+                }
+                image_type = img24 != NULL ? BMP_24BIT : BMP_8BIT;
+                printf(choice == 6 ? "✨ Opération annulée !\n\n" : "✨ Opération rétablie !\n\n");
+                break;
+            }
+            case 8: {
                 printf("✨ Fermeture du programme...\n");
                 if (img != NULL) bmp8_free(img);
                 if (img24 != NULL) bmp24_free(img24);
+                history_destroy(history);
                 printf("✨ Merci d'avoir utilisé le programme de traitement d'images BMP !\n");
                 return 0;
             }
@@ -0,0 +1,165 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+#if defined(_MSC_VER)
+#define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ARENA_THREAD_LOCAL __thread
+#endif
+
+#define ARENA_ALIGN 16
+
+// En-tête placé devant chaque tampon de l'arène : les tampons forment une pile,
+// et la mémoire est rendue dès que tous les tampons au sommet sont libérés
+typedef struct {
+    size_t previous; // Position de l'en-tête du tampon précédent (ARENA_NONE pour le premier)
+    int freed; // 1 si le tampon a été libéré
+} t_arena_block;
+
+#define ARENA_NONE ((size_t) -1)
+
+#define ARENA_HEADER ((sizeof(t_arena_block) + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1))
+
+static ARENA_THREAD_LOCAL t_arena *currentArena = NULL;
+
+/**
+ * Crée une arène de mémoire temporaire
+ *
+ * @param capacity Taille du bloc en octets
+ * @return t_arena*: Pointeur vers l'arène créée ou NULL en cas d'erreur
+ */
+t_arena *arena_create(size_t capacity) {
+    t_arena *arena = (t_arena *) malloc(sizeof(t_arena));
+    if (arena == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'arène\n");
+        return NULL;
+    }
+
+    // Marge pour aligner le début du bloc
+    arena->base = (unsigned char *) malloc(capacity + ARENA_ALIGN);
+    if (arena->base == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'arène\n");
+        free(arena);
+        return NULL;
+    }
+
+    arena->capacity = capacity + ARENA_ALIGN;
+    arena->used = (ARENA_ALIGN - (uintptr_t) arena->base % ARENA_ALIGN) % ARENA_ALIGN;
+    arena->top = ARENA_NONE;
+    arena->peak = 0;
+    arena->fallbacks = 0;
+    return arena;
+}
+
+/**
+ * Libère une arène et son bloc de mémoire
+ *
+ * @param arena L'arène à libérer
+ */
+void arena_destroy(t_arena *arena) {
+    if (arena == NULL) return;
+
+    if (currentArena == arena) currentArena = NULL;
+    free(arena->base);
+    free(arena);
+}
+
+/**
+ * Rend disponible toute la mémoire de l'arène
+ *
+ * @param arena L'arène à réinitialiser
+ */
+void arena_reset(t_arena *arena) {
+    if (arena == NULL) return;
+
+    arena->used = (ARENA_ALIGN - (uintptr_t) arena->base % ARENA_ALIGN) % ARENA_ALIGN;
+    arena->top = ARENA_NONE;
+}
+
+/**
+ * Installe l'arène courante du thread appelant
+ *
+ * @param arena L'arène à utiliser, ou NULL pour revenir à malloc / free
+ * @return t_arena*: L'arène précédemment installée
+ */
+t_arena *arena_setCurrent(t_arena *arena) {
+    t_arena *previous = currentArena;
+    currentArena = arena;
+    return previous;
+}
+
+/**
+ * Renvoie l'arène courante du thread appelant
+ *
+ * @return t_arena*: L'arène courante ou NULL
+ */
+t_arena *arena_current(void) {
+    return currentArena;
+}
+
+/**
+ * Alloue un tampon temporaire dans l'arène courante du thread, ou avec malloc
+ *
+ * @param size Taille en octets
+ * @return void*: Le tampon ou NULL en cas d'erreur
+ */
+void *scratch_alloc(size_t size) {
+    t_arena *arena = currentArena;
+    if (arena != NULL) {
+        size_t rounded = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+        if (rounded >= size && ARENA_HEADER + rounded <= arena->capacity - arena->used) {
+            t_arena_block *block = (t_arena_block *) (arena->base + arena->used);
+            block->previous = arena->top;
+            block->freed = 0;
+            arena->top = arena->used;
+            arena->used += ARENA_HEADER + rounded;
+            if (arena->used > arena->peak) arena->peak = arena->used;
+            return (unsigned char *) block + ARENA_HEADER;
+        }
+        arena->fallbacks++;
+    }
+
+    return malloc(size);
+}
+
+/**
+ * Alloue un tampon temporaire initialisé à zéro
+ *
+ * @param size Taille en octets
+ * @return void*: Le tampon ou NULL en cas d'erreur
+ */
+void *scratch_calloc(size_t size) {
+    void *ptr = scratch_alloc(size);
+    if (ptr != NULL) memset(ptr, 0, size);
+    return ptr;
+}
+
+/**
+ * Libère un tampon obtenu par scratch_alloc
+ *
+ * @param ptr Le tampon (NULL accepté)
+ */
+void scratch_free(void *ptr) {
+    if (ptr == NULL) return;
+
+    t_arena *arena = currentArena;
+    unsigned char *p = (unsigned char *) ptr;
+    if (arena != NULL && p >= arena->base && p < arena->base + arena->capacity) {
+        ((t_arena_block *) (p - ARENA_HEADER))->freed = 1;
+
+        // Dépile tous les tampons libérés au sommet, quel que soit l'ordre des libérations
+        while (arena->top != ARENA_NONE) {
+            t_arena_block *top = (t_arena_block *) (arena->base + arena->top);
+            if (!top->freed) break;
+            arena->used = arena->top;
+            arena->top = top->previous;
+        }
+        return;
+    }
+
+    free(ptr);
+}
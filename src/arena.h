@@ -0,0 +1,84 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Arène de mémoire temporaire : un seul bloc alloué une fois, découpé par incrément de pointeur.
+// Chaque thread peut installer sa propre arène courante ; les fonctions de la bibliothèque y
+// prennent leurs tampons temporaires via scratch_alloc / scratch_free, et se rabattent sur
+// malloc / free si aucune arène n'est installée ou si elle est pleine.
+// Les threads de travail OpenMP n'ont pas d'arène courante : les régions parallèles prennent
+// un seul bloc avant la région, dans l'arène de l'appelant, et y découpent une tranche par thread.
+
+typedef struct {
+    unsigned char *base; // Début du bloc
+    size_t capacity; // Taille du bloc en octets
+    size_t used; // Octets actuellement utilisés
+    size_t top; // Position de l'en-tête du dernier tampon alloué
+    size_t peak; // Utilisation maximale depuis la création (pour dimensionner l'arène)
+    size_t fallbacks; // Nombre d'allocations servies par malloc faute de place
+} t_arena;
+
+/**
+ * Crée une arène de mémoire temporaire
+ *
+ * @param capacity Taille du bloc en octets
+ * @return t_arena*: Pointeur vers l'arène créée ou NULL en cas d'erreur
+ */
+t_arena *arena_create(size_t capacity);
+
+/**
+ * Libère une arène et son bloc de mémoire
+ *
+ * @param arena L'arène à libérer
+ */
+void arena_destroy(t_arena *arena);
+
+/**
+ * Rend disponible toute la mémoire de l'arène (à appeler entre deux images)
+ *
+ * @param arena L'arène à réinitialiser
+ */
+void arena_reset(t_arena *arena);
+
+/**
+ * Installe l'arène courante du thread appelant
+ *
+ * @param arena L'arène à utiliser, ou NULL pour revenir à malloc / free
+ * @return t_arena*: L'arène précédemment installée
+ */
+t_arena *arena_setCurrent(t_arena *arena);
+
+/**
+ * Renvoie l'arène courante du thread appelant
+ *
+ * @return t_arena*: L'arène courante ou NULL
+ */
+t_arena *arena_current(void);
+
+/**
+ * Alloue un tampon temporaire (aligné sur 16 octets) dans l'arène courante du thread,
+ * ou avec malloc si aucune arène n'est installée ou si elle est pleine
+ *
+ * @param size Taille en octets
+ * @return void*: Le tampon ou NULL en cas d'erreur
+ */
+void *scratch_alloc(size_t size);
+
+/**
+ * Alloue un tampon temporaire initialisé à zéro
+ *
+ * @param size Taille en octets
+ * @return void*: Le tampon ou NULL en cas d'erreur
+ */
+void *scratch_calloc(size_t size);
+
+/**
+ * Libère un tampon obtenu par scratch_alloc, avec la même arène courante qu'à l'allocation
+ * Dans l'arène, la mémoire est récupérée dès que tous les tampons alloués après lui sont libérés
+ *
+ * @param ptr Le tampon (NULL accepté)
+ */
+void scratch_free(void *ptr);
+
+#endif //ARENA_H
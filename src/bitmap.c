@@ -0,0 +1,365 @@
+#include "bitmap.h"
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define BITMAP_SIMD 1
+#endif
+
+/**
+ * Inverse l'ordre des bits d'un octet (premier pixel dans le bit de poids fort dans un BMP,
+ * dans le bit de poids faible dans un t_bitmap)
+ *
+ * @param value L'octet
+ * @return unsigned char: L'octet retourné
+ */
+static unsigned char bitmap_reverseByte(unsigned char value) {
+    value = (unsigned char) ((value & 0xF0) >> 4 | (value & 0x0F) << 4);
+    value = (unsigned char) ((value & 0xCC) >> 2 | (value & 0x33) << 2);
+    value = (unsigned char) ((value & 0xAA) >> 1 | (value & 0x55) << 1);
+    return value;
+}
+
+/**
+ * Masque des bits valides du dernier mot d'une rangée
+ *
+ * @param width Largeur en pixels
+ * @return uint64_t: Le masque
+ */
+static uint64_t bitmap_tailMask(int width) {
+    return width % 64 == 0 ? ~(uint64_t) 0 : ((uint64_t) 1 << (width % 64)) - 1;
+}
+
+/**
+ * Nombre de bits à 1 d'un mot
+ */
+static int bitmap_popcount(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int) ((value * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * Crée une image binaire compactée (pixels noirs)
+ *
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_bitmap*: L'image ou NULL en cas d'erreur
+ */
+t_bitmap *bitmap_allocate(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "Dimensions d'image binaire invalides (%d x %d)\n", width, height);
+        return NULL;
+    }
+
+    t_bitmap *bitmap = (t_bitmap *) malloc(sizeof(t_bitmap));
+    if (bitmap == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return NULL;
+    }
+
+    bitmap->width = width;
+    bitmap->height = height;
+    bitmap->words = (int) (((int64_t) width + 63) / 64);
+    bitmap->bits = (uint64_t *) calloc((size_t) bitmap->words * height, sizeof(uint64_t));
+    if (bitmap->bits == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les données de l'image\n");
+        free(bitmap);
+        return NULL;
+    }
+    return bitmap;
+}
+
+/**
+ * Libère une image binaire compactée
+ *
+ * @param bitmap L'image à libérer
+ */
+void bitmap_free(t_bitmap *bitmap) {
+    if (bitmap == NULL) return;
+    free(bitmap->bits);
+    free(bitmap);
+}
+
+/**
+ * Charge une image BMP 1 bit sans la décompacter
+ *
+ * @param filename Le chemin vers le fichier à charger
+ * @return t_bitmap*: L'image (bit à 1 pour la couleur la plus claire de la palette) ou NULL en cas d'erreur
+ */
+t_bitmap *bitmap_loadImage(const char *filename) {
+    TRACE_BEGIN("bitmap_loadImage");
+
+    char path[512];
+    strcpy(path, "../images/");
+    strcat(path, filename);
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Fichier non trouvé : %s\n", filename);
+        return NULL;
+    }
+
+    unsigned char header[54];
+    if (fread(header, 1, 54, file) != 54 || header[0] != 'B' || header[1] != 'M') {
+        fprintf(stderr, "Fichier BMP non valide\n");
+        fclose(file);
+        return NULL;
+    }
+
+    uint32_t offset = *(uint32_t *) &header[10];
+    uint32_t infoSize = *(uint32_t *) &header[14];
+    int width = *(int32_t *) &header[18];
+    int height = *(int32_t *) &header[22];
+    unsigned short colorDepth = *(unsigned short *) &header[28];
+    uint32_t compression = *(uint32_t *) &header[30];
+    if (colorDepth != 1 || compression != 0) {
+        fprintf(stderr, "Ce n'est pas une image BMP 1 bit non compressée (%d bits)\n", colorDepth);
+        fclose(file);
+        return NULL;
+    }
+
+    // Polarité : le bit à 1 désigne la plus claire des deux couleurs de la palette
+    unsigned char palette[8];
+    if (fseek(file, 14 + (long) infoSize, SEEK_SET) != 0 || fread(palette, 1, 8, file) != 8 ||
+        fseek(file, (long) offset, SEEK_SET) != 0) {
+        fprintf(stderr, "Erreur lors de la lecture de la palette\n");
+        fclose(file);
+        return NULL;
+    }
+    int invert = palette[0] + palette[1] + palette[2] > palette[4] + palette[5] + palette[6];
+
+    // INT32_MIN n'a pas d'opposé représentable : rejeté avant de changer le signe
+    if (width <= 0 || height == 0 || height == INT32_MIN) {
+        fprintf(stderr, "Dimensions d'image binaire invalides (%d x %d)\n", width, height);
+        fclose(file);
+        return NULL;
+    }
+
+    // Hauteur négative : rangées du fichier de haut en bas, rangées stockées de bas en haut
+    int topDown = height < 0;
+    if (topDown) height = -height;
+
+    t_bitmap *bitmap = bitmap_allocate(width, height);
+    if (bitmap == NULL) {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t rowBytes = ((size_t) width + 31) / 32 * 4;
+    unsigned char *row = (unsigned char *) malloc(rowBytes);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        bitmap_free(bitmap);
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char reverse[256];
+    for (int i = 0; i < 256; i++) reverse[i] = bitmap_reverseByte((unsigned char) i);
+
+    uint64_t tail = bitmap_tailMask(width);
+    for (int y = 0; y < height; y++) {
+        if (fread(row, 1, rowBytes, file) != rowBytes) {
+            fprintf(stderr, "Erreur lors de la lecture des données de l'image\n");
+            free(row);
+            bitmap_free(bitmap);
+            fclose(file);
+            return NULL;
+        }
+
+        // 8 octets du fichier par mot, chaque octet retourné (premier pixel au bit de poids faible)
+        uint64_t *words = bitmap->bits + (size_t) (topDown ? height - 1 - y : y) * bitmap->words;
+        for (int w = 0; w < bitmap->words; w++) {
+            uint64_t value = 0;
+            for (int b = 0; b < 8 && (size_t) (w * 8 + b) < rowBytes; b++) {
+                value |= (uint64_t) reverse[row[w * 8 + b]] << (8 * b);
+            }
+            words[w] = invert ? ~value : value;
+        }
+        words[bitmap->words - 1] &= tail;
+    }
+
+    free(row);
+    fclose(file);
+    TRACE_END(width, height, (size_t) bitmap->words * height * sizeof(uint64_t));
+    return bitmap;
+}
+
+/**
+ * Sauvegarde une image binaire compactée au format BMP 1 bit (palette noir et blanc)
+ *
+ * @param bitmap L'image à sauvegarder
+ * @param filename Le nom du fichier de destination
+ */
+void bitmap_saveImage(const t_bitmap *bitmap, const char *filename) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible de sauvegarder une image NULL\n");
+        return;
+    }
+    TRACE_BEGIN("bitmap_saveImage");
+
+    char path[512];
+    strcpy(path, "../images/");
+    strcat(path, filename);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Impossible de créer le fichier : %s\n", filename);
+        return;
+    }
+
+    uint32_t rowBytes = (uint32_t) (bitmap->width + 31) / 32 * 4;
+    uint32_t imageSize = rowBytes * (uint32_t) bitmap->height;
+    uint32_t offset = 54 + 2 * 4;
+
+    // En-tête de fichier, BITMAPINFOHEADER, puis palette noir et blanc
+    unsigned char header[54 + 8];
+    memset(header, 0, sizeof(header));
+    header[0] = 'B';
+    header[1] = 'M';
+    *(uint32_t *) &header[2] = offset + imageSize;
+    *(uint32_t *) &header[10] = offset;
+    *(uint32_t *) &header[14] = 40;
+    *(int32_t *) &header[18] = bitmap->width;
+    *(int32_t *) &header[22] = bitmap->height;
+    header[26] = 1; // Nombre de plans
+    header[28] = 1; // Bits par pixel
+    *(uint32_t *) &header[34] = imageSize;
+    *(uint32_t *) &header[38] = 2835; // 72 DPI
+    *(uint32_t *) &header[42] = 2835;
+    *(uint32_t *) &header[46] = 2; // Couleurs de la palette
+    memset(header + 58, 255, 3);
+    fwrite(header, 1, sizeof(header), file);
+
+    unsigned char *row = (unsigned char *) calloc(rowBytes, 1);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        fclose(file);
+        return;
+    }
+
+    unsigned char reverse[256];
+    for (int i = 0; i < 256; i++) reverse[i] = bitmap_reverseByte((unsigned char) i);
+
+    for (int y = 0; y < bitmap->height; y++) {
+        const uint64_t *words = bitmap->bits + (size_t) y * bitmap->words;
+        for (uint32_t b = 0; b < rowBytes; b++) {
+            int w = (int) (b / 8);
+            row[b] = w < bitmap->words ? reverse[(words[w] >> (8 * (b % 8))) & 0xFF] : 0;
+        }
+        fwrite(row, 1, rowBytes, file);
+    }
+
+    free(row);
+    fclose(file);
+    TRACE_END(bitmap->width, bitmap->height, (size_t) imageSize);
+}
+
+/**
+ * Seuille une image BMP 8 bits directement vers une image binaire compactée
+ * (même règle que bmp8_threshold : blanc si valeur >= seuil)
+ *
+ * @param img L'image source (non modifiée)
+ * @param threshold La valeur de seuil (0-255)
+ * @return t_bitmap*: L'image binaire ou NULL en cas d'erreur
+ */
+t_bitmap *bmp8_toBitmap(const t_bmp8 *img, int threshold) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Impossible de seuiller une image NULL\n");
+        return NULL;
+    }
+
+    t_bitmap *bitmap = bitmap_allocate((int) img->width, (int) img->height);
+    if (bitmap == NULL) return NULL;
+    TRACE_BEGIN("bmp8_toBitmap");
+
+    // Valeur réelle de chaque indice (table en attente du mode palette) comparée au seuil
+    unsigned char white[256];
+    for (int i = 0; i < 256; i++) {
+        white[i] = img->lut[i] >= threshold;
+    }
+
+    unsigned int stride = bmp8_rowSize(img);
+    int width = bitmap->width;
+    for (int y = 0; y < bitmap->height; y++) {
+        const unsigned char *row = img->data + (size_t) y * stride;
+        uint64_t *words = bitmap->bits + (size_t) y * bitmap->words;
+        int x = 0;
+
+#ifdef BITMAP_SIMD
+        if (!img->lutPending && threshold > 0 && threshold <= 255) {
+            // 16 comparaisons par instruction, le masque des signes donne directement les bits
+            __m128i limit = _mm_set1_epi8((char) (threshold - 1));
+            for (; x + 16 <= width; x += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *) (row + x));
+                __m128i below = _mm_cmpeq_epi8(_mm_max_epu8(v, limit), limit);
+                uint64_t mask = (uint64_t) (~_mm_movemask_epi8(below) & 0xFFFF);
+                words[x / 64] |= mask << (x % 64);
+            }
+        }
+#endif
+        for (; x < width; x++) {
+            words[x / 64] |= (uint64_t) white[row[x]] << (x % 64);
+        }
+    }
+
+    TRACE_END(bitmap->width, bitmap->height, (size_t) img->dataSize);
+    return bitmap;
+}
+
+/**
+ * Décompacte une image binaire en image BMP 8 bits (valeurs 0 et 255), sauvegardée en 1 bit par défaut
+ *
+ * @param bitmap L'image binaire
+ * @return t_bmp8*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp8 *bitmap_toBmp8(const t_bitmap *bitmap) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible de décompacter une image NULL\n");
+        return NULL;
+    }
+
+    t_bmp8 *img = bmp8_allocate((unsigned int) bitmap->width, (unsigned int) bitmap->height);
+    if (img == NULL) return NULL;
+    TRACE_BEGIN("bitmap_toBmp8");
+
+    unsigned int stride = bmp8_rowSize(img);
+    for (int y = 0; y < bitmap->height; y++) {
+        const uint64_t *words = bitmap->bits + (size_t) y * bitmap->words;
+        unsigned char *row = img->data + (size_t) y * stride;
+        for (int x = 0; x < bitmap->width; x++) {
+            row[x] = (words[x / 64] >> (x % 64)) & 1 ? 255 : 0;
+        }
+    }
+
+    img->colorDepth = 1;
+    TRACE_END(bitmap->width, bitmap->height, (size_t) img->dataSize);
+    return img;
+}
+
+/**
+ * Compte les pixels blancs d'une image binaire
+ *
+ * @param bitmap L'image binaire
+ * @return long: Le nombre de bits à 1
+ */
+long bitmap_count(const t_bitmap *bitmap) {
+    if (bitmap == NULL || bitmap->bits == NULL) return 0;
+
+    long count = 0;
+    size_t total = (size_t) bitmap->words * bitmap->height;
+    for (size_t i = 0; i < total; i++) {
+        count += bitmap_popcount(bitmap->bits[i]);
+    }
+    return count;
+}
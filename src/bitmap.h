@@ -0,0 +1,77 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <stdint.h>
+
+#include "bmp8.h"
+
+// Image binaire compactée à 1 bit par pixel (8 fois moins de mémoire qu'un t_bmp8).
+// Comme dans t_bmp8, les rangées sont dans l'ordre de stockage (de bas en haut).
+// Le pixel x d'une rangée est le bit x % 64 du mot x / 64 ; un bit à 1 est un pixel blanc (255).
+// Les bits au-delà de la largeur valent toujours 0.
+typedef struct {
+    uint64_t *bits; // Rangées de words mots consécutives
+    int width; // Largeur en pixels
+    int height; // Hauteur en pixels
+    int words; // Mots de 64 bits par rangée
+} t_bitmap;
+
+/**
+ * Crée une image binaire compactée (pixels noirs)
+ *
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_bitmap*: L'image ou NULL en cas d'erreur
+ */
+t_bitmap *bitmap_allocate(int width, int height);
+
+/**
+ * Libère une image binaire compactée
+ *
+ * @param bitmap L'image à libérer
+ */
+void bitmap_free(t_bitmap *bitmap);
+
+/**
+ * Charge une image BMP 1 bit sans la décompacter
+ *
+ * @param filename Le chemin vers le fichier à charger
+ * @return t_bitmap*: L'image (bit à 1 pour la couleur la plus claire de la palette) ou NULL en cas d'erreur
+ */
+t_bitmap *bitmap_loadImage(const char *filename);
+
+/**
+ * Sauvegarde une image binaire compactée au format BMP 1 bit (palette noir et blanc)
+ *
+ * @param bitmap L'image à sauvegarder
+ * @param filename Le nom du fichier de destination
+ */
+void bitmap_saveImage(const t_bitmap *bitmap, const char *filename);
+
+/**
+ * Seuille une image BMP 8 bits directement vers une image binaire compactée
+ * (même règle que bmp8_threshold : blanc si valeur >= seuil)
+ *
+ * @param img L'image source (non modifiée)
+ * @param threshold La valeur de seuil (0-255)
+ * @return t_bitmap*: L'image binaire ou NULL en cas d'erreur
+ */
+t_bitmap *bmp8_toBitmap(const t_bmp8 *img, int threshold);
+
+/**
+ * Décompacte une image binaire en image BMP 8 bits (valeurs 0 et 255), sauvegardée en 1 bit par défaut
+ *
+ * @param bitmap L'image binaire
+ * @return t_bmp8*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp8 *bitmap_toBmp8(const t_bitmap *bitmap);
+
+/**
+ * Compte les pixels blancs d'une image binaire
+ *
+ * @param bitmap L'image binaire
+ * @return long: Le nombre de bits à 1
+ */
+long bitmap_count(const t_bitmap *bitmap);
+
+#endif //BITMAP_H
@@ -1,17 +1,204 @@
 #include "bmp8.h"
+#include "arena.h"
+#include "colorspace.h"
+#include "trace.h"
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define BMP8_SIMD 1
+#endif
+
+/**
+ * Écrit un entier de 32 bits en petit-boutiste dans un en-tête
+ *
+ * @param header L'en-tête à modifier
+ * @param offset La position du champ
+ * @param value La valeur à écrire
+ */
+static void bmp8_writeU32(unsigned char *header, int offset, uint32_t value) {
+    header[offset] = (unsigned char) (value & 0xFF);
+    header[offset + 1] = (unsigned char) ((value >> 8) & 0xFF);
+    header[offset + 2] = (unsigned char) ((value >> 16) & 0xFF);
+    header[offset + 3] = (unsigned char) ((value >> 24) & 0xFF);
+}
+
+/**
+ * Initialise l'état interne d'une image (mode palette désactivé, table identité)
+ *
+ * @param img L'image à initialiser
+ */
+static void bmp8_initState(t_bmp8 *img) {
+    img->paletteMode = 0;
+    img->lutPending = 0;
+    for (int i = 0; i < 256; i++) {
+        img->lut[i] = (unsigned char) i;
+    }
+
+    img->histogramCache = 0;
+    img->histogramValid = 0;
+    img->cdfValid = 0;
+}
+
+/**
+ * Décompacte une rangée de pixels 1 bit (premier pixel dans le bit de poids fort)
+ *
+ * @param src La rangée compactée
+ * @param dst Reçoit un octet par pixel
+ * @param width Largeur en pixels
+ * @param table Les 8 pixels de chaque octet compacté
+ * @param gray Niveau de gris des deux indices de la palette
+ */
+static void bmp8_unpack1(const unsigned char *src, unsigned char *dst, int width,
+                         const unsigned char table[256][8], const unsigned char gray[16]) {
+    int x = 0;
+#ifdef BMP8_SIMD
+    // 2 octets -> 16 pixels : chaque octet est répété 8 fois puis chaque copie teste un bit
+    const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m128i bit = _mm_setr_epi8((char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                      (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i zero = _mm_set1_epi8((char) gray[0]);
+    const __m128i flip = _mm_set1_epi8((char) (gray[0] ^ gray[1]));
+    for (; x + 16 <= width; x += 16) {
+        __m128i bytes = _mm_cvtsi32_si128(src[x / 8] | src[x / 8 + 1] << 8);
+        __m128i set = _mm_cmpeq_epi8(_mm_and_si128(_mm_shuffle_epi8(bytes, spread), bit), bit);
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_xor_si128(zero, _mm_and_si128(set, flip)));
+    }
+#else
+    (void) gray;
+#endif
+    for (; x + 8 <= width; x += 8) {
+        memcpy(dst + x, table[src[x / 8]], 8);
+    }
+    if (x < width) memcpy(dst + x, table[src[x / 8]], (size_t) (width - x));
+}
+
+/**
+ * Décompacte une rangée de pixels 4 bits (premier pixel dans les bits de poids fort)
+ *
+ * @param src La rangée compactée
+ * @param dst Reçoit un octet par pixel
+ * @param width Largeur en pixels
+ * @param table Les 2 pixels de chaque octet compacté
+ * @param gray Niveau de gris des 16 indices de la palette
+ */
+static void bmp8_unpack4(const unsigned char *src, unsigned char *dst, int width,
+                         const unsigned char table[256][8], const unsigned char gray[16]) {
+    int x = 0;
+#ifdef BMP8_SIMD
+    // 8 octets -> 16 indices entrelacés (poids fort, poids faible), puis pshufb comme table à 16 entrées
+    const __m128i palette = _mm_loadu_si128((const __m128i *) gray);
+    const __m128i low = _mm_set1_epi8(0x0F);
+    for (; x + 16 <= width; x += 16) {
+        __m128i bytes = _mm_loadl_epi64((const __m128i *) (src + x / 2));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), low);
+        __m128i lo = _mm_and_si128(bytes, low);
+        __m128i indices = _mm_unpacklo_epi8(hi, lo);
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_shuffle_epi8(palette, indices));
+    }
+#else
+    (void) gray;
+#endif
+    for (; x + 2 <= width; x += 2) {
+        memcpy(dst + x, table[src[x / 2]], 2);
+    }
+    if (x < width) dst[x] = table[src[x / 2]][0];
+}
+
 /**
- * Charge une image BMP 8 bits à partir d'un fichier
+ * Lit la palette et les pixels d'une image 1 ou 4 bits, décompactés en niveaux de gris
+ * (luminance de chaque couleur de la palette)
+ *
+ * @param img L'image destination, allouée aux dimensions du fichier
+ * @param file Le fichier, positionné après les 54 premiers octets
+ * @param header Les 54 premiers octets du fichier
+ * @param colorDepth 1 ou 4
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int bmp8_readPacked(t_bmp8 *img, FILE *file, const unsigned char *header, int colorDepth) {
+    uint32_t offset = *(uint32_t *) &header[10];
+    uint32_t infoSize = *(uint32_t *) &header[14];
+    uint32_t colorsUsed = *(uint32_t *) &header[46];
+
+    // Palette : colorsUsed entrées (2^profondeur si 0), converties en niveaux de gris
+    uint32_t entries = 1u << colorDepth;
+    if (colorsUsed != 0 && colorsUsed < entries) entries = colorsUsed;
+    unsigned char palette[16 * 4];
+    if (fseek(file, 14 + (long) infoSize, SEEK_SET) != 0 || fread(palette, 4, entries, file) != entries) {
+        fprintf(stderr, "Erreur lors de la lecture de la table de couleurs\n");
+        return -1;
+    }
+    unsigned char gray[16] = {0};
+    for (uint32_t i = 0; i < entries; i++) {
+        t_pixel p = {palette[i * 4], palette[i * 4 + 1], palette[i * 4 + 2], 255};
+        gray[i] = color_pixelLuma(&p);
+    }
+
+    // Table de décompactage : les pixels de chacun des 256 octets possibles
+    unsigned char table[256][8];
+    int perByte = 8 / colorDepth;
+    for (int value = 0; value < 256; value++) {
+        for (int i = 0; i < perByte; i++) {
+            int shift = 8 - colorDepth * (i + 1);
+            table[value][i] = gray[(value >> shift) & ((1 << colorDepth) - 1)];
+        }
+    }
+
+    size_t rowBytes = ((size_t) img->width * colorDepth + 31) / 32 * 4;
+    unsigned char *row = scratch_alloc(rowBytes);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return -1;
+    }
+    if (fseek(file, (long) offset, SEEK_SET) != 0) {
+        fprintf(stderr, "Erreur lors de la lecture des données de l'image\n");
+        scratch_free(row);
+        return -1;
+    }
+
+    unsigned int stride = bmp8_rowSize(img);
+    for (unsigned int y = 0; y < img->height; y++) {
+        if (fread(row, 1, rowBytes, file) != rowBytes) {
+            fprintf(stderr, "Erreur lors de la lecture des données de l'image\n");
+            scratch_free(row);
+            return -1;
+        }
+        unsigned char *dst = img->data + (size_t) (img->topDown ? img->height - 1 - y : y) * stride;
+        if (colorDepth == 1) bmp8_unpack1(row, dst, (int) img->width, table, gray);
+        else bmp8_unpack4(row, dst, (int) img->width, table, gray);
+    }
+
+    scratch_free(row);
+    img->colorDepth = (unsigned int) colorDepth;
+    return 0;
+}
+
+/**
+ * Charge une image BMP 8 bits à partir d'un fichier (les images 1 et 4 bits sont décompactées)
  *
  * @param filename Le chemin vers le fichier à charger
  * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
  */
 t_bmp8 *bmp8_loadImage(const char *filename) {
+    return bmp8_loadImageWith(filename, NULL, NULL);
+}
+
+/**
+ * Charge une image BMP 8 bits en obtenant l'image destination auprès d'un allocateur
+ *
+ * @param filename Le chemin vers le fichier à charger
+ * @param allocate Fournit une image de la taille lue dans l'en-tête (NULL pour bmp8_allocate)
+ * @param context Paramètre transmis à l'allocateur
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_loadImageWith(const char *filename, t_bmp8_allocator allocate, void *context) {
+    TRACE_BEGIN("bmp8_loadImage");
+
     char path[512];
     strcpy(path, "../images/");
     strcat(path, filename);
@@ -22,85 +209,292 @@ t_bmp8 *bmp8_loadImage(const char *filename) {
         return NULL;
     }
 
-    // Allocation de mémoire pour l'image
-    t_bmp8 *img = (t_bmp8 *) malloc(sizeof(t_bmp8));
-    if (img == NULL) {
-        fprintf(stderr, "Erreur d'allocation mémoire\n");
-        fclose(file);
-        return NULL;
-    }
-
     // Lecture de l'en-tête (54 octets)
-    if (fread(img->header, 1, 54, file) != 54) {
+    unsigned char header[54];
+    if (fread(header, 1, 54, file) != 54) {
         fprintf(stderr, "Erreur lors de la lecture de l'en-tête\n");
-        free(img);
         fclose(file);
         return NULL;
     }
 
     // Vérification s'il s'agit d'un fichier BMP (l'en-tête doit commencer par 'BM')
-    if (img->header[0] != 'B' || img->header[1] != 'M') {
+    if (header[0] != 'B' || header[1] != 'M') {
         fprintf(stderr, "Fichier BMP non valide\n");
-        free(img);
         fclose(file);
         return NULL;
     }
 
     // Extraction des informations de l'image depuis l'en-tête
     // Source : TABLE 1 - Structure d'en-tête d'image BMP
-    img->width = *(unsigned int *) &img->header[18];
-    img->height = *(unsigned int *) &img->header[22];
-    img->colorDepth = *(unsigned short *) &img->header[28];
-    img->dataSize = *(unsigned int *) &img->header[34];
-
-    // Vérification s'il s'agit d'une image 8 bits
-    if (img->colorDepth != 8) {
-        fprintf(stderr, "Ce n'est pas une image BMP 8 bits (profondeur de couleur : %d bits)\n", img->colorDepth);
-        free(img);
+    unsigned int width = *(unsigned int *) &header[18];
+    int32_t fileHeight = *(int32_t *) &header[22];
+    unsigned short colorDepth = *(unsigned short *) &header[28];
+    uint32_t compression = *(uint32_t *) &header[30];
+
+    // Hauteur négative : rangées du fichier de haut en bas
+    int topDown = fileHeight < 0;
+    unsigned int height = topDown ? (unsigned int) -(int64_t) fileHeight : (unsigned int) fileHeight;
+
+    // Vérification s'il s'agit d'une image 8 bits, ou 1 et 4 bits décompactée à la lecture
+    if (colorDepth != 8 && colorDepth != 4 && colorDepth != 1) {
+        fprintf(stderr, "Ce n'est pas une image BMP 1, 4 ou 8 bits (profondeur de couleur : %d bits)\n", colorDepth);
         fclose(file);
         return NULL;
     }
 
-    if (fread(img->colorTable, sizeof(unsigned char), 1024, file) != 1024) {
-        fprintf(stderr, "Erreur lors de la lecture de la table de couleurs\n");
-        free(img->colorTable);
-        free(img->header);
-        free(img);
+    // Dimensions vérifiées avant toute allocation, pour les rangées 8 bits comme pour les images
+    // décompactées : largeur utilisable par les vues, taille des données représentable dans dataSize
+    uint64_t dataSize = (((uint64_t) width + 3) & ~(uint64_t) 3) * height;
+    if (width == 0 || height == 0 || width > INT32_MAX || dataSize > UINT32_MAX) {
+        fprintf(stderr, "Dimensions d'image invalides (%u x %d)\n", width, fileHeight);
         fclose(file);
         return NULL;
     }
 
-    // Lecture des données de l'image
-    img->data = (unsigned char *) malloc(img->dataSize * sizeof(unsigned char));
-    if (img->data == NULL) {
-        fprintf(stderr, "Erreur d'allocation mémoire pour les données de l'image\n");
-        free(img);
+    // Pixels non compressés seulement (BI_RLE8 / BI_RLE4 seraient lus comme des octets bruts)
+    if (compression != 0) {
+        fprintf(stderr, "Compression BMP non prise en charge (%u)\n", compression);
         fclose(file);
         return NULL;
     }
 
-    if (fread(img->data, sizeof(unsigned char), img->dataSize, file) != img->dataSize) {
-        fprintf(stderr, "Erreur lors de la lecture des données de l'image\n");
-        free(img->data);
-        free(img);
+    // Image destination : taille des données calculée (rangées complétées à 4 octets)
+    t_bmp8 *img = allocate != NULL ? allocate(context, width, height) : bmp8_allocate(width, height);
+    if (img == NULL) {
+        fclose(file);
+        return NULL;
+    }
+    img->topDown = topDown;
+    if (colorDepth != 8) {
+        int status = bmp8_readPacked(img, file, header, colorDepth);
+        fclose(file);
+        if (status != 0) {
+            bmp8_free(img);
+            return NULL;
+        }
+        TRACE_END(width, height, img->dataSize);
+        return img;
+    }
+    memcpy(img->header, header, 54);
+    bmp8_writeU32(img->header, 22, height); // Orientation gardée dans topDown
+
+    if (fread(img->colorTable, sizeof(unsigned char), 1024, file) != 1024) {
+        fprintf(stderr, "Erreur lors de la lecture de la table de couleurs\n");
+        bmp8_free(img);
         fclose(file);
         return NULL;
     }
 
+    // Lecture des données de l'image : d'un bloc si le fichier est de bas en haut comme t_bmp8,
+    // sinon chaque rangée est lue directement à sa place
+    unsigned int stride = bmp8_rowSize(img);
+    for (unsigned int i = 0; i < (topDown ? height : 1); i++) {
+        unsigned char *dst = topDown ? img->data + (size_t) (height - 1 - i) * stride : img->data;
+        size_t size = topDown ? stride : img->dataSize;
+        if (fread(dst, sizeof(unsigned char), size, file) != size) {
+            fprintf(stderr, "Erreur lors de la lecture des données de l'image\n");
+            bmp8_free(img);
+            fclose(file);
+            return NULL;
+        }
+    }
+
     // Fermeture du fichier
     if (fclose(file) == EOF) {
         // EOF est une macro qui représente la fin d'un fichier
         fprintf(stderr, "Impossible de fermer le fichier\n");
-        free(img->data);
+        bmp8_free(img);
+        return NULL;
+    }
+
+    TRACE_END(width, height, img->dataSize);
+    return img;
+}
+
+/**
+ * Crée une image BMP 8 bits vierge (pixels à 0) avec un en-tête complet
+ * et une palette de niveaux de gris
+ *
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp8*: Pointeur vers l'image créée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_allocate(unsigned int width, unsigned int height) {
+    t_bmp8 *img = (t_bmp8 *) malloc(sizeof(t_bmp8));
+    if (img == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return NULL;
+    }
+
+    img->width = width;
+    img->height = height;
+    img->dataSize = bmp8_rowSize(img) * height;
+
+    // Données des pixels, rangées complétées à 4 octets (octets de bourrage à 0)
+    img->data = (unsigned char *) calloc(img->dataSize, sizeof(unsigned char));
+    if (img->data == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les données de l'image\n");
         free(img);
         return NULL;
     }
 
+    bmp8_reset(img);
     return img;
 }
 
 /**
- * Sauvegarde une image BMP 8 bits dans un fichier
+ * Réécrit l'en-tête, la palette de niveaux de gris et l'état interne d'une image
+ * d'après sa largeur et sa hauteur, sans toucher aux pixels (image recyclée)
+ *
+ * @param img L'image à réinitialiser
+ */
+void bmp8_reset(t_bmp8 *img) {
+    if (img == NULL) return;
+
+    unsigned int width = img->width;
+    unsigned int height = img->height;
+    img->colorDepth = 8;
+    img->topDown = 0;
+    img->dataSize = bmp8_rowSize(img) * height;
+    bmp8_initState(img);
+
+    // En-tête de fichier (14 octets) et BITMAPINFOHEADER (40 octets)
+    memset(img->header, 0, sizeof(img->header));
+    img->header[0] = 'B';
+    img->header[1] = 'M';
+    bmp8_writeU32(img->header, 2, 54 + 1024 + img->dataSize); // Taille du fichier
+    bmp8_writeU32(img->header, 10, 54 + 1024); // Offset des pixels
+    bmp8_writeU32(img->header, 14, 40); // Taille de l'en-tête d'information
+    bmp8_writeU32(img->header, 18, width);
+    bmp8_writeU32(img->header, 22, height);
+    img->header[26] = 1; // Nombre de plans
+    img->header[28] = 8; // Bits par pixel
+    bmp8_writeU32(img->header, 34, img->dataSize);
+    bmp8_writeU32(img->header, 38, 2835); // 72 DPI
+    bmp8_writeU32(img->header, 42, 2835);
+    bmp8_writeU32(img->header, 46, 256); // Couleurs de la palette
+
+    // Palette de niveaux de gris (bleu, vert, rouge, réservé)
+    for (int i = 0; i < 256; i++) {
+        img->colorTable[i * 4] = (unsigned char) i;
+        img->colorTable[i * 4 + 1] = (unsigned char) i;
+        img->colorTable[i * 4 + 2] = (unsigned char) i;
+        img->colorTable[i * 4 + 3] = 0;
+    }
+}
+
+/**
+ * Compacte une rangée en 1 bit par pixel (blanc si l'intensité réelle est >= 128)
+ *
+ * @param src La rangée de pixels
+ * @param dst Reçoit la rangée compactée (premier pixel dans le bit de poids fort)
+ * @param width Largeur en pixels
+ * @param index Indice de palette (0 ou 1) de chaque valeur de pixel
+ * @param direct 1 si les valeurs sont les intensités réelles (table identité)
+ */
+static void bmp8_pack1(const unsigned char *src, unsigned char *dst, int width,
+                       const unsigned char index[256], int direct) {
+    int x = 0;
+#ifdef BMP8_SIMD
+    if (direct) {
+        // Le bit de signe de chaque octet vaut (valeur >= 128) : 16 pixels par masque,
+        // remis dans l'ordre BMP (premier pixel en poids fort) par une table d'inversion
+        unsigned char reverse[256];
+        for (int i = 0; i < 256; i++) {
+            unsigned char r = 0;
+            for (int b = 0; b < 8; b++) r |= (unsigned char) (((i >> b) & 1) << (7 - b));
+            reverse[i] = r;
+        }
+        for (; x + 16 <= width; x += 16) {
+            int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (src + x)));
+            dst[x / 8] = reverse[mask & 0xFF];
+            dst[x / 8 + 1] = reverse[(mask >> 8) & 0xFF];
+        }
+    }
+#else
+    (void) direct;
+#endif
+    for (; x < width; x += 8) {
+        unsigned char byte = 0;
+        for (int i = 0; i < 8 && x + i < width; i++) {
+            byte |= (unsigned char) (index[src[x + i]] << (7 - i));
+        }
+        dst[x / 8] = byte;
+    }
+}
+
+/**
+ * Écrit une image au format BMP 1 ou 4 bits (img->colorDepth) : palette de 2 ou 16 gris
+ * régulièrement espacés, chaque pixel prenant le gris le plus proche de son intensité réelle
+ *
+ * @param img L'image à écrire
+ * @param file Le fichier ouvert en écriture
+ */
+static void bmp8_writePacked(t_bmp8 *img, FILE *file) {
+    int colorDepth = (int) img->colorDepth;
+    int levels = 1 << colorDepth;
+    uint32_t rowBytes = (img->width * (uint32_t) colorDepth + 31) / 32 * 4;
+    uint32_t offset = 54 + (uint32_t) levels * 4;
+
+    unsigned char header[54];
+    memset(header, 0, sizeof(header));
+    header[0] = 'B';
+    header[1] = 'M';
+    bmp8_writeU32(header, 2, offset + rowBytes * img->height); // Taille du fichier
+    bmp8_writeU32(header, 10, offset); // Offset des pixels
+    bmp8_writeU32(header, 14, 40); // Taille de l'en-tête d'information
+    bmp8_writeU32(header, 18, img->width);
+    bmp8_writeU32(header, 22, img->topDown ? (uint32_t) -(int32_t) img->height : img->height);
+    header[26] = 1; // Nombre de plans
+    header[28] = (unsigned char) colorDepth; // Bits par pixel
+    bmp8_writeU32(header, 34, rowBytes * img->height);
+    bmp8_writeU32(header, 38, 2835); // 72 DPI
+    bmp8_writeU32(header, 42, 2835);
+    bmp8_writeU32(header, 46, (uint32_t) levels); // Couleurs de la palette
+    fwrite(header, 1, 54, file);
+
+    unsigned char palette[16 * 4];
+    for (int i = 0; i < levels; i++) {
+        unsigned char gray = (unsigned char) (i * 255 / (levels - 1));
+        palette[i * 4] = gray;
+        palette[i * 4 + 1] = gray;
+        palette[i * 4 + 2] = gray;
+        palette[i * 4 + 3] = 0;
+    }
+    fwrite(palette, 4, (size_t) levels, file);
+
+    // Indice de palette de chaque valeur stockée (table en attente du mode palette comprise)
+    unsigned char index[256];
+    for (int i = 0; i < 256; i++) {
+        index[i] = (unsigned char) ((img->lut[i] * (levels - 1) + 127) / 255);
+    }
+
+    unsigned char *row = scratch_calloc(rowBytes);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return;
+    }
+
+    unsigned int stride = bmp8_rowSize(img);
+    for (unsigned int i = 0; i < img->height; i++) {
+        unsigned int y = img->topDown ? img->height - 1 - i : i;
+        const unsigned char *src = img->data + (size_t) y * stride;
+        if (colorDepth == 1) {
+            bmp8_pack1(src, row, (int) img->width, index, !img->lutPending);
+        } else {
+            for (unsigned int x = 0; x < img->width; x += 2) {
+                unsigned char second = x + 1 < img->width ? index[src[x + 1]] : 0;
+                row[x / 2] = (unsigned char) (index[src[x]] << 4 | second);
+            }
+        }
+        fwrite(row, 1, rowBytes, file);
+    }
+
+    scratch_free(row);
+}
+
+/**
+ * Sauvegarde une image BMP 8 bits dans un fichier (1 ou 4 bits si colorDepth l'indique)
  *
  * @param img L'image à sauvegarder
  * @param filename Le nom du fichier de destination
@@ -110,6 +504,7 @@ void bmp8_saveImage(t_bmp8 *img, const char *filename) {
         fprintf(stderr, "Impossible de sauvegarder une image NULL\n");
         return;
     }
+    TRACE_BEGIN("bmp8_saveImage");
 
     char path[512];
     strcpy(path, "../images/");
@@ -124,10 +519,34 @@ void bmp8_saveImage(t_bmp8 *img, const char *filename) {
         return;
     }
 
-    fwrite(img->header, 1, 54, file);
+    if (img->colorDepth == 1 || img->colorDepth == 4) {
+        bmp8_writePacked(img, file);
+        fclose(file);
+        TRACE_END(img->width, img->height, img->dataSize);
+        return;
+    }
+
+    if (!img->topDown) {
+        fwrite(img->header, 1, 54, file);
+        fwrite(img->colorTable, 1, 1024, file);
+        fwrite(img->data, 1, img->dataSize, file);
+        fclose(file);
+        TRACE_END(img->width, img->height, img->dataSize);
+        return;
+    }
+
+    // Fichier de haut en bas : hauteur négative, rangées écrites de la dernière stockée à la première
+    unsigned char header[54];
+    memcpy(header, img->header, 54);
+    bmp8_writeU32(header, 22, (uint32_t) -(int32_t) img->height);
+    fwrite(header, 1, 54, file);
     fwrite(img->colorTable, 1, 1024, file);
-    fwrite(img->data, 1, img->dataSize, file);
+    unsigned int stride = bmp8_rowSize(img);
+    for (unsigned int y = img->height; y > 0; y--) {
+        fwrite(img->data + (size_t) (y - 1) * stride, 1, stride, file);
+    }
     fclose(file);
+    TRACE_END(img->width, img->height, img->dataSize);
 }
 
 /**
@@ -158,6 +577,281 @@ void bmp8_printInfo(t_bmp8 *img) {
     printf("Taille des données : %u\n", img->dataSize);
 }
 
+/**
+ * Calcule la taille d'une rangée de pixels en mémoire (largeur alignée sur 4 octets)
+ *
+ * @param img L'image concernée
+ * @return unsigned int: Le nombre d'octets entre deux rangées consécutives
+ */
+unsigned int bmp8_rowSize(const t_bmp8 *img) {
+    return (img->width + 3) & ~3u;
+}
+
+/**
+ * Vérifie que la palette d'une image est la rampe de gris (entrée i = (i, i, i))
+ *
+ * @param img L'image concernée
+ * @return int: 1 si la palette est une rampe de gris, 0 sinon
+ */
+static int bmp8_hasGrayPalette(const t_bmp8 *img) {
+    for (int i = 0; i < 256; i++) {
+        const unsigned char *entry = img->colorTable + i * 4;
+        if (entry[0] != i || entry[1] != i || entry[2] != i) return 0;
+    }
+    return 1;
+}
+
+/**
+ * Écrit la palette correspondant à la table en attente : l'indice i s'affiche avec le gris lut[i]
+ *
+ * @param img L'image concernée
+ */
+static void bmp8_writePalette(t_bmp8 *img) {
+    for (int i = 0; i < 256; i++) {
+        img->colorTable[i * 4] = img->lut[i];
+        img->colorTable[i * 4 + 1] = img->lut[i];
+        img->colorTable[i * 4 + 2] = img->lut[i];
+    }
+}
+
+/**
+ * Active ou désactive le mode palette
+ *
+ * @param img L'image concernée
+ * @param enable 1 pour activer, 0 pour désactiver (les pixels sont alors mis à jour)
+ * @return int: 1 si le mode demandé est actif, 0 sinon
+ */
+int bmp8_setPaletteMode(t_bmp8 *img, int enable) {
+    if (img == NULL) return 0;
+
+    if (!enable) {
+        bmp8_resolvePalette(img);
+        img->paletteMode = 0;
+        return 1;
+    }
+
+    if (!img->paletteMode && !bmp8_hasGrayPalette(img)) {
+        fprintf(stderr, "Le mode palette nécessite une palette de niveaux de gris\n");
+        return 0;
+    }
+    img->paletteMode = 1;
+    return 1;
+}
+
+/**
+ * Active ou désactive le cache d'histogramme de l'image
+ *
+ * @param img L'image concernée
+ * @param enable 1 pour activer, 0 pour désactiver
+ */
+void bmp8_enableHistogramCache(t_bmp8 *img, int enable) {
+    if (img == NULL) return;
+
+    img->histogramCache = enable ? 1 : 0;
+    img->histogramValid = 0;
+    img->cdfValid = 0;
+}
+
+/**
+ * Signale que les pixels ont été modifiés autrement que par une opération ponctuelle
+ *
+ * @param img L'image concernée
+ */
+void bmp8_invalidateCache(t_bmp8 *img) {
+    if (img == NULL) return;
+
+    img->histogramValid = 0;
+    img->cdfValid = 0;
+}
+
+/**
+ * Applique aux pixels la table de correspondance en attente du mode palette
+ *
+ * @param img L'image concernée
+ */
+void bmp8_resolvePalette(t_bmp8 *img) {
+    if (img == NULL || img->data == NULL || !img->lutPending) return;
+
+    unsigned int stride = bmp8_rowSize(img);
+    for (unsigned int y = 0; y < img->height; y++) {
+        unsigned char *row = img->data + (size_t) y * stride;
+        for (unsigned int x = 0; x < img->width; x++) {
+            row[x] = img->lut[row[x]];
+        }
+    }
+
+    // Les pixels contiennent désormais les intensités réelles : palette de gris standard
+    for (int i = 0; i < 256; i++) {
+        img->lut[i] = (unsigned char) i;
+    }
+    bmp8_writePalette(img);
+    img->lutPending = 0;
+}
+
+/**
+ * Applique une opération ponctuelle quelconque décrite par sa table de correspondance
+ *
+ * @param img L'image à modifier
+ * @param lut Nouvelle valeur pour chacun des 256 niveaux
+ */
+void bmp8_applyLut(t_bmp8 *img, const unsigned char lut[256]) {
+    if (img == NULL || img->data == NULL) return;
+    TRACE_BEGIN("bmp8_applyLut");
+
+    // Mise à jour analytique de l'histogramme en cache : chaque compartiment v rejoint lut[v]
+    if (img->histogramValid) {
+        unsigned int previous[256];
+        memcpy(previous, img->histogram, sizeof(previous));
+        memset(img->histogram, 0, sizeof(img->histogram));
+        for (int i = 0; i < 256; i++) {
+            img->histogram[lut[i]] += previous[i];
+        }
+        img->cdfValid = 0;
+    }
+
+    if (img->paletteMode) {
+        // Composition avec la table en attente, puis mise à jour de la palette : O(256)
+        for (int i = 0; i < 256; i++) {
+            img->lut[i] = lut[img->lut[i]];
+        }
+        img->lutPending = 1;
+        bmp8_writePalette(img);
+        TRACE_END(img->width, img->height, 0);
+        return;
+    }
+
+    // Sans image propriétaire : l'histogramme en cache vient d'être mis à jour ci-dessus
+    t_view8 whole = {img->data, (int) img->width, (int) img->height, (int) bmp8_rowSize(img), NULL};
+    view8_applyLut(whole, lut);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
+}
+
+/**
+ * Applique une opération ponctuelle aux pixels d'une vue
+ *
+ * @param view La vue à modifier
+ * @param lut Nouvelle valeur pour chacun des 256 niveaux
+ */
+void view8_applyLut(t_view8 view, const unsigned char lut[256]) {
+    if (view.data == NULL) return;
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+
+    for (int y = 0; y < view.height; y++) {
+        unsigned char *row = view.data + (ptrdiff_t) y * view.stride;
+        for (int x = 0; x < view.width; x++) {
+            row[x] = lut[row[x]];
+        }
+    }
+}
+
+/**
+ * Crée une vue sur un rectangle d'une image BMP 8 bits, sans copie des pixels
+ *
+ * @param img L'image
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view8: La vue, ou une vue vide (data NULL) si le rectangle sort de l'image
+ */
+t_view8 bmp8_view(t_bmp8 *img, int x, int y, int width, int height) {
+    t_view8 view = {NULL, 0, 0, 0, NULL};
+    if (img == NULL || img->data == NULL || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > (int) img->width || y + height > (int) img->height) {
+        fprintf(stderr, "Erreur: Rectangle hors de l'image\n");
+        return view;
+    }
+
+    // Les pixels de la vue seront lus et écrits directement : intensités réelles
+    bmp8_resolvePalette(img);
+
+    // Rangées stockées de bas en haut : la rangée du haut du rectangle est la dernière stockée,
+    // le pas négatif fait descendre la vue dans l'image
+    unsigned int rowSize = bmp8_rowSize(img);
+    view.data = img->data + (size_t) (img->height - 1 - y) * rowSize + x;
+    view.stride = -(int) rowSize;
+    view.width = width;
+    view.height = height;
+    view.image = img;
+    return view;
+}
+
+/**
+ * Crée une vue sur toute l'image dans l'ordre de stockage (rangée du bas en premier)
+ *
+ * @param img L'image (palette ramenée aux intensités réelles)
+ * @return t_view8: La vue, ou une vue vide (data NULL) si l'image est NULL
+ */
+t_view8 bmp8_storageView(t_bmp8 *img) {
+    t_view8 view = {NULL, 0, 0, 0, NULL};
+    if (img == NULL || img->data == NULL) return view;
+
+    bmp8_resolvePalette(img);
+    view.data = img->data;
+    view.width = (int) img->width;
+    view.height = (int) img->height;
+    view.stride = (int) bmp8_rowSize(img);
+    view.image = img;
+    return view;
+}
+
+/**
+ * Crée une vue sur un rectangle d'une autre vue
+ *
+ * @param view La vue parente
+ * @param x Colonne du coin supérieur gauche dans la vue parente
+ * @param y Rangée du coin supérieur gauche dans la vue parente (0 = haut)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view8: La vue, ou une vue vide (data NULL) si le rectangle sort de la vue parente
+ */
+t_view8 view8_sub(t_view8 view, int x, int y, int width, int height) {
+    t_view8 sub = {NULL, 0, 0, 0, NULL};
+    if (view.data == NULL || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > view.width || y + height > view.height) {
+        fprintf(stderr, "Erreur: Rectangle hors de la vue\n");
+        return sub;
+    }
+
+    sub.data = view.data + (ptrdiff_t) y * view.stride + x;
+    sub.width = width;
+    sub.height = height;
+    sub.stride = view.stride;
+    sub.image = view.image;
+    return sub;
+}
+
+/**
+ * Copie un rectangle d'une image BMP 8 bits dans une nouvelle image (même palette)
+ *
+ * @param img L'image source
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_bmp8*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_crop(t_bmp8 *img, int x, int y, int width, int height) {
+    t_view8 view = bmp8_view(img, x, y, width, height);
+    if (view.data == NULL) return NULL;
+    TRACE_BEGIN("bmp8_crop");
+
+    t_bmp8 *crop = bmp8_allocate((unsigned int) width, (unsigned int) height);
+    if (crop == NULL) return NULL;
+
+    memcpy(crop->colorTable, img->colorTable, sizeof(crop->colorTable));
+    crop->colorDepth = img->colorDepth;
+    crop->topDown = img->topDown;
+    // La vue descend de haut en bas, le recadrage est stocké de bas en haut
+    unsigned int stride = bmp8_rowSize(crop);
+    for (int row = 0; row < height; row++) {
+        memcpy(crop->data + (size_t) (height - 1 - row) * stride, view.data + (ptrdiff_t) row * view.stride, width);
+    }
+
+    TRACE_END(width, height, 2 * (size_t) width * height);
+    return crop;
+}
+
 /**
  * Applique un effet négatif à une image BMP 8 bits
  *
@@ -169,11 +863,15 @@ void bmp8_negative(t_bmp8 *img) {
         return;
     }
 
-    // Parcours de chaque pixel de l'image
-    for (unsigned int i = 0; i < img->dataSize; ++i) {
-        // Inversion de la valeur du pixel (255 - valeur)
-        img->data[i] = 255 - img->data[i];
+    // Inversion de chaque niveau (255 - valeur)
+    unsigned char lut[256];
+    for (int i = 0; i < 256; i++) {
+        lut[i] = (unsigned char) (255 - i);
     }
+
+    TRACE_BEGIN("bmp8_negative");
+    bmp8_applyLut(img, lut);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -182,16 +880,16 @@ void bmp8_negative(t_bmp8 *img) {
  * @param img L'image à modifier
  * @param value La valeur à ajouter à chaque pixel (-255 à 255)
  */
-void bmp8_brightness(const t_bmp8 *img, int value) {
+void bmp8_brightness(t_bmp8 *img, int value) {
     if (img == NULL || img->data == NULL) {
         fprintf(stderr, "Impossible d'ajuster la luminosité d'une image NULL\n");
         return;
     }
 
-    // Parcours de chaque pixel de l'image
-    for (unsigned int i = 0; i < img->dataSize; ++i) {
-        // Calcul de la nouvelle valeur du pixel
-        int newPixelValue = img->data[i] + value;
+    unsigned char lut[256];
+    for (int i = 0; i < 256; i++) {
+        // Calcul de la nouvelle valeur du niveau
+        int newPixelValue = i + value;
 
         // Vérification que la valeur reste dans l'intervalle valide [0, 255]
         if (newPixelValue > 255) {
@@ -200,9 +898,12 @@ void bmp8_brightness(const t_bmp8 *img, int value) {
             newPixelValue = 0;
         }
 
-        // Attribution de la nouvelle valeur au pixel
-        img->data[i] = (unsigned char) newPixelValue;
+        lut[i] = (unsigned char) newPixelValue;
     }
+
+    TRACE_BEGIN("bmp8_brightness");
+    bmp8_applyLut(img, lut);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -217,71 +918,191 @@ void bmp8_threshold(t_bmp8 *img, int threshold) {
         return;
     }
 
-    // Parcours de chaque pixel de l'image
-    for (unsigned int i = 0; i < img->dataSize; ++i) {
-        // Application du seuil
-        if (img->data[i] >= threshold) {
-            img->data[i] = 255; // Blanc si valeur >= seuil
-        } else {
-            img->data[i] = 0; // Noir si valeur < seuil
-        }
+    unsigned char lut[256];
+    for (int i = 0; i < 256; i++) {
+        // Blanc si valeur >= seuil, noir sinon
+        lut[i] = (i >= threshold) ? 255 : 0;
     }
+
+    TRACE_BEGIN("bmp8_threshold");
+    bmp8_applyLut(img, lut);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
  * Applique un filtre à une image BMP 8 bits en utilisant un noyau de convolution
+ * Les pixels du bord ne sont pas modifiés (BORDER_SKIP)
  *
  * @param img L'image à modifier
  * @param kernel Le noyau de convolution à appliquer
  * @param kernelSize La taille du noyau (doit être impair)
  */
 void bmp8_applyFilter(t_bmp8 *img, float **kernel, int kernelSize) {
+    bmp8_applyFilterBorder(img, kernel, kernelSize, BORDER_SKIP, 0);
+}
+
+/**
+ * Limite une somme de convolution à l'intervalle [0, 255]
+ *
+ * @param sum La somme pondérée calculée
+ * @return unsigned char: La valeur du pixel
+ */
+static unsigned char bmp8_clampSum(float sum) {
+    int newValue = (int) sum;
+    if (newValue > 255) newValue = 255;
+    if (newValue < 0) newValue = 0;
+    return (unsigned char) newValue;
+}
+
+/**
+ * Calcule la convolution d'un pixel du bord en passant par les tables d'indices
+ *
+ * @param src Les données source
+ * @param stride Le nombre d'octets entre deux rangées
+ * @param xMap Table des colonnes (indice x + j, décalé de n), -1 si hors image
+ * @param yMap Table des rangées (indice y + i, décalé de n), -1 si hors image
+ * @param x Colonne du pixel
+ * @param y Rangée du pixel
+ * @param k Le noyau aplati (kernelSize * kernelSize)
+ * @param kernelSize La taille du noyau
+ * @param constant La valeur utilisée pour les voisins hors de l'image
+ * @return unsigned char: La nouvelle valeur du pixel
+ */
+static unsigned char bmp8_convolveBorder(const unsigned char *src, unsigned int stride, const int *xMap,
+                                         const int *yMap, int x, int y, const float *k, int kernelSize,
+                                         unsigned char constant) {
+    float sum = 0.0f;
+
+    for (int i = 0; i < kernelSize; i++) {
+        int sy = yMap[y + i];
+        for (int j = 0; j < kernelSize; j++) {
+            int sx = xMap[x + j];
+            unsigned char value = (sy < 0 || sx < 0) ? constant : src[sy * stride + sx];
+            sum += value * k[i * kernelSize + j];
+        }
+    }
+
+    return bmp8_clampSum(sum);
+}
+
+/**
+ * Applique un filtre à une image BMP 8 bits avec une politique de bord explicite
+ *
+ * @param img L'image à modifier
+ * @param kernel Le noyau de convolution à appliquer
+ * @param kernelSize La taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La valeur utilisée hors de l'image avec BORDER_CONSTANT
+ */
+void bmp8_applyFilterBorder(t_bmp8 *img, float **kernel, int kernelSize, t_border_mode border, unsigned char constant) {
     if (img == NULL || img->data == NULL || kernel == NULL) {
         fprintf(stderr, "Impossible d'appliquer un filtre à une image NULL\n");
         return;
     }
 
+    // Vue dans l'ordre de stockage : un noyau non symétrique garde son orientation historique
+    view8_applyFilter(bmp8_storageView(img), kernel, kernelSize, border, constant);
+}
+
+/**
+ * Applique un filtre à une vue d'image 8 bits avec une politique de bord explicite
+ * (les bords de la vue sont traités comme les bords d'une image)
+ *
+ * La vue est découpée en une zone intérieure, où tout le voisinage est dans la vue
+ * et où la convolution se fait sans aucun test, et une bordure de kernelSize / 2 pixels
+ * traitée à part via des tables d'indices précalculées.
+ *
+ * @param view La vue à modifier
+ * @param kernel Le noyau de convolution à appliquer
+ * @param kernelSize La taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La valeur utilisée hors de la vue avec BORDER_CONSTANT
+ */
+void view8_applyFilter(t_view8 view, float **kernel, int kernelSize, t_border_mode border, unsigned char constant) {
+    if (view.data == NULL || kernel == NULL || view.width <= 0 || view.height <= 0) {
+        return;
+    }
+    TRACE_BEGIN("view8_applyFilter");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+
+    int width = view.width;
+    int height = view.height;
+    // La copie temporaire est compacte : une rangée de la vue après l'autre
+    unsigned int stride = (unsigned int) width;
+
     // Calculer la moitié de la taille du noyau
     int n = kernelSize / 2;
 
-    // Créer une copie des données de l'image pour éviter de modifier les valeurs pendant le calcul
-    unsigned char *tempData = (unsigned char *) malloc(img->dataSize * sizeof(unsigned char));
-    if (tempData == NULL) {
+    // Créer une copie des données de la vue pour éviter de modifier les valeurs pendant le calcul
+    unsigned char *tempData = (unsigned char *) scratch_alloc((size_t) stride * height * sizeof(unsigned char));
+    // Noyau aplati pour un accès contigu
+    float *k = (float *) scratch_alloc(kernelSize * kernelSize * sizeof(float));
+    // Tables d'indices des voisins pour la bordure
+    int *xMap = (int *) scratch_alloc((width + 2 * n) * sizeof(int));
+    int *yMap = (int *) scratch_alloc((height + 2 * n) * sizeof(int));
+    if (tempData == NULL || k == NULL || xMap == NULL || yMap == NULL) {
         fprintf(stderr, "Erreur d'allocation mémoire pour la copie temporaire\n");
+        scratch_free(yMap);
+        scratch_free(xMap);
+        scratch_free(k);
+        scratch_free(tempData);
         return;
     }
-    memcpy(tempData, img->data, img->dataSize);
+    for (int y = 0; y < height; y++) {
+        memcpy(tempData + (size_t) y * stride, view.data + (ptrdiff_t) y * view.stride, width);
+    }
 
-    // Appliquer le filtre seulement sur les pixels internes (éviter les bords)
-    for (unsigned int y = n; y < img->height - n; y++) {
-        for (unsigned int x = n; x < img->width - n; x++) {
-            float sum = 0.0f;
+    for (int i = 0; i < kernelSize; i++) {
+        for (int j = 0; j < kernelSize; j++) {
+            k[i * kernelSize + j] = kernel[i][j];
+        }
+    }
 
-            // Appliquer la convolution
-            for (int i = -n; i <= n; i++) {
-                for (int j = -n; j <= n; j++) {
-                    // Calculer l'index du pixel voisin
-                    unsigned int neighborIdx = (y + i) * img->width + (x + j);
-                    // Calculer l'index dans le noyau (i+n, j+n pour convertir de [-n,n] à [0,kernelSize-1])
-                    int kernelIdx_i = i + n;
-                    int kernelIdx_j = j + n;
+    // Zone intérieure : le voisinage complet est dans la vue, aucun test de bord
+    for (int y = n; y < height - n; y++) {
+        unsigned char *dst = view.data + (ptrdiff_t) y * view.stride;
+        for (int x = n; x < width - n; x++) {
+            const unsigned char *window = tempData + (y - n) * stride + (x - n);
+            float sum = 0.0f;
 
-                    sum += tempData[neighborIdx] * kernel[kernelIdx_i][kernelIdx_j];
+            for (int i = 0; i < kernelSize; i++) {
+                const unsigned char *row = window + i * stride;
+                const float *kRow = k + i * kernelSize;
+                for (int j = 0; j < kernelSize; j++) {
+                    sum += row[j] * kRow[j];
                 }
             }
 
-            // Limiter la valeur calculée à l'intervalle [0, 255]
-            int newValue = (int) sum;
-            if (newValue > 255) newValue = 255;
-            if (newValue < 0) newValue = 0;
+            dst[x] = bmp8_clampSum(sum);
+        }
+    }
+
+    // Bordure : seulement les n premières/dernières rangées et colonnes
+    if (border != BORDER_SKIP) {
+        for (int t = 0; t < width + 2 * n; t++) xMap[t] = bmp_borderIndex(t - n, width, border);
+        for (int t = 0; t < height + 2 * n; t++) yMap[t] = bmp_borderIndex(t - n, height, border);
 
-            // Mettre à jour le pixel dans l'image originale
-            img->data[y * img->width + x] = (unsigned char) newValue;
+        for (int y = 0; y < height; y++) {
+            unsigned char *dst = view.data + (ptrdiff_t) y * view.stride;
+            int fullRow = (y < n || y >= height - n);
+            int leftEnd = fullRow ? width : (n < width ? n : width);
+            int rightStart = fullRow ? width : (width - n > leftEnd ? width - n : leftEnd);
+
+            for (int x = 0; x < leftEnd; x++) {
+                dst[x] = bmp8_convolveBorder(tempData, stride, xMap, yMap, x, y, k, kernelSize, constant);
+            }
+            for (int x = rightStart; x < width; x++) {
+                dst[x] = bmp8_convolveBorder(tempData, stride, xMap, yMap, x, y, k, kernelSize, constant);
+            }
         }
     }
 
     // Libérer la mémoire de la copie temporaire
-    free(tempData);
+    scratch_free(yMap);
+    scratch_free(xMap);
+    scratch_free(k);
+    scratch_free(tempData);
+    TRACE_END(width, height, 2 * (size_t) width * height);
 }
 
 /**
@@ -292,35 +1113,21 @@ void bmp8_applyFilter(t_bmp8 *img, float **kernel, int kernelSize) {
 void bmp8_box_blur(t_bmp8 *img) {
     if (img == NULL) return;
 
-    // Créer le noyau de taille 3x3
-    float **kernel = (float **) malloc(3 * sizeof(float *));
-    if (kernel == NULL) return;
+    // Créer le noyau de taille 3x3 (sur la pile)
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
+    // Initialiser avec 1/9 pour chaque élément
     for (int i = 0; i < 3; i++) {
-        kernel[i] = (float *) malloc(3 * sizeof(float));
-        if (kernel[i] == NULL) {
-            // Libérer la mémoire déjà allouée en cas d'erreur
-            for (int j = 0; j < i; j++) {
-                free(kernel[j]);
-            }
-            free(kernel);
-            return;
-        }
-
-        // Initialiser avec 1/9 pour chaque élément
         for (int j = 0; j < 3; j++) {
             kernel[i][j] = 1.0f / 9.0f;
         }
     }
 
+    TRACE_BEGIN("bmp8_box_blur");
     // Appliquer le filtre à l'image
     bmp8_applyFilter(img, kernel, 3);
-
-    // Libérer la mémoire du noyau
-    for (int i = 0; i < 3; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -331,20 +1138,9 @@ void bmp8_box_blur(t_bmp8 *img) {
 void bmp8_gaussian_blur(t_bmp8 *img) {
     if (img == NULL) return;
 
-    // Créer le noyau de taille 3x3
-    float **kernel = (float **) malloc(3 * sizeof(float *));
-    if (kernel == NULL) return;
-
-    for (int i = 0; i < 3; i++) {
-        kernel[i] = (float *) malloc(3 * sizeof(float));
-        if (kernel[i] == NULL) {
-            for (int j = 0; j < i; j++) {
-                free(kernel[j]);
-            }
-            free(kernel);
-            return;
-        }
-    }
+    // Créer le noyau de taille 3x3 (sur la pile)
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Matrice de flou gaussien
     kernel[0][0] = 1.0f / 16.0f;
@@ -357,14 +1153,10 @@ void bmp8_gaussian_blur(t_bmp8 *img) {
     kernel[2][1] = 2.0f / 16.0f;
     kernel[2][2] = 1.0f / 16.0f;
 
+    TRACE_BEGIN("bmp8_gaussian_blur");
     // Appliquer le filtre à l'image
     bmp8_applyFilter(img, kernel, 3);
-
-    // Libérer la mémoire du noyau
-    for (int i = 0; i < 3; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -375,20 +1167,9 @@ void bmp8_gaussian_blur(t_bmp8 *img) {
 void bmp8_outline(t_bmp8 *img) {
     if (img == NULL) return;
 
-    // Créer le noyau de taille 3x3
-    float **kernel = (float **) malloc(3 * sizeof(float *));
-    if (kernel == NULL) return;
-
-    for (int i = 0; i < 3; i++) {
-        kernel[i] = (float *) malloc(3 * sizeof(float));
-        if (kernel[i] == NULL) {
-            for (int j = 0; j < i; j++) {
-                free(kernel[j]);
-            }
-            free(kernel);
-            return;
-        }
-    }
+    // Créer le noyau de taille 3x3 (sur la pile)
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Matrice de détection de contours
     kernel[0][0] = -1.0f;
@@ -401,14 +1182,10 @@ void bmp8_outline(t_bmp8 *img) {
     kernel[2][1] = -1.0f;
     kernel[2][2] = -1.0f;
 
+    TRACE_BEGIN("bmp8_outline");
     // Appliquer le filtre à l'image
     bmp8_applyFilter(img, kernel, 3);
-
-    // Libérer la mémoire du noyau
-    for (int i = 0; i < 3; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -419,20 +1196,9 @@ void bmp8_outline(t_bmp8 *img) {
 void bmp8_emboss(t_bmp8 *img) {
     if (img == NULL) return;
 
-    // Créer le noyau de taille 3x3
-    float **kernel = (float **) malloc(3 * sizeof(float *));
-    if (kernel == NULL) return;
-
-    for (int i = 0; i < 3; i++) {
-        kernel[i] = (float *) malloc(3 * sizeof(float));
-        if (kernel[i] == NULL) {
-            for (int j = 0; j < i; j++) {
-                free(kernel[j]);
-            }
-            free(kernel);
-            return;
-        }
-    }
+    // Créer le noyau de taille 3x3 (sur la pile)
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Matrice d'effet de relief
     kernel[0][0] = -2.0f;
@@ -445,14 +1211,10 @@ void bmp8_emboss(t_bmp8 *img) {
     kernel[2][1] = 1.0f;
     kernel[2][2] = 2.0f;
 
+    TRACE_BEGIN("bmp8_emboss");
     // Appliquer le filtre à l'image
     bmp8_applyFilter(img, kernel, 3);
-
-    // Libérer la mémoire du noyau
-    for (int i = 0; i < 3; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
 
 /**
@@ -463,20 +1225,9 @@ void bmp8_emboss(t_bmp8 *img) {
 void bmp8_sharpen(t_bmp8 *img) {
     if (img == NULL) return;
 
-    // Créer le noyau de taille 3x3
-    float **kernel = (float **) malloc(3 * sizeof(float *));
-    if (kernel == NULL) return;
-
-    for (int i = 0; i < 3; i++) {
-        kernel[i] = (float *) malloc(3 * sizeof(float));
-        if (kernel[i] == NULL) {
-            for (int j = 0; j < i; j++) {
-                free(kernel[j]);
-            }
-            free(kernel);
-            return;
-        }
-    }
+    // Créer le noyau de taille 3x3 (sur la pile)
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Matrice d'amélioration de la netteté
     kernel[0][0] = 0.0f;
@@ -489,12 +1240,8 @@ void bmp8_sharpen(t_bmp8 *img) {
     kernel[2][1] = -1.0f;
     kernel[2][2] = 0.0f;
 
+    TRACE_BEGIN("bmp8_sharpen");
     // Appliquer le filtre à l'image
     bmp8_applyFilter(img, kernel, 3);
-
-    // Libérer la mémoire du noyau
-    for (int i = 0; i < 3; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
 }
@@ -1,6 +1,8 @@
 #ifndef BMP8_H
 #define BMP8_H
 
+#include "utils/utils.h"
+
 // Type structuré t_bmp8 pour représenter une image en niveaux de gris
 typedef struct {
     unsigned char header[54]; // En-tête BMP
@@ -9,21 +11,85 @@ typedef struct {
 
     unsigned int width; // Largeur de l'image
     unsigned int height; // Hauteur de l'image
-    unsigned int colorDepth; // Profondeur de couleur (doit être 8 bits)
+    unsigned int colorDepth; // Profondeur du fichier (1, 4 ou 8 bits ; toujours 1 octet par pixel en mémoire)
     unsigned int dataSize; // Taille des données de pixels (tailleRangée * hauteur)
+    int topDown; // 1 si le fichier a ses rangées de haut en bas (hauteur négative) ; data reste de bas en haut
+
+    // Mode palette : les opérations ponctuelles ne modifient que la palette et la table lut,
+    // les pixels ne sont réécrits (lut[pixel]) que lorsqu'un filtre de voisinage en a besoin
+    int paletteMode; // 1 si le mode palette est actif
+    int lutPending; // 1 si lut n'a pas encore été appliquée aux pixels
+    unsigned char lut[256]; // Intensité réelle de chaque indice de pixel
+
+    // Histogramme en cache : mis à jour analytiquement par les opérations ponctuelles,
+    // invalidé par les filtres de voisinage
+    int histogramCache; // 1 si l'image conserve son histogramme
+    int histogramValid; // 1 si histogram correspond aux pixels actuels
+    int cdfValid; // 1 si cdf correspond à histogram
+    unsigned int histogram[256]; // Occurrences de chaque intensité réelle
+    unsigned int cdf[256]; // Occurrences cumulées
 } t_bmp8;
 
+// Vue sur un rectangle d'une image 8 bits, sans copie des pixels.
+// Comme t_view24, les rangées vont de haut en bas : la rangée y de la vue est à
+// data + y * stride, le pas étant négatif sur le stockage de bas en haut de t_bmp8.
+typedef struct {
+    unsigned char *data; // Pixel en haut à gauche du rectangle
+    int width; // Largeur du rectangle
+    int height; // Hauteur du rectangle
+    int stride; // Octets entre une rangée et la suivante (vers le bas), négatif si stockage de bas en haut
+    t_bmp8 *image; // Image dont le cache est invalidé par les view8_* qui modifient les pixels (ou NULL)
+} t_view8;
+
+// Fournit l'image destination d'un chargement (width x height), ou NULL en cas d'erreur
+typedef t_bmp8 *(*t_bmp8_allocator)(void *context, unsigned int width, unsigned int height);
+
 // Prototypes des fonctions pour le traitement d'images BMP8
 /**
  * Charge une image BMP 8 bits à partir d'un fichier
+ * Les images 1 et 4 bits sont décompactées en niveaux de gris (luminance de la palette)
+ * et gardent leur profondeur dans colorDepth ; une hauteur négative (rangées de haut en bas)
+ * est acceptée et mémorisée dans topDown
  *
  * @param filename Le chemin vers le fichier à charger
  * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
  */
 t_bmp8 *bmp8_loadImage(const char *filename);
 
+/**
+ * Charge une image BMP 8 bits en obtenant l'image destination auprès d'un allocateur
+ * (par exemple un pool d'images réutilisées)
+ *
+ * @param filename Le chemin vers le fichier à charger
+ * @param allocate Fournit une image de la taille lue dans l'en-tête (NULL pour bmp8_allocate)
+ * @param context Paramètre transmis à l'allocateur
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_loadImageWith(const char *filename, t_bmp8_allocator allocate, void *context);
+
+/**
+ * Crée une image BMP 8 bits vierge (pixels à 0) avec un en-tête complet
+ * et une palette de niveaux de gris
+ *
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp8*: Pointeur vers l'image créée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_allocate(unsigned int width, unsigned int height);
+
+/**
+ * Réécrit l'en-tête, la palette de niveaux de gris et l'état interne d'une image
+ * d'après sa largeur et sa hauteur, sans toucher aux pixels (image recyclée)
+ *
+ * @param img L'image à réinitialiser
+ */
+void bmp8_reset(t_bmp8 *img);
+
 /**
  * Sauvegarde une image BMP 8 bits dans un fichier
+ * Si colorDepth vaut 1 ou 4, les pixels sont compactés avec une palette de 2 ou 16 gris
+ * régulièrement espacés (gris le plus proche de chaque intensité)
+ * Si topDown vaut 1, le fichier est écrit de haut en bas (hauteur négative)
  *
  * @param img L'image à sauvegarder
  * @param filename Le nom du fichier de destination
@@ -45,6 +111,117 @@ void bmp8_free(t_bmp8 *img);
 void bmp8_printInfo(t_bmp8 *img);
 
 // Modifications simples
+/**
+ * Calcule la taille d'une rangée de pixels en mémoire (largeur alignée sur 4 octets)
+ *
+ * @param img L'image concernée
+ * @return unsigned int: Le nombre d'octets entre deux rangées consécutives
+ */
+unsigned int bmp8_rowSize(const t_bmp8 *img);
+
+/**
+ * Active ou désactive le mode palette : négatif, luminosité, seuillage et égalisation
+ * ne transforment alors que la palette de 256 couleurs (O(256)) au lieu de chaque pixel.
+ * Seules les images dont la palette est une rampe de gris peuvent passer en mode palette.
+ *
+ * @param img L'image concernée
+ * @param enable 1 pour activer, 0 pour désactiver (les pixels sont alors mis à jour)
+ * @return int: 1 si le mode demandé est actif, 0 sinon
+ */
+int bmp8_setPaletteMode(t_bmp8 *img, int enable);
+
+/**
+ * Active ou désactive le cache d'histogramme de l'image : histogramme, CDF, égalisation,
+ * seuil automatique et percentiles coûtent alors O(256) tant que le cache est valide
+ *
+ * @param img L'image concernée
+ * @param enable 1 pour activer, 0 pour désactiver
+ */
+void bmp8_enableHistogramCache(t_bmp8 *img, int enable);
+
+/**
+ * Signale que les pixels ont été modifiés autrement que par une opération ponctuelle
+ * (le cache d'histogramme devra être recalculé)
+ *
+ * @param img L'image concernée
+ */
+void bmp8_invalidateCache(t_bmp8 *img);
+
+/**
+ * Applique aux pixels la table de correspondance en attente du mode palette
+ * et rétablit la palette de gris. Sans effet s'il n'y a rien en attente.
+ *
+ * @param img L'image concernée
+ */
+void bmp8_resolvePalette(t_bmp8 *img);
+
+/**
+ * Applique une opération ponctuelle quelconque décrite par sa table de correspondance
+ * (en mode palette, seules la palette et la table en attente sont modifiées)
+ *
+ * @param img L'image à modifier
+ * @param lut Nouvelle valeur pour chacun des 256 niveaux
+ */
+void bmp8_applyLut(t_bmp8 *img, const unsigned char lut[256]);
+
+// Vues (régions d'intérêt) et recadrage
+/**
+ * Crée une vue sur un rectangle d'une image BMP 8 bits, sans copie des pixels
+ * (ramène la palette aux intensités réelles ; les view8_* qui modifient les pixels
+ * invalident le cache d'histogramme de l'image)
+ *
+ * @param img L'image
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view8: La vue, ou une vue vide (data NULL) si le rectangle sort de l'image
+ */
+t_view8 bmp8_view(t_bmp8 *img, int x, int y, int width, int height);
+
+/**
+ * Crée une vue sur toute l'image dans l'ordre de stockage (rangée du bas en premier)
+ * Les traitements bmp8_* de l'image entière l'utilisent pour garder leur orientation
+ * historique : un noyau ou un élément structurant non symétrique s'applique tel quel
+ * aux rangées stockées, comme avant l'introduction des vues
+ *
+ * @param img L'image (palette ramenée aux intensités réelles)
+ * @return t_view8: La vue, ou une vue vide (data NULL) si l'image est NULL
+ */
+t_view8 bmp8_storageView(t_bmp8 *img);
+
+/**
+ * Crée une vue sur un rectangle d'une autre vue
+ *
+ * @param view La vue parente
+ * @param x Colonne du coin supérieur gauche dans la vue parente
+ * @param y Rangée du coin supérieur gauche dans la vue parente (0 = haut)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view8: La vue, ou une vue vide (data NULL) si le rectangle sort de la vue parente
+ */
+t_view8 view8_sub(t_view8 view, int x, int y, int width, int height);
+
+/**
+ * Copie un rectangle d'une image BMP 8 bits dans une nouvelle image (même palette)
+ *
+ * @param img L'image source
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_bmp8*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_crop(t_bmp8 *img, int x, int y, int width, int height);
+
+/**
+ * Applique une opération ponctuelle aux pixels d'une vue
+ *
+ * @param view La vue à modifier
+ * @param lut Nouvelle valeur pour chacun des 256 niveaux
+ */
+void view8_applyLut(t_view8 view, const unsigned char lut[256]);
+
 /**
  * Applique un effet négatif à une image BMP 8 bits
  *
@@ -58,7 +235,7 @@ void bmp8_negative(t_bmp8 *img);
  * @param img L'image à modifier
  * @param value La valeur à ajouter à chaque pixel (-255 à 255)
  */
-void bmp8_brightness(const t_bmp8 *img, int value);
+void bmp8_brightness(t_bmp8 *img, int value);
 
 /**
  * Applique un seuillage à une image BMP 8 bits
@@ -77,6 +254,29 @@ void bmp8_threshold(t_bmp8 *img, int threshold);
  */
 void bmp8_applyFilter(t_bmp8 * img, float ** kernel, int kernelSize);
 
+/**
+ * Applique un filtre à une image BMP 8 bits avec une politique de bord explicite
+ *
+ * @param img L'image à modifier
+ * @param kernel Le noyau de convolution à appliquer
+ * @param kernelSize La taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La valeur utilisée hors de l'image avec BORDER_CONSTANT
+ */
+void bmp8_applyFilterBorder(t_bmp8 *img, float **kernel, int kernelSize, t_border_mode border, unsigned char constant);
+
+/**
+ * Applique un filtre à une vue d'image 8 bits avec une politique de bord explicite
+ * (les bords de la vue sont traités comme les bords d'une image)
+ *
+ * @param view La vue à modifier
+ * @param kernel Le noyau de convolution à appliquer
+ * @param kernelSize La taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La valeur utilisée hors de la vue avec BORDER_CONSTANT
+ */
+void view8_applyFilter(t_view8 view, float **kernel, int kernelSize, t_border_mode border, unsigned char constant);
+
 // Filtres avec convolution
 /**
  * Applique un flou rectangulaire à une image BMP 8 bits
@@ -0,0 +1,651 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // flock
+#endif
+
+#include "cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CACHE_DISK 1
+#endif
+
+// Constantes de XXH64
+#define CACHE_PRIME1 0x9E3779B185EBCA87ull
+#define CACHE_PRIME2 0xC2B2AE3D27D4EB4Full
+#define CACHE_PRIME3 0x165667B19E3779F9ull
+#define CACHE_PRIME4 0x85EBCA77C2B2AE63ull
+#define CACHE_PRIME5 0x27D4EB2F165667C5ull
+
+/**
+ * Rotation à gauche d'un mot de 64 bits
+ */
+static uint64_t cache_rotate(uint64_t value, int bits) {
+    return value << bits | value >> (64 - bits);
+}
+
+/**
+ * Lecture non alignée de 8 octets
+ */
+static uint64_t cache_read64(const unsigned char *p) {
+    uint64_t value;
+    memcpy(&value, p, 8); // Petit-boutiste sur les cibles du projet
+    return value;
+}
+
+/**
+ * Lecture non alignée de 4 octets
+ */
+static uint32_t cache_read32(const unsigned char *p) {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+/**
+ * Intègre 8 octets dans un accumulateur
+ */
+static uint64_t cache_round(uint64_t acc, uint64_t input) {
+    acc += input * CACHE_PRIME2;
+    acc = cache_rotate(acc, 31);
+    return acc * CACHE_PRIME1;
+}
+
+/**
+ * Fusionne un accumulateur dans l'empreinte
+ */
+static uint64_t cache_mergeRound(uint64_t acc, uint64_t value) {
+    acc ^= cache_round(0, value);
+    return acc * CACHE_PRIME1 + CACHE_PRIME4;
+}
+
+/**
+ * Empreinte 64 bits rapide d'un bloc d'octets (algorithme XXH64)
+ * Quatre accumulateurs indépendants traitent 32 octets par tour (environ un cycle par 8 octets)
+ *
+ * @param data Les octets
+ * @param size Nombre d'octets
+ * @param seed Graine (0 pour l'empreinte XXH64 standard)
+ * @return uint64_t: L'empreinte
+ */
+uint64_t cache_hash(const void *data, size_t size, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *) data;
+    const unsigned char *end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + CACHE_PRIME1 + CACHE_PRIME2;
+        uint64_t v2 = seed + CACHE_PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - CACHE_PRIME1;
+        do {
+            v1 = cache_round(v1, cache_read64(p));
+            v2 = cache_round(v2, cache_read64(p + 8));
+            v3 = cache_round(v3, cache_read64(p + 16));
+            v4 = cache_round(v4, cache_read64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+
+        hash = cache_rotate(v1, 1) + cache_rotate(v2, 7) + cache_rotate(v3, 12) + cache_rotate(v4, 18);
+        hash = cache_mergeRound(hash, v1);
+        hash = cache_mergeRound(hash, v2);
+        hash = cache_mergeRound(hash, v3);
+        hash = cache_mergeRound(hash, v4);
+    } else {
+        hash = seed + CACHE_PRIME5;
+    }
+    hash += (uint64_t) size;
+
+    while (end - p >= 8) {
+        hash ^= cache_round(0, cache_read64(p));
+        hash = cache_rotate(hash, 27) * CACHE_PRIME1 + CACHE_PRIME4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        hash ^= (uint64_t) cache_read32(p) * CACHE_PRIME1;
+        hash = cache_rotate(hash, 23) * CACHE_PRIME2 + CACHE_PRIME3;
+        p += 4;
+    }
+    while (p < end) {
+        hash ^= *p * CACHE_PRIME5;
+        hash = cache_rotate(hash, 11) * CACHE_PRIME1;
+        p++;
+    }
+
+    // Mélange final
+    hash ^= hash >> 33;
+    hash *= CACHE_PRIME2;
+    hash ^= hash >> 29;
+    hash *= CACHE_PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * Empreinte canonique d'une chaîne d'opérations
+ *
+ * @param operations Les opérations dans l'ordre d'application
+ * @param count Nombre d'opérations
+ * @return uint64_t: L'empreinte
+ */
+uint64_t cache_chainHash(char **operations, int count) {
+    // Chaque opération enchaîne l'empreinte de la précédente : (longueur, octets) sous la graine courante
+    uint64_t hash = cache_hash("chaine", 6, CACHE_VERSION);
+    for (int i = 0; i < count; i++) {
+        size_t length = strlen(operations[i]);
+        hash = cache_hash(&length, sizeof(length), hash);
+        hash = cache_hash(operations[i], length, hash);
+    }
+    return hash;
+}
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur une image 8 bits qui vient d'être chargée
+ *
+ * @param img L'image d'entrée
+ * @param chain Empreinte de la chaîne d'opérations
+ * @return t_cache_key: La clé
+ */
+t_cache_key cache_keyBmp8(const t_bmp8 *img, uint64_t chain) {
+    // Les paramètres qui changent le fichier écrit servent de graine à l'empreinte des pixels
+    uint32_t params[5] = {8, img->width, img->height, img->colorDepth, (uint32_t) img->topDown};
+    uint64_t seed = cache_hash(params, sizeof(params), CACHE_VERSION);
+    // L'en-tête est réécrit tel quel à la sauvegarde (résolution, champs réservés, ...)
+    seed = cache_hash(img->header, sizeof(img->header), seed);
+    seed = cache_hash(img->colorTable, sizeof(img->colorTable), seed);
+    seed = cache_hash(img->lut, sizeof(img->lut), seed);
+
+    t_cache_key key = {cache_hash(img->data, img->dataSize, seed), chain};
+    return key;
+}
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur une image 24 ou 32 bits qui vient d'être chargée
+ *
+ * @param img L'image d'entrée
+ * @param chain Empreinte de la chaîne d'opérations
+ * @return t_cache_key: La clé
+ */
+t_cache_key cache_keyBmp24(const t_bmp24 *img, uint64_t chain) {
+    uint32_t params[9] = {24, (uint32_t) img->width, (uint32_t) img->height, (uint32_t) img->colorDepth,
+                          (uint32_t) img->topDown, img->masks[0], img->masks[1], img->masks[2], img->masks[3]};
+    uint64_t seed = cache_hash(params, sizeof(params), CACHE_VERSION);
+
+    // Rangées contiguës : une seule passe sur tous les pixels
+    t_cache_key key = {cache_hash(img->data[0], (size_t) img->width * img->height * sizeof(t_pixel), seed), chain};
+    return key;
+}
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur un fichier BMP, sans décoder l'image :
+ * empreinte de tous les octets du fichier (en-têtes, palette ou masques, pixels)
+ *
+ * @param path Chemin complet du fichier
+ * @param chain Empreinte de la chaîne d'opérations
+ * @param key Reçoit la clé
+ * @return int: 0 en cas de succès, -1 si le fichier ne peut pas être lu
+ */
+int cache_keyFile(const char *path, uint64_t chain, t_cache_key *key) {
+#ifdef CACHE_DISK
+    // Fichier projeté en mémoire : l'empreinte lit les octets sans copie ni décodage
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t) info.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+    key->input = cache_hash(data, size, CACHE_VERSION);
+    munmap(data, size);
+#else
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return -1;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = length > 0 ? (unsigned char *) malloc((size_t) length) : NULL;
+    if (data == NULL || fread(data, 1, (size_t) length, file) != (size_t) length) {
+        free(data);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    key->input = cache_hash(data, (size_t) length, CACHE_VERSION);
+    free(data);
+#endif
+    key->chain = chain;
+    return 0;
+}
+
+/**
+ * Compare deux clés
+ */
+static int cache_sameKey(t_cache_key a, t_cache_key b) {
+    return a.input == b.input && a.chain == b.chain;
+}
+
+/**
+ * Retire les résultats les moins récents jusqu'à ce que size octets supplémentaires tiennent en mémoire
+ *
+ * @param cache Le cache
+ * @param size Taille du résultat à ajouter
+ */
+static void cache_evictMemory(t_result_cache *cache, size_t size) {
+    int evicted = 0;
+    while (cache->memoryBytes + size > cache->maxMemoryBytes && evicted < cache->count) {
+        free(cache->entries[evicted].data);
+        cache->memoryBytes -= cache->entries[evicted].size;
+        cache->evictions++;
+        evicted++;
+    }
+    if (evicted > 0) {
+        memmove(cache->entries, cache->entries + evicted, (size_t) (cache->count - evicted) * sizeof(t_cache_entry));
+        cache->count -= evicted;
+    }
+}
+
+/**
+ * Conserve une copie d'un résultat en mémoire (en plus récent)
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param data Le fichier BMP
+ * @param size Taille du fichier
+ */
+static void cache_putMemory(t_result_cache *cache, t_cache_key key, const unsigned char *data, size_t size) {
+    if (size > cache->maxMemoryBytes) return;
+
+    // Un résultat déjà présent (calculé en parallèle par exemple) est remplacé
+    for (int i = 0; i < cache->count; i++) {
+        if (!cache_sameKey(cache->entries[i].key, key)) continue;
+        free(cache->entries[i].data);
+        cache->memoryBytes -= cache->entries[i].size;
+        memmove(&cache->entries[i], &cache->entries[i + 1], (size_t) (cache->count - 1 - i) * sizeof(t_cache_entry));
+        cache->count--;
+        break;
+    }
+
+    cache_evictMemory(cache, size);
+
+    if (cache->count == cache->capacity) {
+        int capacity = cache->capacity * 2;
+        t_cache_entry *entries = (t_cache_entry *) realloc(cache->entries, (size_t) capacity * sizeof(t_cache_entry));
+        if (entries == NULL) return;
+        cache->entries = entries;
+        cache->capacity = capacity;
+    }
+
+    unsigned char *copy = (unsigned char *) malloc(size);
+    if (copy == NULL) return;
+    memcpy(copy, data, size);
+
+    t_cache_entry entry = {key, copy, size};
+    cache->entries[cache->count++] = entry;
+    cache->memoryBytes += size;
+}
+
+/**
+ * Cherche un résultat en mémoire et le marque comme le plus récent
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @return t_cache_entry*: Le résultat ou NULL s'il est absent
+ */
+static t_cache_entry *cache_findMemory(t_result_cache *cache, t_cache_key key) {
+    for (int i = cache->count - 1; i >= 0; i--) {
+        if (!cache_sameKey(cache->entries[i].key, key)) continue;
+
+        t_cache_entry entry = cache->entries[i];
+        memmove(&cache->entries[i], &cache->entries[i + 1], (size_t) (cache->count - 1 - i) * sizeof(t_cache_entry));
+        cache->entries[cache->count - 1] = entry;
+        return &cache->entries[cache->count - 1];
+    }
+    return NULL;
+}
+
+#ifdef CACHE_DISK
+
+/**
+ * Chemin du fichier d'un résultat dans le dossier du cache
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param path Reçoit le chemin
+ * @param size Taille de path
+ */
+static void cache_path(const t_result_cache *cache, t_cache_key key, char *path, size_t size) {
+    snprintf(path, size, "%s/%016llx%016llx.bmp", cache->directory, (unsigned long long) key.input,
+             (unsigned long long) key.chain);
+}
+
+/**
+ * Lit un fichier en entier
+ *
+ * @param path Le chemin du fichier
+ * @param size Reçoit la taille du fichier
+ * @return unsigned char*: Le contenu (à libérer avec free) ou NULL si le fichier est absent ou illisible
+ */
+static unsigned char *cache_readFile(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    struct stat info;
+    if (fstat(fileno(file), &info) != 0 || info.st_size <= 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char *data = (unsigned char *) malloc((size_t) info.st_size);
+    if (data == NULL || fread(data, 1, (size_t) info.st_size, file) != (size_t) info.st_size) {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *size = (size_t) info.st_size;
+    return data;
+}
+
+// Fichier de résultat du dossier, pour l'éviction
+typedef struct {
+    char name[64];
+    size_t size;
+    time_t used;
+} t_cache_file;
+
+/**
+ * Ordre des fichiers du moins au plus récemment utilisé (pour qsort)
+ */
+static int cache_compareFiles(const void *a, const void *b) {
+    time_t ua = ((const t_cache_file *) a)->used;
+    time_t ub = ((const t_cache_file *) b)->used;
+    return (ua > ub) - (ua < ub);
+}
+
+/**
+ * Supprime les fichiers les moins récemment utilisés jusqu'à respecter maxDiskBytes.
+ * Le verrou exclusif empêche deux processus d'évincer en même temps ; un fichier supprimé
+ * pendant qu'un autre processus le lit reste lisible jusqu'à sa fermeture.
+ *
+ * @param cache Le cache
+ */
+static void cache_evictDisk(t_result_cache *cache) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/.verrou", cache->directory);
+    int lock = open(path, O_RDWR | O_CREAT, 0644);
+    if (lock < 0) return;
+    if (flock(lock, LOCK_EX) != 0) {
+        close(lock);
+        return;
+    }
+
+    DIR *dir = opendir(cache->directory);
+    t_cache_file *files = NULL;
+    int count = 0, capacity = 0;
+    size_t total = 0;
+    struct dirent *item;
+    while (dir != NULL && (item = readdir(dir)) != NULL) {
+        size_t length = strlen(item->d_name);
+        if (length != 36 || strcmp(item->d_name + 32, ".bmp") != 0) continue;
+
+        struct stat info;
+        snprintf(path, sizeof(path), "%s/%s", cache->directory, item->d_name);
+        if (stat(path, &info) != 0) continue;
+
+        if (count == capacity) {
+            capacity = capacity == 0 ? 64 : capacity * 2;
+            t_cache_file *grown = (t_cache_file *) realloc(files, (size_t) capacity * sizeof(t_cache_file));
+            if (grown == NULL) break;
+            files = grown;
+        }
+        strcpy(files[count].name, item->d_name);
+        files[count].size = (size_t) info.st_size;
+        files[count].used = info.st_mtime;
+        total += files[count].size;
+        count++;
+    }
+    if (dir != NULL) closedir(dir);
+
+    if (total > cache->maxDiskBytes) {
+        qsort(files, (size_t) count, sizeof(t_cache_file), cache_compareFiles);
+        for (int i = 0; i < count && total > cache->maxDiskBytes; i++) {
+            snprintf(path, sizeof(path), "%s/%s", cache->directory, files[i].name);
+            if (unlink(path) == 0) {
+                total -= files[i].size;
+                cache->diskEvictions++;
+            }
+        }
+    }
+
+    free(files);
+    flock(lock, LOCK_UN);
+    close(lock);
+}
+
+/**
+ * Écrit un résultat dans le dossier : fichier temporaire au nom unique (mkstemp, sûr entre processus
+ * et entre threads), puis renommage atomique
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param data Le fichier BMP
+ * @param size Taille du fichier
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int cache_writeDisk(t_result_cache *cache, t_cache_key key, const unsigned char *data, size_t size) {
+    char path[1024], temporary[1100];
+    cache_path(cache, key, path, sizeof(path));
+    snprintf(temporary, sizeof(temporary), "%s.XXXXXX", path);
+
+    int fd = mkstemp(temporary);
+    FILE *file = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (file == NULL) {
+        fprintf(stderr, "Impossible d'écrire dans le cache : %s\n", temporary);
+        if (fd >= 0) {
+            close(fd);
+            unlink(temporary);
+        }
+        return -1;
+    }
+    fchmod(fd, 0644); // Lisible par les autres processus de traitement
+    int written = fwrite(data, 1, size, file) == size;
+    if (fclose(file) != 0 || !written || rename(temporary, path) != 0) {
+        fprintf(stderr, "Erreur lors de l'écriture dans le cache : %s\n", path);
+        unlink(temporary);
+        return -1;
+    }
+
+    cache_evictDisk(cache);
+    return 0;
+}
+
+#endif
+
+/**
+ * Crée un cache de résultats
+ *
+ * @param directory Dossier du cache disque (créé au besoin), ou NULL pour un cache en mémoire seulement
+ * @param maxMemoryBytes Mémoire maximale des résultats conservés (en octets)
+ * @param maxDiskBytes Taille maximale du dossier (en octets)
+ * @return t_result_cache*: Pointeur vers le cache créé ou NULL en cas d'erreur
+ */
+t_result_cache *cache_create(const char *directory, size_t maxMemoryBytes, size_t maxDiskBytes) {
+    t_result_cache *cache = (t_result_cache *) calloc(1, sizeof(t_result_cache));
+    if (cache == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le cache de résultats\n");
+        return NULL;
+    }
+
+    cache->capacity = 16;
+    cache->entries = (t_cache_entry *) malloc(cache->capacity * sizeof(t_cache_entry));
+    if (cache->entries == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le cache de résultats\n");
+        free(cache);
+        return NULL;
+    }
+    cache->maxMemoryBytes = maxMemoryBytes;
+    cache->maxDiskBytes = maxDiskBytes;
+
+    if (directory != NULL) {
+#ifdef CACHE_DISK
+        if (mkdir(directory, 0755) != 0 && errno != EEXIST) {
+            fprintf(stderr, "Impossible de créer le dossier du cache : %s\n", directory);
+            cache_destroy(cache);
+            return NULL;
+        }
+        cache->directory = (char *) malloc(strlen(directory) + 1);
+        if (cache->directory == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour le cache de résultats\n");
+            cache_destroy(cache);
+            return NULL;
+        }
+        strcpy(cache->directory, directory);
+#else
+        fprintf(stderr, "Cache disque non disponible sur cette plateforme : cache en mémoire seulement\n");
+#endif
+    }
+    return cache;
+}
+
+/**
+ * Libère un cache et les résultats conservés en mémoire
+ *
+ * @param cache Le cache à libérer
+ */
+void cache_destroy(t_result_cache *cache) {
+    if (cache == NULL) return;
+
+    for (int i = 0; i < cache->count; i++) {
+        free(cache->entries[i].data);
+    }
+    free(cache->entries);
+    free(cache->directory);
+    free(cache);
+}
+
+/**
+ * Cherche un résultat en mémoire puis sur disque
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param size Reçoit la taille du fichier BMP
+ * @return unsigned char*: Copie du fichier BMP (à libérer avec free) ou NULL si le résultat est absent
+ */
+unsigned char *cache_lookup(t_result_cache *cache, t_cache_key key, size_t *size) {
+    if (cache == NULL || size == NULL) return NULL;
+
+    t_cache_entry *entry = cache_findMemory(cache, key);
+    if (entry != NULL) {
+        unsigned char *copy = (unsigned char *) malloc(entry->size);
+        if (copy == NULL) return NULL;
+        memcpy(copy, entry->data, entry->size);
+        *size = entry->size;
+        cache->memoryHits++;
+        return copy;
+    }
+
+#ifdef CACHE_DISK
+    if (cache->directory != NULL) {
+        char path[1024];
+        cache_path(cache, key, path, sizeof(path));
+        unsigned char *data = cache_readFile(path, size);
+        if (data != NULL) {
+            utime(path, NULL); // Date de modification = dernière utilisation, pour l'éviction LRU
+            cache_putMemory(cache, key, data, *size);
+            cache->diskHits++;
+            return data;
+        }
+    }
+#endif
+
+    cache->misses++;
+    return NULL;
+}
+
+/**
+ * Ajoute un résultat au cache (en mémoire et sur disque)
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param data Le fichier BMP résultat
+ * @param size Taille du fichier en octets
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int cache_store(t_result_cache *cache, t_cache_key key, const unsigned char *data, size_t size) {
+    if (cache == NULL || data == NULL || size == 0) return -1;
+
+    cache_putMemory(cache, key, data, size);
+    cache->stores++;
+
+#ifdef CACHE_DISK
+    if (cache->directory != NULL) return cache_writeDisk(cache, key, data, size);
+#endif
+    return 0;
+}
+
+/**
+ * Ajoute au cache un fichier BMP résultat déjà écrit
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param path Chemin complet du fichier
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int cache_storeFile(t_result_cache *cache, t_cache_key key, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Fichier non trouvé : %s\n", path);
+        return -1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = length > 0 ? (unsigned char *) malloc((size_t) length) : NULL;
+    if (data == NULL || fread(data, 1, (size_t) length, file) != (size_t) length) {
+        fprintf(stderr, "Erreur lors de la lecture du fichier : %s\n", path);
+        free(data);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    int status = cache_store(cache, key, data, (size_t) length);
+    free(data);
+    return status;
+}
+
+/**
+ * Affiche les statistiques d'un cache
+ *
+ * @param cache Le cache
+ */
+void cache_printStats(const t_result_cache *cache) {
+    if (cache == NULL) {
+        printf("⚠️ Cache de résultats non valide\n");
+        return;
+    }
+
+    unsigned long hits = cache->memoryHits + cache->diskHits;
+    unsigned long total = hits + cache->misses;
+    printf("Recherches: %lu (mémoire: %lu, disque: %lu, absents: %lu, taux: %.1f%%)\n", total, cache->memoryHits,
+           cache->diskHits, cache->misses, total > 0 ? 100.0 * hits / total : 0.0);
+    printf("Résultats ajoutés: %lu\n", cache->stores);
+    printf("Évictions: %lu (mémoire), %lu (disque)\n", cache->evictions, cache->diskEvictions);
+    printf("Mémoire conservée: %zu / %zu octets (%d résultats)\n", cache->memoryBytes, cache->maxMemoryBytes,
+           cache->count);
+}
@@ -0,0 +1,159 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bmp8.h"
+#include "color.h"
+
+// Cache de résultats adressé par contenu : la clé combine une empreinte de l'image d'entrée
+// (octets du fichier, ou pixels et paramètres d'une image déjà chargée) et une empreinte de la
+// chaîne d'opérations ; la valeur est le fichier BMP produit.
+// Deux niveaux, chacun en LRU avec une taille maximale :
+//  - en mémoire, propre au processus (un cache par thread, comme t_image_pool) ;
+//  - sur disque, un fichier par résultat dans un dossier partagé par plusieurs processus.
+//    Les fichiers sont écrits sous un nom temporaire puis renommés (jamais lus à moitié écrits),
+//    et l'éviction se fait sous un verrou exclusif (flock) sur le fichier .verrou du dossier.
+
+// Version du format des résultats : à incrémenter quand un filtre change de résultat
+#define CACHE_VERSION 1
+
+typedef struct {
+    uint64_t input; // Empreinte des pixels et des paramètres de l'image d'entrée
+    uint64_t chain; // Empreinte de la chaîne d'opérations (cache_chainHash)
+} t_cache_key;
+
+typedef struct {
+    t_cache_key key;
+    unsigned char *data; // Fichier BMP résultat
+    size_t size; // Taille du fichier en octets
+} t_cache_entry;
+
+typedef struct {
+    t_cache_entry *entries; // Résultats en mémoire, du moins récemment utilisé au plus récent
+    int count;
+    int capacity;
+    size_t maxMemoryBytes; // Mémoire maximale des résultats conservés
+    size_t memoryBytes; // Mémoire actuellement conservée
+
+    char *directory; // Dossier du cache disque, NULL si le cache est seulement en mémoire
+    size_t maxDiskBytes; // Taille maximale du dossier
+
+    // Statistiques
+    unsigned long memoryHits; // Résultats trouvés en mémoire
+    unsigned long diskHits; // Résultats trouvés sur disque
+    unsigned long misses; // Résultats absents (à calculer)
+    unsigned long stores; // Résultats ajoutés
+    unsigned long evictions; // Résultats retirés de la mémoire pour respecter maxMemoryBytes
+    unsigned long diskEvictions; // Fichiers supprimés pour respecter maxDiskBytes
+} t_result_cache;
+
+/**
+ * Empreinte 64 bits rapide d'un bloc d'octets (algorithme XXH64)
+ *
+ * @param data Les octets
+ * @param size Nombre d'octets
+ * @param seed Graine (0 pour l'empreinte XXH64 standard)
+ * @return uint64_t: L'empreinte
+ */
+uint64_t cache_hash(const void *data, size_t size, uint64_t seed);
+
+/**
+ * Empreinte canonique d'une chaîne d'opérations : chaque opération (nom et paramètres, par exemple
+ * "luminosite") est encodée avec sa longueur, de sorte que deux chaînes différentes ne se confondent pas
+ *
+ * @param operations Les opérations dans l'ordre d'application
+ * @param count Nombre d'opérations
+ * @return uint64_t: L'empreinte
+ */
+uint64_t cache_chainHash(char **operations, int count);
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur une image 8 bits qui vient d'être chargée
+ * (pixels, dimensions, profondeur, orientation, en-tête et palette)
+ *
+ * @param img L'image d'entrée
+ * @param chain Empreinte de la chaîne d'opérations
+ * @return t_cache_key: La clé
+ */
+t_cache_key cache_keyBmp8(const t_bmp8 *img, uint64_t chain);
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur une image 24 ou 32 bits qui vient d'être chargée
+ * (pixels, dimensions, profondeur, orientation et masques)
+ *
+ * @param img L'image d'entrée
+ * @param chain Empreinte de la chaîne d'opérations
+ * @return t_cache_key: La clé
+ */
+t_cache_key cache_keyBmp24(const t_bmp24 *img, uint64_t chain);
+
+/**
+ * Clé du résultat d'une chaîne d'opérations sur un fichier BMP, sans décoder l'image :
+ * empreinte de tous les octets du fichier (en-têtes, palette ou masques, pixels), lus par mmap
+ * quand le système le permet ; deux fichiers identiques octet pour octet donnent le même résultat
+ *
+ * @param path Chemin complet du fichier
+ * @param chain Empreinte de la chaîne d'opérations
+ * @param key Reçoit la clé
+ * @return int: 0 en cas de succès, -1 si le fichier ne peut pas être lu
+ */
+int cache_keyFile(const char *path, uint64_t chain, t_cache_key *key);
+
+/**
+ * Crée un cache de résultats
+ *
+ * @param directory Dossier du cache disque (créé au besoin), ou NULL pour un cache en mémoire seulement
+ * @param maxMemoryBytes Mémoire maximale des résultats conservés (en octets)
+ * @param maxDiskBytes Taille maximale du dossier (en octets)
+ * @return t_result_cache*: Pointeur vers le cache créé ou NULL en cas d'erreur
+ */
+t_result_cache *cache_create(const char *directory, size_t maxMemoryBytes, size_t maxDiskBytes);
+
+/**
+ * Libère un cache et les résultats conservés en mémoire (le dossier est conservé)
+ *
+ * @param cache Le cache à libérer
+ */
+void cache_destroy(t_result_cache *cache);
+
+/**
+ * Cherche un résultat en mémoire puis sur disque (un résultat trouvé sur disque est gardé en mémoire)
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param size Reçoit la taille du fichier BMP
+ * @return unsigned char*: Copie du fichier BMP (à libérer avec free) ou NULL si le résultat est absent
+ */
+unsigned char *cache_lookup(t_result_cache *cache, t_cache_key key, size_t *size);
+
+/**
+ * Ajoute un résultat au cache (en mémoire et sur disque)
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param data Le fichier BMP résultat
+ * @param size Taille du fichier en octets
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int cache_store(t_result_cache *cache, t_cache_key key, const unsigned char *data, size_t size);
+
+/**
+ * Ajoute au cache un fichier BMP résultat déjà écrit
+ *
+ * @param cache Le cache
+ * @param key La clé du résultat
+ * @param path Chemin complet du fichier
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int cache_storeFile(t_result_cache *cache, t_cache_key key, const char *path);
+
+/**
+ * Affiche les statistiques d'un cache (succès mémoire et disque, échecs, taux, évictions, tailles)
+ *
+ * @param cache Le cache
+ */
+void cache_printStats(const t_result_cache *cache);
+
+#endif //CACHE_H
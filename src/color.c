@@ -1,4 +1,7 @@
 #include "color.h"
+#include "arena.h"
+#include "colorspace.h"
+#include "trace.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -33,8 +36,23 @@ void file_rawWrite(uint32_t position, void *buffer, uint32_t size, size_t n, FIL
     fwrite(buffer, size, n, file);
 }
 
+// Masques des canaux rouge, vert, bleu et alpha lorsque le fichier a la disposition d'un t_pixel
+static const uint32_t bmp24_standardMasks[4] = {0x00FF0000u, 0x0000FF00u, 0x000000FFu, 0xFF000000u};
+
+/**
+ * Calcule la taille d'une rangée de pixels dans le fichier (complétée à un multiple de 4 octets)
+ *
+ * @param width Largeur de l'image en pixels
+ * @param colorDepth Profondeur de couleur en bits (24 ou 32)
+ * @return uint32_t: Le nombre d'octets d'une rangée du fichier
+ */
+uint32_t bmp24_rowSize(int width, int colorDepth) {
+    return ((uint32_t) width * (uint32_t) (colorDepth / 8) + 3) & ~(uint32_t) 3;
+}
+
 /**
  * Alloue de la mémoire pour les pixels d'une image BMP 24 bits
+ * Les rangées sont contiguës dans un seul bloc (pixels[0]), pixels[y] pointe sur la rangée y
  *
  * @param width Largeur de l'image en pixels
  * @param height Hauteur de l'image en pixels
@@ -47,22 +65,15 @@ t_pixel **bmp24_allocateDataPixels(int width, int height) {
         return NULL;
     }
 
-    // Initialiser tous les pointeurs à NULL pour faciliter la libération en cas d'erreur
-    for (int i = 0; i < height; i++) {
-        pixels[i] = NULL;
+    t_pixel *block = malloc((size_t) width * height * sizeof(t_pixel));
+    if (block == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour les pixels\n");
+        free(pixels);
+        return NULL;
     }
 
     for (int i = 0; i < height; i++) {
-        pixels[i] = malloc(width * sizeof(t_pixel));
-        if (pixels[i] == NULL) {
-            fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour la ligne %d\n", i);
-            // Libérer la mémoire déjà allouée
-            for (int j = 0; j < i; j++) {
-                free(pixels[j]);
-            }
-            free(pixels);
-            return NULL;
-        }
+        pixels[i] = block + (size_t) i * width;
     }
 
     return pixels;
@@ -77,10 +88,9 @@ t_pixel **bmp24_allocateDataPixels(int width, int height) {
 void bmp24_freeDataPixels(t_pixel **pixels, int height) {
     if (pixels == NULL) return;
 
-    for (int i = 0; i < height; i++) {
-        if (pixels[i] != NULL) {
-            free(pixels[i]);
-        }
+    // Toutes les rangées partagent le bloc de la première
+    if (height > 0) {
+        free(pixels[0]);
     }
     free(pixels);
 }
@@ -90,7 +100,7 @@ void bmp24_freeDataPixels(t_pixel **pixels, int height) {
  *
  * @param width Largeur de l'image en pixels
  * @param height Hauteur de l'image en pixels
- * @param colorDepth Profondeur de couleur en bits (devrait être 24)
+ * @param colorDepth Profondeur de couleur du fichier en bits (24 ou 32)
  * @return t_bmp24*: Pointeur vers l'image créée ou NULL en cas d'erreur
  */
 t_bmp24 *bmp24_allocate(int width, int height, int colorDepth) {
@@ -102,6 +112,7 @@ t_bmp24 *bmp24_allocate(int width, int height, int colorDepth) {
 
     img->width = width;
     img->height = height;
+    bmp24_reset(img);
     img->colorDepth = colorDepth;
 
     img->data = bmp24_allocateDataPixels(width, height);
@@ -114,6 +125,23 @@ t_bmp24 *bmp24_allocate(int width, int height, int colorDepth) {
     return img;
 }
 
+/**
+ * Remet une image BMP 24 bits dans l'état d'une image neuve, sans toucher aux pixels (image recyclée) :
+ * en-têtes vierges, masques standard, 24 bits de bas en haut
+ *
+ * @param img L'image à réinitialiser
+ */
+void bmp24_reset(t_bmp24 *img) {
+    if (img == NULL) return;
+
+    // En-têtes vierges : bmp24_saveImage les complète à partir des dimensions
+    memset(&img->header, 0, sizeof(img->header));
+    memset(&img->header_info, 0, sizeof(img->header_info));
+    memcpy(img->masks, bmp24_standardMasks, sizeof(img->masks));
+    img->colorDepth = 24;
+    img->topDown = 0;
+}
+
 /**
  * Libère la mémoire allouée pour une image BMP 24 bits
  *
@@ -126,6 +154,137 @@ void bmp24_free(t_bmp24 *img) {
     free(img);
 }
 
+/**
+ * Position et nombre de bits d'un canal décrit par un masque (bits consécutifs)
+ *
+ * @param mask Le masque du canal
+ * @param shift Reçoit la position du bit de poids faible
+ * @param bits Reçoit le nombre de bits du canal (0 si le masque est nul)
+ */
+static void bmp24_maskInfo(uint32_t mask, int *shift, int *bits) {
+    *shift = 0;
+    *bits = 0;
+    if (mask == 0) return;
+    while (!((mask >> *shift) & 1)) (*shift)++;
+    while (*shift + *bits < 32 && ((mask >> (*shift + *bits)) & 1)) (*bits)++;
+}
+
+/**
+ * Indique si les rangées du fichier ont exactement la disposition de t_pixel (BGRA 32 bits)
+ *
+ * @param colorDepth Profondeur du fichier (24 ou 32)
+ * @param compression BMP_BI_RGB ou BMP_BI_BITFIELDS
+ * @param masks Masques rouge, vert, bleu et alpha (BMP_BI_BITFIELDS)
+ * @return int: 1 si une rangée du fichier peut être copiée telle quelle, 0 sinon
+ */
+static int bmp24_isDirectLayout(int colorDepth, uint32_t compression, const uint32_t masks[4]) {
+    if (colorDepth != 32) return 0;
+    if (compression != BMP_BI_BITFIELDS) return 1;
+    return masks[0] == bmp24_standardMasks[0] && masks[1] == bmp24_standardMasks[1] &&
+           masks[2] == bmp24_standardMasks[2] && masks[3] == bmp24_standardMasks[3];
+}
+
+/**
+ * Indique si un fichier 32 bits déclare un canal alpha. En BMP_BI_RGB, le quatrième octet est réservé :
+ * sa valeur (souvent 0) n'est pas une opacité, les pixels sont lus opaques comme sans masque alpha.
+ *
+ * @param compression BMP_BI_RGB ou BMP_BI_BITFIELDS
+ * @param masks Masques rouge, vert, bleu et alpha (BMP_BI_BITFIELDS)
+ * @return int: 1 si l'alpha du fichier est conservé, 0 si les pixels sont opaques
+ */
+static int bmp24_hasAlpha(uint32_t compression, const uint32_t masks[4]) {
+    return compression == BMP_BI_BITFIELDS && masks[3] != 0;
+}
+
+/**
+ * Rend opaques (alpha à 255) des pixels lus directement depuis le fichier
+ *
+ * @param pixels Les pixels
+ * @param count Nombre de pixels
+ */
+static void bmp24_setOpaque(t_pixel *pixels, size_t count) {
+    for (size_t i = 0; i < count; i++) pixels[i].alpha = 255;
+}
+
+/**
+ * Convertit une rangée du fichier (24 ou 32 bits) en pixels
+ *
+ * @param src Les octets de la rangée dans le fichier
+ * @param dst Reçoit les pixels
+ * @param width Nombre de pixels
+ * @param colorDepth Profondeur du fichier (24 ou 32)
+ * @param compression BMP_BI_RGB ou BMP_BI_BITFIELDS
+ * @param masks Masques rouge, vert, bleu et alpha (BMP_BI_BITFIELDS)
+ */
+static void bmp24_decodeRow(const uint8_t *src, t_pixel *dst, int width, int colorDepth, uint32_t compression,
+                            const uint32_t masks[4]) {
+    if (colorDepth == 24) {
+        for (int x = 0; x < width; x++) {
+            dst[x].blue = src[3 * x];
+            dst[x].green = src[3 * x + 1];
+            dst[x].red = src[3 * x + 2];
+            dst[x].alpha = 255;
+        }
+        return;
+    }
+
+    uint32_t opaque[4] = {masks[0], masks[1], masks[2], bmp24_standardMasks[3]};
+    if (bmp24_isDirectLayout(colorDepth, compression, masks[3] == 0 ? opaque : masks)) {
+        // Même disposition que t_pixel : copie directe de la rangée
+        memcpy(dst, src, (size_t) width * sizeof(t_pixel));
+        if (!bmp24_hasAlpha(compression, masks)) bmp24_setOpaque(dst, width);
+        return;
+    }
+
+    // Masques quelconques : chaque canal est extrait puis ramené sur 8 bits
+    int shift[4], bits[4];
+    for (int c = 0; c < 4; c++) bmp24_maskInfo(masks[c], &shift[c], &bits[c]);
+
+    for (int x = 0; x < width; x++) {
+        const uint8_t *p = src + 4 * x;
+        uint32_t value = (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+        uint8_t channels[4];
+        for (int c = 0; c < 4; c++) {
+            if (bits[c] == 0) {
+                channels[c] = 255;
+                continue;
+            }
+            uint32_t v = (value & masks[c]) >> shift[c];
+            if (bits[c] >= 8) {
+                channels[c] = (uint8_t) (v >> (bits[c] - 8));
+            } else {
+                uint32_t max = (1u << bits[c]) - 1;
+                channels[c] = (uint8_t) ((v * 255 + max / 2) / max);
+            }
+        }
+        dst[x].red = channels[0];
+        dst[x].green = channels[1];
+        dst[x].blue = channels[2];
+        dst[x].alpha = channels[3];
+    }
+}
+
+/**
+ * Convertit des pixels en une rangée du fichier (24 ou 32 bits, disposition de t_pixel)
+ *
+ * @param src Les pixels
+ * @param dst Reçoit les octets de la rangée
+ * @param width Nombre de pixels
+ * @param colorDepth Profondeur du fichier (24 ou 32)
+ */
+static void bmp24_encodeRow(const t_pixel *src, uint8_t *dst, int width, int colorDepth) {
+    if (colorDepth == 32) {
+        memcpy(dst, src, (size_t) width * sizeof(t_pixel));
+        return;
+    }
+
+    for (int x = 0; x < width; x++) {
+        dst[3 * x] = src[x].blue;
+        dst[3 * x + 1] = src[x].green;
+        dst[3 * x + 2] = src[x].red;
+    }
+}
+
 /**
  * Lit la valeur d'un pixel à une position spécifique
  *
@@ -135,23 +294,70 @@ void bmp24_free(t_bmp24 *img) {
  * @param file Fichier BMP ouvert
  */
 void bmp24_readPixelValue(t_bmp24 *image, int x, int y, FILE *file) {
-    int y_pos = image->height - 1 - y; // Inverser les lignes (bas en haut)
-    fseek(file, image->header.offset + (y_pos * image->width + x) * 3, SEEK_SET);
-    fread(&image->data[y][x], sizeof(t_pixel), 1, file);
+    int bytes = image->colorDepth / 8;
+    int y_pos = image->topDown ? y : image->height - 1 - y; // Rangées du fichier de bas en haut sauf topDown
+    uint8_t raw[4];
+
+    fseek(file, image->header.offset + (long) y_pos * bmp24_rowSize(image->width, image->colorDepth) +
+                (long) x * bytes, SEEK_SET);
+    if (fread(raw, 1, bytes, file) != (size_t) bytes) return;
+    bmp24_decodeRow(raw, &image->data[y][x], 1, image->colorDepth, image->header_info.compression, image->masks);
 }
 
 /**
- * Lit toutes les données de pixels d'une image BMP 24 bits
+ * Lit toutes les données de pixels d'une image BMP 24 bits, une rangée à la fois
  *
  * @param image Pointeur vers l'image BMP 24 bits
  * @param file Fichier BMP ouvert
+ * @return int: 0 en cas de succès, -1 si le fichier est incomplet
  */
-void bmp24_readPixelData(t_bmp24 *image, FILE *file) {
-    for (int y = 0; y < image->height; y++) {
-        for (int x = 0; x < image->width; x++) {
-            bmp24_readPixelValue(image, x, y, file);
+int bmp24_readPixelData(t_bmp24 *image, FILE *file) {
+    fseek(file, image->header.offset, SEEK_SET);
+
+    // Disposition identique à t_pixel : lecture directe dans les rangées, sans conversion.
+    // Un fichier de haut en bas a l'ordre des rangées de data, contiguës : une seule lecture.
+    if (bmp24_isDirectLayout(image->colorDepth, image->header_info.compression, image->masks)) {
+        size_t rowPixels = (size_t) image->width;
+        size_t total = rowPixels * image->height;
+        if (image->topDown) {
+            if (fread(image->data[0], sizeof(t_pixel), total, file) != total) {
+                fprintf(stderr, "Erreur: Lecture des pixels incomplète\n");
+                return -1;
+            }
+        } else {
+            for (int y = image->height - 1; y >= 0; y--) {
+                if (fread(image->data[y], sizeof(t_pixel), rowPixels, file) != rowPixels) {
+                    fprintf(stderr, "Erreur: Lecture des pixels incomplète\n");
+                    return -1;
+                }
+            }
         }
+        // Rangées contiguës : l'octet réservé de BMP_BI_RGB est remplacé en une passe
+        if (!bmp24_hasAlpha(image->header_info.compression, image->masks)) bmp24_setOpaque(image->data[0], total);
+        return 0;
     }
+
+    uint32_t rowSize = bmp24_rowSize(image->width, image->colorDepth);
+    uint8_t *row = scratch_alloc(rowSize);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour la lecture des pixels\n");
+        return -1;
+    }
+
+    // Rangées du fichier de bas en haut, ou de haut en bas (hauteur négative)
+    for (int i = 0; i < image->height; i++) {
+        int y = image->topDown ? i : image->height - 1 - i;
+        if (fread(row, 1, rowSize, file) != rowSize) {
+            fprintf(stderr, "Erreur: Lecture des pixels incomplète\n");
+            scratch_free(row);
+            return -1;
+        }
+        bmp24_decodeRow(row, image->data[y], image->width, image->colorDepth, image->header_info.compression,
+                        image->masks);
+    }
+
+    scratch_free(row);
+    return 0;
 }
 
 /**
@@ -163,21 +369,115 @@ void bmp24_readPixelData(t_bmp24 *image, FILE *file) {
  * @param file Fichier BMP ouvert
  */
 void bmp24_writePixelValue(t_bmp24 *image, int x, int y, FILE *file) {
-    fwrite(&image->data[y][x], sizeof(t_pixel), 1, file);
+    uint8_t raw[4];
+    bmp24_encodeRow(&image->data[y][x], raw, 1, image->colorDepth);
+    fwrite(raw, 1, image->colorDepth / 8, file);
 }
 
 /**
- * Écrit toutes les données de pixels d'une image BMP 24 bits
+ * Écrit toutes les données de pixels d'une image BMP 24 bits, une rangée à la fois
  *
  * @param image Pointeur vers l'image BMP 24 bits
  * @param file Fichier BMP ouvert
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'écriture
+ */
+int bmp24_writePixelData(t_bmp24 *image, FILE *file) {
+    // 32 bits : les rangées de data sont déjà celles du fichier (une seule écriture de haut en bas)
+    if (image->colorDepth == 32) {
+        size_t rowPixels = (size_t) image->width;
+        if (image->topDown) {
+            size_t total = rowPixels * image->height;
+            if (fwrite(image->data[0], sizeof(t_pixel), total, file) != total) {
+                fprintf(stderr, "Erreur: Écriture des pixels incomplète\n");
+                return -1;
+            }
+            return 0;
+        }
+        for (int y = image->height - 1; y >= 0; y--) {
+            if (fwrite(image->data[y], sizeof(t_pixel), rowPixels, file) != rowPixels) {
+                fprintf(stderr, "Erreur: Écriture des pixels incomplète\n");
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    uint32_t rowSize = bmp24_rowSize(image->width, image->colorDepth);
+    uint8_t *row = scratch_alloc(rowSize);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour l'écriture des pixels\n");
+        return -1;
+    }
+    // Octets de bourrage en fin de rangée à 0
+    memset(row, 0, rowSize);
+
+    for (int i = 0; i < image->height; i++) {
+        int y = image->topDown ? i : image->height - 1 - i;
+        bmp24_encodeRow(image->data[y], row, image->width, image->colorDepth);
+        if (fwrite(row, 1, rowSize, file) != rowSize) {
+            fprintf(stderr, "Erreur: Écriture des pixels incomplète\n");
+            scratch_free(row);
+            return -1;
+        }
+    }
+
+    scratch_free(row);
+    return 0;
+}
+
+/**
+ * Lit et vérifie les en-têtes d'un fichier BMP 24 ou 32 bits, ainsi que ses masques
+ *
+ * @param file Fichier BMP ouvert
+ * @param filename Nom du fichier (messages d'erreur)
+ * @param header Reçoit l'en-tête du fichier
+ * @param header_info Reçoit l'en-tête de l'image
+ * @param masks Reçoit les masques rouge, vert, bleu et alpha (BMP_BI_BITFIELDS)
+ * @param topDown Reçoit 1 si les rangées vont de haut en bas (hauteur négative, rendue positive)
+ * @return int: 0 si l'image peut être lue, -1 sinon
  */
-void bmp24_writePixelData(t_bmp24 *image, FILE *file) {
-    for (int y = image->height - 1; y >= 0; y--) {
-        for (int x = 0; x < image->width; x++) {
-            bmp24_writePixelValue(image, x, y, file);
+static int bmp24_readHeaders(FILE *file, const char *filename, t_bmp_header *header, t_bmp_info *header_info,
+                             uint32_t masks[4], int *topDown) {
+    // Vérifier que c'est bien un fichier BMP valide
+    if (fread(header, sizeof(t_bmp_header), 1, file) != 1 || header->type != BMP_TYPE ||
+        fread(header_info, sizeof(t_bmp_info), 1, file) != 1) {
+        fprintf(stderr, "Erreur: Le fichier %s n'est pas un fichier BMP valide\n", filename);
+        return -1;
+    }
+
+    // Vérifier que c'est une image 24 ou 32 bits
+    if (header_info->bits != 24 && header_info->bits != 32) {
+        fprintf(stderr, "Erreur: Le fichier %s n'est pas une image 24 ou 32 bits\n", filename);
+        return -1;
+    }
+    if (header_info->compression != BMP_BI_RGB &&
+        !(header_info->compression == BMP_BI_BITFIELDS && header_info->bits == 32)) {
+        fprintf(stderr, "Erreur: Compression non prise en charge (%u) dans %s\n", header_info->compression, filename);
+        return -1;
+    }
+
+    // Vérifier les dimensions (limiter à une taille raisonnable) ; hauteur négative : image de haut en bas
+    if (header_info->width <= 0 || header_info->width > 10000 ||
+        header_info->height == 0 || header_info->height > 10000 || header_info->height < -10000) {
+        fprintf(stderr, "Erreur: Dimensions d'image invalides (%d x %d)\n",
+                header_info->width, header_info->height);
+        return -1;
+    }
+    *topDown = header_info->height < 0;
+    if (*topDown) header_info->height = -header_info->height;
+
+    memcpy(masks, bmp24_standardMasks, 4 * sizeof(uint32_t));
+    if (header_info->compression == BMP_BI_BITFIELDS) {
+        // Masques à la suite d'un en-tête de 40 octets, ou dans l'en-tête (V3 et suivants, avec alpha)
+        size_t count = header_info->size >= INFO_SIZE + 16 ? 4 : 3;
+        masks[3] = 0;
+        if (fread(masks, sizeof(uint32_t), count, file) != count) {
+            fprintf(stderr, "Erreur: Masques des canaux absents dans %s\n", filename);
+            return -1;
         }
     }
+
+    return 0;
 }
 
 /**
@@ -187,6 +487,20 @@ void bmp24_writePixelData(t_bmp24 *image, FILE *file) {
  * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
  */
 t_bmp24 *bmp24_loadImage(const char *filename) {
+    return bmp24_loadImageWith(filename, NULL, NULL);
+}
+
+/**
+ * Charge une image BMP 24 bits en obtenant l'image destination auprès d'un allocateur
+ *
+ * @param filename Nom du fichier à charger
+ * @param allocate Fournit une image de la taille lue dans l'en-tête (NULL pour bmp24_allocate)
+ * @param context Paramètre transmis à l'allocateur
+ * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_loadImageWith(const char *filename, t_bmp24_allocator allocate, void *context) {
+    TRACE_BEGIN("bmp24_loadImage");
+
     char path[512];
     strcpy(path, "../images/");
     strcat(path, filename);
@@ -198,39 +512,19 @@ t_bmp24 *bmp24_loadImage(const char *filename) {
         return NULL;
     }
 
-    // Lire l'en-tête du fichier BMP
+    // Lire et vérifier les en-têtes
     t_bmp_header header;
-    fread(&header, sizeof(t_bmp_header), 1, file);
-
-    // Vérifier que c'est bien un fichier BMP valide
-    if (header.type != BMP_TYPE) {
-        fprintf(stderr, "Erreur: Le fichier %s n'est pas un fichier BMP valide\n", filename);
-        fclose(file);
-        return NULL;
-    }
-
-    // Lire les informations d'en-tête de l'image
     t_bmp_info header_info;
-    fread(&header_info, sizeof(t_bmp_info), 1, file);
-
-    // Vérifier que c'est une image 24 bits
-    if (header_info.bits != 24) {
-        fprintf(stderr, "Erreur: Le fichier %s n'est pas une image 24 bits\n", filename);
+    uint32_t masks[4];
+    int topDown;
+    if (bmp24_readHeaders(file, filename, &header, &header_info, masks, &topDown) != 0) {
         fclose(file);
         return NULL;
     }
 
-    // Vérifier les dimensions (limiter à une taille raisonnable)
-    if (header_info.width <= 0 || header_info.width > 10000 ||
-        header_info.height <= 0 || header_info.height > 10000) {
-        fprintf(stderr, "Erreur: Dimensions d'image invalides (%d x %d)\n",
-                header_info.width, header_info.height);
-        fclose(file);
-        return NULL;
-        }
-
     // Allouer une structure t_bmp24 avec les dimensions lues
-    t_bmp24 *image = bmp24_allocate(header_info.width, header_info.height, 24);
+    t_bmp24 *image = allocate != NULL ? allocate(context, header_info.width, header_info.height)
+                                      : bmp24_allocate(header_info.width, header_info.height, header_info.bits);
     if (image == NULL) {
         fprintf(stderr, "Erreur: Impossible d'allouer la mémoire pour l'image\n");
         fclose(file);
@@ -240,13 +534,21 @@ t_bmp24 *bmp24_loadImage(const char *filename) {
     // Copier les en-têtes lus dans la structure
     image->header = header;
     image->header_info = header_info;
+    image->colorDepth = header_info.bits;
+    memcpy(image->masks, masks, sizeof(image->masks));
+    image->topDown = topDown;
 
     // Lire les données des pixels
-    bmp24_readPixelData(image, file);
+    if (bmp24_readPixelData(image, file) != 0) {
+        bmp24_free(image);
+        fclose(file);
+        return NULL;
+    }
 
     // Fermer le fichier
     fclose(file);
 
+    TRACE_END(image->width, image->height, (size_t) image->width * image->height * sizeof(t_pixel));
     return image;
 }
 
@@ -257,6 +559,16 @@ t_bmp24 *bmp24_loadImage(const char *filename) {
  * @param filename Nom du fichier de destination
  */
 void bmp24_saveImage(t_bmp24 *img, const char *filename) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Erreur: Impossible de sauvegarder une image NULL\n");
+        return;
+    }
+    if (img->colorDepth != 24 && img->colorDepth != 32) {
+        fprintf(stderr, "Erreur: Profondeur de couleur non prise en charge (%d bits)\n", img->colorDepth);
+        return;
+    }
+    TRACE_BEGIN("bmp24_saveImage");
+
     char path[512];
     strcpy(path, "../images/");
     strcat(path, filename);
@@ -268,20 +580,53 @@ void bmp24_saveImage(t_bmp24 *img, const char *filename) {
         return;
     }
 
+    // En-têtes recalculés à partir de l'image (dimensions, profondeur, tailles)
+    int bitfields = img->colorDepth == 32 && img->header_info.compression == BMP_BI_BITFIELDS;
+    uint32_t infoSize = bitfields ? INFO_V4_SIZE : INFO_SIZE;
+
+    t_bmp_info header_info;
+    memset(&header_info, 0, sizeof(header_info));
+    header_info.size = infoSize;
+    header_info.width = img->width;
+    header_info.height = img->topDown ? -img->height : img->height;
+    header_info.planes = 1;
+    header_info.bits = (uint16_t) img->colorDepth;
+    header_info.compression = bitfields ? BMP_BI_BITFIELDS : BMP_BI_RGB;
+    header_info.imagesize = bmp24_rowSize(img->width, img->colorDepth) * (uint32_t) img->height;
+    header_info.xresolution = img->header_info.xresolution;
+    header_info.yresolution = img->header_info.yresolution;
+
+    t_bmp_header header;
+    memset(&header, 0, sizeof(header));
+    header.type = BMP_TYPE;
+    header.offset = HEADER_SIZE + infoSize;
+    header.size = header.offset + header_info.imagesize;
+
     // Écrire l'en-tête du fichier BMP
-    file_rawWrite(BITMAP_MAGIC, &img->header, HEADER_SIZE, 1, file);
+    file_rawWrite(BITMAP_MAGIC, &header, HEADER_SIZE, 1, file);
 
     // Écrire les informations d'en-tête de l'image
-    file_rawWrite(HEADER_SIZE, &img->header_info, INFO_SIZE, 1, file);
-
-    // Calculer la taille de l'image
-    file_rawWrite(img->header.offset, &img->header_info, img->header_info.imagesize, 1, file);
+    file_rawWrite(HEADER_SIZE, &header_info, INFO_SIZE, 1, file);
+
+    if (bitfields) {
+        // Suite de l'en-tête V4 : masques rouge, vert, bleu, alpha, espace sRGB, points et gamma inutilisés
+        uint32_t v4[(INFO_V4_SIZE - INFO_SIZE) / sizeof(uint32_t)];
+        memset(v4, 0, sizeof(v4));
+        memcpy(v4, bmp24_standardMasks, sizeof(bmp24_standardMasks));
+        v4[4] = 0x73524742; // 'sRGB'
+        fwrite(v4, sizeof(v4), 1, file);
+        memcpy(img->masks, bmp24_standardMasks, sizeof(img->masks));
+    }
 
     // Écrire les données des pixels
+    img->header = header;
+    img->header_info = header_info;
+    img->header_info.height = img->height; // Orientation gardée dans topDown
     bmp24_writePixelData(img, file);
 
     // Fermer le fichier
     fclose(file);
+    TRACE_END(img->width, img->height, (size_t) img->width * img->height * sizeof(t_pixel));
 }
 
 /**
@@ -317,13 +662,27 @@ void bmp24_printInfo(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_negative(t_bmp24 *img) {
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x].red = 255 - img->data[y][x].red;
-            img->data[y][x].green = 255 - img->data[y][x].green;
-            img->data[y][x].blue = 255 - img->data[y][x].blue;
+    if (img == NULL || img->data == NULL) return;
+    view24_negative(bmp24_view(img, 0, 0, img->width, img->height));
+}
+
+/**
+ * Applique un effet négatif aux pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ */
+void view24_negative(t_view24 view) {
+    if (view.data == NULL) return;
+    TRACE_BEGIN("view24_negative");
+    for (int y = 0; y < view.height; y++) {
+        t_pixel *row = view.data + (size_t) y * view.stride;
+        for (int x = 0; x < view.width; x++) {
+            row[x].red = 255 - row[x].red;
+            row[x].green = 255 - row[x].green;
+            row[x].blue = 255 - row[x].blue;
         }
     }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height * sizeof(t_pixel));
 }
 
 /**
@@ -332,17 +691,130 @@ void bmp24_negative(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_grayscale(t_bmp24 *img) {
+    if (img == NULL || img->data == NULL) return;
+    view24_grayscale(bmp24_view(img, 0, 0, img->width, img->height));
+}
+
+/**
+ * Convertit en niveaux de gris les pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ */
+void view24_grayscale(t_view24 view) {
+    if (view.data == NULL) return;
+    TRACE_BEGIN("view24_grayscale");
+
+    uint8_t *luma = scratch_alloc(view.width * sizeof(uint8_t));
+    if (luma == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour la conversion en niveaux de gris\n");
+        return;
+    }
+
+    for (int y = 0; y < view.height; y++) {
+        t_pixel *row = view.data + (size_t) y * view.stride;
+        // Luminance BT.601 de la rangée (0.299 R + 0.587 G + 0.114 B)
+        color_rgbToLuma(row, luma, view.width);
+
+        // Affecter cette luminance à chaque canal
+        for (int x = 0; x < view.width; x++) {
+            row[x].red = luma[x];
+            row[x].green = luma[x];
+            row[x].blue = luma[x];
+        }
+    }
+
+    scratch_free(luma);
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height * sizeof(t_pixel));
+}
+
+/**
+ * Convertit une image BMP 24 bits en véritable image BMP 8 bits en niveaux de gris
+ *
+ * @param img Pointeur vers l'image à convertir (non modifiée)
+ * @return t_bmp8*: Nouvelle image 8 bits ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_toBmp8(const t_bmp24 *img) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Erreur: Impossible de convertir une image NULL\n");
+        return NULL;
+    }
+
+    TRACE_BEGIN("bmp24_toBmp8");
+    t_bmp8 *gray = bmp8_allocate(img->width, img->height);
+    if (gray == NULL) return NULL;
+
+    unsigned int stride = bmp8_rowSize(gray);
+
+    // Les rangées d'une image 8 bits sont stockées comme dans le fichier (de bas en haut)
     for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            // Calculer la valeur moyenne des 3 canaux de couleur
-            unsigned char moyenne = (img->data[y][x].red + img->data[y][x].green + img->data[y][x].blue) / 3;
-
-            // Affecter cette valeur moyenne à chaque canal
-            img->data[y][x].red = moyenne;
-            img->data[y][x].green = moyenne;
-            img->data[y][x].blue = moyenne;
+        color_rgbToLuma(img->data[y], gray->data + (size_t) (img->height - 1 - y) * stride, img->width);
+    }
+
+    TRACE_END(img->width, img->height, (size_t) img->width * img->height * sizeof(t_pixel) + gray->dataSize);
+    return gray;
+}
+
+/**
+ * Charge un fichier BMP 24 bits directement sous forme d'image BMP 8 bits en niveaux de gris
+ *
+ * @param filename Nom du fichier à charger
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_loadImageAsBmp8(const char *filename) {
+    char path[512];
+    strcpy(path, "../images/");
+    strcat(path, filename);
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir le fichier %s\n", filename);
+        return NULL;
+    }
+
+    t_bmp_header header;
+    t_bmp_info header_info;
+    uint32_t masks[4];
+    int topDown;
+    if (bmp24_readHeaders(file, filename, &header, &header_info, masks, &topDown) != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    t_bmp8 *gray = bmp8_allocate(header_info.width, header_info.height);
+    // Rangée du fichier (complétée à un multiple de 4 octets) et rangée convertie en pixels
+    uint32_t fileRowSize = bmp24_rowSize(header_info.width, header_info.bits);
+    uint8_t *row = scratch_alloc(fileRowSize);
+    t_pixel *pixels = scratch_alloc((size_t) header_info.width * sizeof(t_pixel));
+    if (gray == NULL || row == NULL || pixels == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour la conversion\n");
+        bmp8_free(gray);
+        scratch_free(pixels);
+        scratch_free(row);
+        fclose(file);
+        return NULL;
+    }
+
+    // L'image 8 bits est de bas en haut comme la plupart des fichiers : rangées inversées si topDown
+    unsigned int stride = bmp8_rowSize(gray);
+    fseek(file, header.offset, SEEK_SET);
+    for (int i = 0; i < header_info.height; i++) {
+        int y = topDown ? header_info.height - 1 - i : i;
+        if (fread(row, 1, fileRowSize, file) != fileRowSize) {
+            fprintf(stderr, "Erreur: Lecture des pixels de %s incomplète\n", filename);
+            bmp8_free(gray);
+            scratch_free(pixels);
+            scratch_free(row);
+            fclose(file);
+            return NULL;
         }
+        bmp24_decodeRow(row, pixels, header_info.width, header_info.bits, header_info.compression, masks);
+        color_rgbToLuma(pixels, gray->data + (size_t) y * stride, header_info.width);
     }
+
+    scratch_free(pixels);
+    scratch_free(row);
+    fclose(file);
+    return gray;
 }
 
 /**
@@ -352,36 +824,51 @@ void bmp24_grayscale(t_bmp24 *img) {
  * @param value Valeur de luminosité à ajouter (-255 à 255)
  */
 void bmp24_brightness(t_bmp24 *img, int value) {
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
+    if (img == NULL || img->data == NULL) return;
+    view24_brightness(bmp24_view(img, 0, 0, img->width, img->height), value);
+}
+
+/**
+ * Modifie la luminosité des pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ * @param value Valeur de luminosité à ajouter (-255 à 255)
+ */
+void view24_brightness(t_view24 view, int value) {
+    if (view.data == NULL) return;
+    TRACE_BEGIN("view24_brightness");
+    for (int y = 0; y < view.height; y++) {
+        t_pixel *row = view.data + (size_t) y * view.stride;
+        for (int x = 0; x < view.width; x++) {
             // Ajuster le canal rouge
-            int new_red = img->data[y][x].red + value;
+            int new_red = row[x].red + value;
             if (new_red > 255) {
                 new_red = 255;
             } else if (new_red < 0) {
                 new_red = 0;
             }
-            img->data[y][x].red = (uint8_t)new_red;
+            row[x].red = (uint8_t)new_red;
 
             // Ajuster le canal vert
-            int new_green = img->data[y][x].green + value;
+            int new_green = row[x].green + value;
             if (new_green > 255) {
                 new_green = 255;
             } else if (new_green < 0) {
                 new_green = 0;
             }
-            img->data[y][x].green = (uint8_t)new_green;
+            row[x].green = (uint8_t)new_green;
 
             // Ajuster le canal bleu
-            int new_blue = img->data[y][x].blue + value;
+            int new_blue = row[x].blue + value;
             if (new_blue > 255) {
                 new_blue = 255;
             } else if (new_blue < 0) {
                 new_blue = 0;
             }
-            img->data[y][x].blue = (uint8_t)new_blue;
+            row[x].blue = (uint8_t)new_blue;
         }
     }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height * sizeof(t_pixel));
 }
 
 /**
@@ -430,54 +917,290 @@ t_pixel bmp24_convolution(t_bmp24 *img, int x, int y, float **kernel, int kernel
     result.red = (sumRed > 255) ? 255 : ((sumRed < 0) ? 0 : (uint8_t)sumRed);
     result.green = (sumGreen > 255) ? 255 : ((sumGreen < 0) ? 0 : (uint8_t)sumGreen);
     result.blue = (sumBlue > 255) ? 255 : ((sumBlue < 0) ? 0 : (uint8_t)sumBlue);
+    result.alpha = img->data[y][x].alpha;
 
     return result;
 }
 
 /**
- * Applique un flou rectangulaire à une image BMP 24 bits
+ * Crée une vue sur un rectangle d'une image BMP 24 bits, sans copie des pixels
+ *
+ * @param img L'image
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view24: La vue, ou une vue vide (data NULL) si le rectangle sort de l'image
+ */
+t_view24 bmp24_view(t_bmp24 *img, int x, int y, int width, int height) {
+    t_view24 view = {NULL, 0, 0, 0};
+    if (img == NULL || img->data == NULL || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > img->width || y + height > img->height) {
+        fprintf(stderr, "Erreur: Rectangle hors de l'image\n");
+        return view;
+    }
+
+    // Les rangées sont contiguës (voir bmp24_allocateDataPixels)
+    view.data = img->data[y] + x;
+    view.width = width;
+    view.height = height;
+    view.stride = img->width;
+    return view;
+}
+
+/**
+ * Crée une vue sur un rectangle d'une autre vue
+ *
+ * @param view La vue parente
+ * @param x Colonne du coin supérieur gauche dans la vue parente
+ * @param y Rangée du coin supérieur gauche dans la vue parente (0 = haut)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view24: La vue, ou une vue vide (data NULL) si le rectangle sort de la vue parente
+ */
+t_view24 view24_sub(t_view24 view, int x, int y, int width, int height) {
+    t_view24 sub = {NULL, 0, 0, 0};
+    if (view.data == NULL || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > view.width || y + height > view.height) {
+        fprintf(stderr, "Erreur: Rectangle hors de la vue\n");
+        return sub;
+    }
+
+    sub.data = view.data + (size_t) y * view.stride + x;
+    sub.width = width;
+    sub.height = height;
+    sub.stride = view.stride;
+    return sub;
+}
+
+/**
+ * Copie un rectangle d'une image BMP 24 bits dans une nouvelle image prête à être sauvegardée
+ *
+ * @param img L'image source
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_bmp24*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_crop(t_bmp24 *img, int x, int y, int width, int height) {
+    t_view24 view = bmp24_view(img, x, y, width, height);
+    if (view.data == NULL) return NULL;
+    TRACE_BEGIN("bmp24_crop");
+
+    t_bmp24 *crop = bmp24_allocate(width, height, img->colorDepth);
+    if (crop == NULL) return NULL;
+
+    for (int row = 0; row < height; row++) {
+        memcpy(crop->data[row], view.data + (size_t) row * view.stride, width * sizeof(t_pixel));
+    }
+
+    // En-têtes de la source, dimensions et tailles mises à jour
+    uint32_t rowSize = bmp24_rowSize(width, img->colorDepth);
+    memcpy(crop->masks, img->masks, sizeof(crop->masks));
+    crop->topDown = img->topDown;
+    crop->header = img->header;
+    crop->header_info = img->header_info;
+    crop->header_info.width = width;
+    crop->header_info.height = height;
+    crop->header_info.imagesize = rowSize * height;
+    crop->header.size = crop->header.offset + crop->header_info.imagesize;
+
+    TRACE_END(width, height, 2 * (size_t) width * height * sizeof(t_pixel));
+    return crop;
+}
+
+/**
+ * Limite une somme de convolution à l'intervalle [0, 255]
+ *
+ * @param sum La somme pondérée calculée pour un canal
+ * @return uint8_t: La valeur du canal
+ */
+static uint8_t bmp24_clampSum(float sum) {
+    return (sum > 255) ? 255 : ((sum < 0) ? 0 : (uint8_t) sum);
+}
+
+/**
+ * Calcule la convolution d'un pixel du bord en passant par les tables d'indices
+ *
+ * @param src Les pixels source, rangées contiguës
+ * @param width La largeur d'une rangée en pixels
+ * @param xMap Table des colonnes (indice x + j, décalé de n), -1 si hors image
+ * @param yMap Table des rangées (indice y + i, décalé de n), -1 si hors image
+ * @param x Colonne du pixel
+ * @param y Rangée du pixel
+ * @param k Le noyau aplati (kernelSize * kernelSize)
+ * @param kernelSize La taille du noyau
+ * @param constant La couleur utilisée pour les voisins hors de l'image
+ * @return t_pixel: Nouvelle valeur du pixel après convolution
+ */
+static t_pixel bmp24_convolveBorder(const t_pixel *src, int width, const int *xMap, const int *yMap, int x, int y,
+                                    const float *k, int kernelSize, t_pixel constant) {
+    float sumRed = 0.0f, sumGreen = 0.0f, sumBlue = 0.0f;
+
+    for (int i = 0; i < kernelSize; i++) {
+        int sy = yMap[y + i];
+        for (int j = 0; j < kernelSize; j++) {
+            int sx = xMap[x + j];
+            const t_pixel *p = (sy < 0 || sx < 0) ? &constant : &src[(size_t) sy * width + sx];
+            float w = k[i * kernelSize + j];
+            sumRed += p->red * w;
+            sumGreen += p->green * w;
+            sumBlue += p->blue * w;
+        }
+    }
+
+    t_pixel result;
+    result.red = bmp24_clampSum(sumRed);
+    result.green = bmp24_clampSum(sumGreen);
+    result.blue = bmp24_clampSum(sumBlue);
+    result.alpha = src[(size_t) y * width + x].alpha; // Alpha du pixel d'origine
+    return result;
+}
+
+/**
+ * Applique un noyau de convolution à toute une image BMP 24 bits avec une politique de bord explicite
+ *
+ * L'image est découpée en une zone intérieure, où tout le voisinage est dans l'image
+ * et où la convolution se fait sans aucun test, et une bordure de kernelSize / 2 pixels
+ * traitée à part via des tables d'indices précalculées.
  *
  * @param img Pointeur vers l'image à modifier
+ * @param kernel Noyau de convolution à appliquer
+ * @param kernelSize Taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La couleur utilisée hors de l'image avec BORDER_CONSTANT
  */
-void bmp24_boxBlur(t_bmp24 *img) {
-    // Noyau de flou uniforme 3x3
-    int kernelSize = 3;
-    float **kernel = malloc(kernelSize * sizeof(float *));
+void bmp24_applyFilter(t_bmp24 *img, float **kernel, int kernelSize, t_border_mode border, t_pixel constant) {
+    if (img == NULL || img->data == NULL || kernel == NULL) {
+        fprintf(stderr, "Erreur: Impossible d'appliquer un filtre à une image NULL\n");
+        return;
+    }
+
+    view24_applyFilter(bmp24_view(img, 0, 0, img->width, img->height), kernel, kernelSize, border, constant);
+}
+
+/**
+ * Applique un noyau de convolution à une vue d'image 24 bits avec une politique de bord explicite
+ * (les bords de la vue sont traités comme les bords d'une image)
+ *
+ * La vue est découpée en une zone intérieure, où tout le voisinage est dans la vue
+ * et où la convolution se fait sans aucun test, et une bordure de kernelSize / 2 pixels
+ * traitée à part via des tables d'indices précalculées.
+ *
+ * @param view La vue à modifier
+ * @param kernel Noyau de convolution à appliquer
+ * @param kernelSize Taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La couleur utilisée hors de la vue avec BORDER_CONSTANT
+ */
+void view24_applyFilter(t_view24 view, float **kernel, int kernelSize, t_border_mode border, t_pixel constant) {
+    if (view.data == NULL || kernel == NULL || view.width <= 0 || view.height <= 0) {
+        return;
+    }
+    TRACE_BEGIN("view24_applyFilter");
+
+    int width = view.width;
+    int height = view.height;
+    int n = kernelSize / 2;
+
+    // Créer une copie des pixels (un seul bloc temporaire) pour éviter de modifier l'original pendant le traitement
+    t_pixel *copy = scratch_alloc((size_t) width * height * sizeof(t_pixel));
+    float *k = scratch_alloc(kernelSize * kernelSize * sizeof(float));
+    int *xMap = scratch_alloc((width + 2 * n) * sizeof(int));
+    int *yMap = scratch_alloc((height + 2 * n) * sizeof(int));
+    if (copy == NULL || k == NULL || xMap == NULL || yMap == NULL) {
+        fprintf(stderr, "Erreur: Échec de l'allocation mémoire pour la copie temporaire\n");
+        scratch_free(yMap);
+        scratch_free(xMap);
+        scratch_free(k);
+        scratch_free(copy);
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        memcpy(copy + (size_t) y * width, view.data + (size_t) y * view.stride, width * sizeof(t_pixel));
+    }
+
     for (int i = 0; i < kernelSize; i++) {
-        kernel[i] = malloc(kernelSize * sizeof(float));
         for (int j = 0; j < kernelSize; j++) {
-            kernel[i][j] = 1.0f / 9.0f;  // Chaque élément vaut 1/9
+            k[i * kernelSize + j] = kernel[i][j];
         }
     }
 
-    // Créer une copie de l'image pour éviter de modifier l'original pendant le traitement
-    t_bmp24 *imgCopy = malloc(sizeof(t_bmp24));
-    imgCopy->width = img->width;
-    imgCopy->height = img->height;
-    imgCopy->data = malloc(img->height * sizeof(t_pixel *));
-    for (int y = 0; y < img->height; y++) {
-        imgCopy->data[y] = malloc(img->width * sizeof(t_pixel));
-        memcpy(imgCopy->data[y], img->data[y], img->width * sizeof(t_pixel));
+    // Zone intérieure : le voisinage complet est dans l'image, aucun test de bord
+    for (int y = n; y < height - n; y++) {
+        t_pixel *dst = view.data + (size_t) y * view.stride;
+        for (int x = n; x < width - n; x++) {
+            float sumRed = 0.0f, sumGreen = 0.0f, sumBlue = 0.0f;
+
+            for (int i = 0; i < kernelSize; i++) {
+                const t_pixel *row = copy + (size_t) (y - n + i) * width + (x - n);
+                const float *kRow = k + i * kernelSize;
+                for (int j = 0; j < kernelSize; j++) {
+                    sumRed += row[j].red * kRow[j];
+                    sumGreen += row[j].green * kRow[j];
+                    sumBlue += row[j].blue * kRow[j];
+                }
+            }
+
+            dst[x].red = bmp24_clampSum(sumRed);
+            dst[x].green = bmp24_clampSum(sumGreen);
+            dst[x].blue = bmp24_clampSum(sumBlue);
+        }
     }
 
-    // Appliquer le filtre à chaque pixel
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x] = bmp24_convolution(imgCopy, x, y, kernel, kernelSize);
+    // Bordure : seulement les n premières/dernières rangées et colonnes
+    if (border != BORDER_SKIP) {
+        for (int t = 0; t < width + 2 * n; t++) xMap[t] = bmp_borderIndex(t - n, width, border);
+        for (int t = 0; t < height + 2 * n; t++) yMap[t] = bmp_borderIndex(t - n, height, border);
+
+        for (int y = 0; y < height; y++) {
+            t_pixel *dst = view.data + (size_t) y * view.stride;
+            int fullRow = (y < n || y >= height - n);
+            int leftEnd = fullRow ? width : (n < width ? n : width);
+            int rightStart = fullRow ? width : (width - n > leftEnd ? width - n : leftEnd);
+
+            for (int x = 0; x < leftEnd; x++) {
+                dst[x] = bmp24_convolveBorder(copy, width, xMap, yMap, x, y, k, kernelSize, constant);
+            }
+            for (int x = rightStart; x < width; x++) {
+                dst[x] = bmp24_convolveBorder(copy, width, xMap, yMap, x, y, k, kernelSize, constant);
+            }
         }
     }
 
     // Libérer la mémoire
-    for (int y = 0; y < imgCopy->height; y++) {
-        free(imgCopy->data[y]);
-    }
-    free(imgCopy->data);
-    free(imgCopy);
+    scratch_free(yMap);
+    scratch_free(xMap);
+    scratch_free(k);
+    scratch_free(copy);
+    TRACE_END(width, height, 2 * (size_t) width * height * sizeof(t_pixel));
+}
 
+/**
+ * Applique un flou rectangulaire à une image BMP 24 bits
+ *
+ * @param img Pointeur vers l'image à modifier
+ */
+void bmp24_boxBlur(t_bmp24 *img) {
+    if (img == NULL) return;
+
+    // Noyau de flou uniforme 3x3
+    int kernelSize = 3;
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
     for (int i = 0; i < kernelSize; i++) {
-        free(kernel[i]);
+        for (int j = 0; j < kernelSize; j++) {
+            kernel[i][j] = 1.0f / 9.0f;  // Chaque élément vaut 1/9
+        }
     }
-    free(kernel);
+
+    // Appliquer le filtre à chaque pixel (bords répétés)
+    t_pixel black = {0, 0, 0, 255};
+    TRACE_BEGIN("bmp24_boxBlur");
+    bmp24_applyFilter(img, kernel, kernelSize, BORDER_CLAMP, black);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
 }
 
 /**
@@ -486,12 +1209,12 @@ void bmp24_boxBlur(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_gaussianBlur(t_bmp24 *img) {
+    if (img == NULL) return;
+
     // Noyau gaussien 5x5
     int kernelSize = 5;
-    float **kernel = malloc(kernelSize * sizeof(float *));
-    for (int i = 0; i < kernelSize; i++) {
-        kernel[i] = malloc(kernelSize * sizeof(float));
-    }
+    float rows[5][5];
+    float *kernel[5] = {rows[0], rows[1], rows[2], rows[3], rows[4]};
 
     // Coefficients du noyau gaussien 5x5
     kernel[0][0] = 1/256.0f; kernel[0][1] = 4/256.0f;  kernel[0][2] = 6/256.0f;  kernel[0][3] = 4/256.0f;  kernel[0][4] = 1/256.0f;
@@ -500,34 +1223,11 @@ void bmp24_gaussianBlur(t_bmp24 *img) {
     kernel[3][0] = 4/256.0f; kernel[3][1] = 16/256.0f; kernel[3][2] = 24/256.0f; kernel[3][3] = 16/256.0f; kernel[3][4] = 4/256.0f;
     kernel[4][0] = 1/256.0f; kernel[4][1] = 4/256.0f;  kernel[4][2] = 6/256.0f;  kernel[4][3] = 4/256.0f;  kernel[4][4] = 1/256.0f;
 
-    // Créer une copie de l'image
-    t_bmp24 *imgCopy = malloc(sizeof(t_bmp24));
-    imgCopy->width = img->width;
-    imgCopy->height = img->height;
-    imgCopy->data = malloc(img->height * sizeof(t_pixel *));
-    for (int y = 0; y < img->height; y++) {
-        imgCopy->data[y] = malloc(img->width * sizeof(t_pixel));
-        memcpy(imgCopy->data[y], img->data[y], img->width * sizeof(t_pixel));
-    }
-
-    // Appliquer le filtre à chaque pixel
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x] = bmp24_convolution(imgCopy, x, y, kernel, kernelSize);
-        }
-    }
-
-    // Libérer la mémoire
-    for (int y = 0; y < imgCopy->height; y++) {
-        free(imgCopy->data[y]);
-    }
-    free(imgCopy->data);
-    free(imgCopy);
-
-    for (int i = 0; i < kernelSize; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    // Appliquer le filtre à chaque pixel (bords répétés)
+    t_pixel black = {0, 0, 0, 255};
+    TRACE_BEGIN("bmp24_gaussianBlur");
+    bmp24_applyFilter(img, kernel, kernelSize, BORDER_CLAMP, black);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
 }
 
 /**
@@ -536,46 +1236,23 @@ void bmp24_gaussianBlur(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_outline(t_bmp24 *img) {
+    if (img == NULL) return;
+
     // Noyau de détection de contours (Laplacien)
     int kernelSize = 3;
-    float **kernel = malloc(kernelSize * sizeof(float *));
-    for (int i = 0; i < kernelSize; i++) {
-        kernel[i] = malloc(kernelSize * sizeof(float));
-    }
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Coefficients du noyau de détection de contours
     kernel[0][0] = -1.0f; kernel[0][1] = -1.0f; kernel[0][2] = -1.0f;
     kernel[1][0] = -1.0f; kernel[1][1] = 8.0f;  kernel[1][2] = -1.0f;
     kernel[2][0] = -1.0f; kernel[2][1] = -1.0f; kernel[2][2] = -1.0f;
 
-    // Créer une copie de l'image
-    t_bmp24 *imgCopy = malloc(sizeof(t_bmp24));
-    imgCopy->width = img->width;
-    imgCopy->height = img->height;
-    imgCopy->data = malloc(img->height * sizeof(t_pixel *));
-    for (int y = 0; y < img->height; y++) {
-        imgCopy->data[y] = malloc(img->width * sizeof(t_pixel));
-        memcpy(imgCopy->data[y], img->data[y], img->width * sizeof(t_pixel));
-    }
-
-    // Appliquer le filtre à chaque pixel
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x] = bmp24_convolution(imgCopy, x, y, kernel, kernelSize);
-        }
-    }
-
-    // Libérer la mémoire
-    for (int y = 0; y < imgCopy->height; y++) {
-        free(imgCopy->data[y]);
-    }
-    free(imgCopy->data);
-    free(imgCopy);
-
-    for (int i = 0; i < kernelSize; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    // Appliquer le filtre à chaque pixel (bords répétés)
+    t_pixel black = {0, 0, 0, 255};
+    TRACE_BEGIN("bmp24_outline");
+    bmp24_applyFilter(img, kernel, kernelSize, BORDER_CLAMP, black);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
 }
 
 /**
@@ -584,46 +1261,23 @@ void bmp24_outline(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_emboss(t_bmp24 *img) {
+    if (img == NULL) return;
+
     // Noyau de relief
     int kernelSize = 3;
-    float **kernel = malloc(kernelSize * sizeof(float *));
-    for (int i = 0; i < kernelSize; i++) {
-        kernel[i] = malloc(kernelSize * sizeof(float));
-    }
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Coefficients du noyau de relief
     kernel[0][0] = -2.0f; kernel[0][1] = -1.0f; kernel[0][2] = 0.0f;
     kernel[1][0] = -1.0f; kernel[1][1] = 1.0f;  kernel[1][2] = 1.0f;
     kernel[2][0] = 0.0f;  kernel[2][1] = 1.0f;  kernel[2][2] = 2.0f;
 
-    // Créer une copie de l'image
-    t_bmp24 *imgCopy = malloc(sizeof(t_bmp24));
-    imgCopy->width = img->width;
-    imgCopy->height = img->height;
-    imgCopy->data = malloc(img->height * sizeof(t_pixel *));
-    for (int y = 0; y < img->height; y++) {
-        imgCopy->data[y] = malloc(img->width * sizeof(t_pixel));
-        memcpy(imgCopy->data[y], img->data[y], img->width * sizeof(t_pixel));
-    }
-
-    // Appliquer le filtre à chaque pixel
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x] = bmp24_convolution(imgCopy, x, y, kernel, kernelSize);
-        }
-    }
-
-    // Libérer la mémoire
-    for (int y = 0; y < imgCopy->height; y++) {
-        free(imgCopy->data[y]);
-    }
-    free(imgCopy->data);
-    free(imgCopy);
-
-    for (int i = 0; i < kernelSize; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    // Appliquer le filtre à chaque pixel (bords répétés)
+    t_pixel black = {0, 0, 0, 255};
+    TRACE_BEGIN("bmp24_emboss");
+    bmp24_applyFilter(img, kernel, kernelSize, BORDER_CLAMP, black);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
 }
 
 /**
@@ -632,44 +1286,21 @@ void bmp24_emboss(t_bmp24 *img) {
  * @param img Pointeur vers l'image à modifier
  */
 void bmp24_sharpen(t_bmp24 *img) {
+    if (img == NULL) return;
+
     // Noyau de netteté
     int kernelSize = 3;
-    float **kernel = malloc(kernelSize * sizeof(float *));
-    for (int i = 0; i < kernelSize; i++) {
-        kernel[i] = malloc(kernelSize * sizeof(float));
-    }
+    float rows[3][3];
+    float *kernel[3] = {rows[0], rows[1], rows[2]};
 
     // Coefficients du noyau d'amélioration de la netteté
     kernel[0][0] = 0.0f;  kernel[0][1] = -1.0f; kernel[0][2] = 0.0f;
     kernel[1][0] = -1.0f; kernel[1][1] = 5.0f;  kernel[1][2] = -1.0f;
     kernel[2][0] = 0.0f;  kernel[2][1] = -1.0f; kernel[2][2] = 0.0f;
 
-    // Créer une copie de l'image
-    t_bmp24 *imgCopy = malloc(sizeof(t_bmp24));
-    imgCopy->width = img->width;
-    imgCopy->height = img->height;
-    imgCopy->data = malloc(img->height * sizeof(t_pixel *));
-    for (int y = 0; y < img->height; y++) {
-        imgCopy->data[y] = malloc(img->width * sizeof(t_pixel));
-        memcpy(imgCopy->data[y], img->data[y], img->width * sizeof(t_pixel));
-    }
-
-    // Appliquer le filtre à chaque pixel
-    for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            img->data[y][x] = bmp24_convolution(imgCopy, x, y, kernel, kernelSize);
-        }
-    }
-
-    // Libérer la mémoire
-    for (int y = 0; y < imgCopy->height; y++) {
-        free(imgCopy->data[y]);
-    }
-    free(imgCopy->data);
-    free(imgCopy);
-
-    for (int i = 0; i < kernelSize; i++) {
-        free(kernel[i]);
-    }
-    free(kernel);
+    // Appliquer le filtre à chaque pixel (bords répétés)
+    t_pixel black = {0, 0, 0, 255};
+    TRACE_BEGIN("bmp24_sharpen");
+    bmp24_applyFilter(img, kernel, kernelSize, BORDER_CLAMP, black);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
 }
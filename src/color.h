@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "bmp8.h"
+#include "utils/utils.h"
+
 // Constantes pour les offsets des champs de l'en-tête BMP
 #define BITMAP_MAGIC 0x00 // offset 0
 #define BITMAP_SIZE 0x02 // offset 2
@@ -22,11 +25,22 @@
 
 // Constantes pour les valeurs de profondeur de couleur
 #define DEFAULT_DEPTH 0x18 // 24
+#define DEPTH_32 0x20 // 32
+
+// Compression des images 24 / 32 bits (champ compression de l'en-tête)
+#define BMP_BI_RGB 0 // Pixels BGR (24 bits) ou BGRX (32 bits)
+#define BMP_BI_BITFIELDS 3 // 32 bits : position des canaux donnée par des masques
+#define INFO_V4_SIZE 0x6C // 108 octets, en-tête avec masques (dont alpha) et espace colorimétrique
 
+// Ordre des champs identique à celui d'un fichier BMP 32 bits (bleu, vert, rouge, alpha).
+// Quatre octets par pixel quelle que soit la profondeur du fichier : les pixels sont alignés
+// et une instruction SIMD de 16 octets en traite 4. Les traitements ne modifient que les
+// trois canaux de couleur ; alpha vaut 255 pour une image lue en 24 bits.
 typedef struct {
-    uint8_t red;
-    uint8_t green;
     uint8_t blue;
+    uint8_t green;
+    uint8_t red;
+    uint8_t alpha;
 } t_pixel;
 
 // Force l'alignement sur 1 octet
@@ -60,12 +74,26 @@ typedef struct {
     t_bmp_info header_info;
     int width;
     int height;
-    int colorDepth;
+    int colorDepth; // Profondeur du fichier : 24 ou 32 bits
+    uint32_t masks[4]; // Masques rouge, vert, bleu et alpha du fichier (BMP_BI_BITFIELDS)
+    int topDown; // 1 si les rangées du fichier vont de haut en bas (hauteur négative dans l'en-tête)
     t_pixel **data;
 } t_bmp24;
 
+// Vue sur un rectangle d'une image 24 bits, sans copie des pixels (rangées de haut en bas)
+typedef struct {
+    t_pixel *data; // Pixel en haut à gauche du rectangle
+    int width; // Largeur du rectangle
+    int height; // Hauteur du rectangle
+    int stride; // Pixels entre deux rangées consécutives
+} t_view24;
+
+// Fournit l'image destination d'un chargement (width x height), ou NULL en cas d'erreur
+typedef t_bmp24 *(*t_bmp24_allocator)(void *context, int width, int height);
+
 /**
  * Alloue de la mémoire pour les pixels d'une image BMP 24 bits
+ * Les rangées sont contiguës dans un seul bloc (pixels[0]), pixels[y] pointe sur la rangée y
  *
  * @param width Largeur de l'image en pixels
  * @param height Hauteur de l'image en pixels
@@ -81,16 +109,33 @@ t_pixel **bmp24_allocateDataPixels(int width, int height);
  */
 void bmp24_freeDataPixels(t_pixel **pixels, int height);
 
+/**
+ * Calcule la taille d'une rangée de pixels dans le fichier (complétée à un multiple de 4 octets)
+ *
+ * @param width Largeur de l'image en pixels
+ * @param colorDepth Profondeur de couleur en bits (24 ou 32)
+ * @return uint32_t: Le nombre d'octets d'une rangée du fichier
+ */
+uint32_t bmp24_rowSize(int width, int colorDepth);
+
 /**
  * Alloue de la mémoire pour une structure d'image BMP 24 bits
  *
  * @param width Largeur de l'image en pixels
  * @param height Hauteur de l'image en pixels
- * @param colorDepth Profondeur de couleur en bits (devrait être 24)
+ * @param colorDepth Profondeur de couleur du fichier en bits (24 ou 32)
  * @return t_bmp24*: Pointeur vers l'image créée ou NULL en cas d'erreur
  */
 t_bmp24 *bmp24_allocate(int width, int height, int colorDepth);
 
+/**
+ * Remet une image BMP 24 bits dans l'état d'une image neuve, sans toucher aux pixels (image recyclée) :
+ * en-têtes vierges, masques standard, 24 bits de bas en haut
+ *
+ * @param img L'image à réinitialiser
+ */
+void bmp24_reset(t_bmp24 *img);
+
 /**
  * Libère la mémoire allouée pour une image BMP 24 bits
  *
@@ -109,12 +154,14 @@ void bmp24_free(t_bmp24 *img);
 void bmp24_readPixelValue(t_bmp24 *image, int x, int y, FILE *file);
 
 /**
- * Lit toutes les données de pixels d'une image BMP 24 bits
+ * Lit toutes les données de pixels d'une image BMP 24 bits, une rangée à la fois
+ * (format du fichier donné par colorDepth, header_info.compression et masks)
  *
  * @param image Pointeur vers l'image BMP 24 bits
  * @param file Fichier BMP ouvert
+ * @return int: 0 en cas de succès, -1 si le fichier est incomplet
  */
-void bmp24_readPixelData(t_bmp24 *image, FILE *file);
+int bmp24_readPixelData(t_bmp24 *image, FILE *file);
 
 /**
  * Écrit la valeur d'un pixel à une position spécifique
@@ -127,23 +174,43 @@ void bmp24_readPixelData(t_bmp24 *image, FILE *file);
 void bmp24_writePixelValue(t_bmp24 *image, int x, int y, FILE *file);
 
 /**
- * Écrit toutes les données de pixels d'une image BMP 24 bits
+ * Écrit toutes les données de pixels d'une image BMP 24 bits, une rangée à la fois
+ * (24 ou 32 bits selon colorDepth, rangées complétées à 4 octets)
  *
  * @param image Pointeur vers l'image BMP 24 bits
  * @param file Fichier BMP ouvert
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'écriture
  */
-void bmp24_writePixelData(t_bmp24 *image, FILE *file);
+int bmp24_writePixelData(t_bmp24 *image, FILE *file);
 
 /**
- * Charge une image BMP 24 bits à partir d'un fichier
+ * Charge une image BMP 24 bits ou 32 bits (BMP_BI_RGB ou BMP_BI_BITFIELDS) à partir d'un fichier
+ * Une hauteur négative (rangées de haut en bas) est acceptée et mémorisée dans topDown ;
+ * un fichier 32 bits de haut en bas est lu en une seule fois directement dans les pixels.
+ * L'alpha du fichier n'est conservé qu'en BMP_BI_BITFIELDS avec un masque alpha : en BMP_BI_RGB
+ * le quatrième octet est réservé, et les pixels sont lus opaques (255) comme en 24 bits
  *
  * @param filename Nom du fichier à charger
  * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
  */
 t_bmp24 * bmp24_loadImage(const char * filename);
 
+/**
+ * Charge une image BMP 24 bits en obtenant l'image destination auprès d'un allocateur
+ * (par exemple un pool d'images réutilisées)
+ *
+ * @param filename Nom du fichier à charger
+ * @param allocate Fournit une image de la taille lue dans l'en-tête (NULL pour bmp24_allocate)
+ * @param context Paramètre transmis à l'allocateur
+ * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_loadImageWith(const char *filename, t_bmp24_allocator allocate, void *context);
+
 /**
  * Sauvegarde une image BMP 24 bits dans un fichier
+ * Le format suit img->colorDepth : 24 bits, ou 32 bits (BMP_BI_RGB, ou BMP_BI_BITFIELDS avec
+ * un en-tête V4 qui déclare le canal alpha si img->header_info.compression vaut BMP_BI_BITFIELDS)
+ * Si img->topDown vaut 1, les rangées sont écrites de haut en bas (hauteur négative), sans inversion
  *
  * @param img Pointeur vers l'image à sauvegarder
  * @param filename Nom du fichier de destination
@@ -171,6 +238,83 @@ void bmp24_negative(t_bmp24 * img);
  */
 void bmp24_grayscale(t_bmp24 * img);
 
+/**
+ * Convertit une image BMP 24 bits en véritable image BMP 8 bits en niveaux de gris
+ * (luminance BT.601, palette de gris, rangées complétées à 4 octets)
+ *
+ * @param img Pointeur vers l'image à convertir (non modifiée)
+ * @return t_bmp8*: Nouvelle image 8 bits ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_toBmp8(const t_bmp24 *img);
+
+/**
+ * Charge un fichier BMP 24 ou 32 bits directement sous forme d'image BMP 8 bits en niveaux de gris,
+ * rangée par rangée, sans jamais construire l'image 24 bits en mémoire
+ *
+ * @param filename Nom du fichier à charger
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_loadImageAsBmp8(const char *filename);
+
+// Vues (régions d'intérêt) et recadrage
+/**
+ * Crée une vue sur un rectangle d'une image BMP 24 bits, sans copie des pixels
+ *
+ * @param img L'image
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view24: La vue, ou une vue vide (data NULL) si le rectangle sort de l'image
+ */
+t_view24 bmp24_view(t_bmp24 *img, int x, int y, int width, int height);
+
+/**
+ * Crée une vue sur un rectangle d'une autre vue
+ *
+ * @param view La vue parente
+ * @param x Colonne du coin supérieur gauche dans la vue parente
+ * @param y Rangée du coin supérieur gauche dans la vue parente (0 = haut)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_view24: La vue, ou une vue vide (data NULL) si le rectangle sort de la vue parente
+ */
+t_view24 view24_sub(t_view24 view, int x, int y, int width, int height);
+
+/**
+ * Copie un rectangle d'une image BMP 24 bits dans une nouvelle image prête à être sauvegardée
+ *
+ * @param img L'image source
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ * @return t_bmp24*: La nouvelle image ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_crop(t_bmp24 *img, int x, int y, int width, int height);
+
+/**
+ * Applique un effet négatif aux pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ */
+void view24_negative(t_view24 view);
+
+/**
+ * Convertit en niveaux de gris les pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ */
+void view24_grayscale(t_view24 view);
+
+/**
+ * Modifie la luminosité des pixels d'une vue d'image 24 bits
+ *
+ * @param view La vue à modifier
+ * @param value Valeur de luminosité à ajouter (-255 à 255)
+ */
+void view24_brightness(t_view24 view, int value);
+
 /**
  * Modifie la luminosité d'une image BMP 24 bits
  *
@@ -191,6 +335,29 @@ void bmp24_brightness(t_bmp24 * img, int value);
  */
 t_pixel bmp24_convolution(t_bmp24 *img, int x, int y, float **kernel, int kernelSize);
 
+/**
+ * Applique un noyau de convolution à toute une image BMP 24 bits avec une politique de bord explicite
+ *
+ * @param img Pointeur vers l'image à modifier
+ * @param kernel Noyau de convolution à appliquer
+ * @param kernelSize Taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La couleur utilisée hors de l'image avec BORDER_CONSTANT
+ */
+void bmp24_applyFilter(t_bmp24 *img, float **kernel, int kernelSize, t_border_mode border, t_pixel constant);
+
+/**
+ * Applique un noyau de convolution à une vue d'image 24 bits avec une politique de bord explicite
+ * (les bords de la vue sont traités comme les bords d'une image)
+ *
+ * @param view La vue à modifier
+ * @param kernel Noyau de convolution à appliquer
+ * @param kernelSize Taille du noyau (doit être impair)
+ * @param border La politique de bord (BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP)
+ * @param constant La couleur utilisée hors de la vue avec BORDER_CONSTANT
+ */
+void view24_applyFilter(t_view24 view, float **kernel, int kernelSize, t_border_mode border, t_pixel constant);
+
 /**
  * Applique un flou rectangulaire à une image BMP 24 bits
  *
@@ -0,0 +1,394 @@
+#include "colorspace.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define COLORSPACE_SIMD 1
+#endif
+
+// Coefficients YCbCr (RGB -> YCbCr) en Q14
+#define COLOR_CB_R (-2765) // -0.168736
+#define COLOR_CB_G (-5427) // -0.331264
+#define COLOR_CB_B 8192 // 0.5
+#define COLOR_CR_R 8192 // 0.5
+#define COLOR_CR_G (-6860) // -0.418688
+#define COLOR_CR_B (-1332) // -0.081312
+
+// Coefficients YUV (RGB -> YUV) en Q14
+#define COLOR_U_R (-2411) // -0.14713
+#define COLOR_U_G (-4733) // -0.28886
+#define COLOR_U_B 7143 // 0.436
+#define COLOR_V_R 10076 // 0.615
+#define COLOR_V_G (-8438) // -0.51499
+#define COLOR_V_B (-1639) // -0.10001
+
+// Coefficients des conversions inverses en Q12 (pour tenir sur 16 bits signés)
+#define COLOR_Q12_SHIFT 12
+#define COLOR_Q12_ONE 4096
+#define COLOR_YCC_R_CR 5743 // 1.402
+#define COLOR_YCC_G_CB (-1410) // -0.344136
+#define COLOR_YCC_G_CR (-2925) // -0.714136
+#define COLOR_YCC_B_CB 7258 // 1.772
+#define COLOR_YUV_R_V 4669 // 1.13983
+#define COLOR_YUV_G_U (-1616) // -0.39465
+#define COLOR_YUV_G_V (-2378) // -0.58060
+#define COLOR_YUV_B_U 8324 // 2.03211
+
+// Les décalages à droite de valeurs négatives sont arithmétiques (arrondi vers -inf)
+// sur tous les compilateurs visés, comme l'instruction SIMD correspondante
+#define COLOR_ROUND(sum, shift) (((sum) + (1 << ((shift) - 1))) >> (shift))
+
+/**
+ * Limite une valeur à l'intervalle [0, 255]
+ *
+ * @param value La valeur à limiter
+ * @return uint8_t: La valeur limitée
+ */
+static inline uint8_t color_clamp(int32_t value) {
+    return (uint8_t) (value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+#ifdef COLORSPACE_SIMD
+
+// Transposition 4 x 4 octets : 4 pixels BGRA deviennent 4 octets B, 4 octets G, 4 octets R, 4 octets A
+// (la même permutation refait l'entrelacement)
+static const int8_t COLOR_TRANSPOSE[16] = {0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15};
+
+/**
+ * Charge 16 pixels et les sépare en plans de 16 octets
+ *
+ * Les pixels font 4 octets : chaque registre chargé contient 4 pixels entiers, et la séparation
+ * se réduit à une transposition d'octets par registre suivie de dépliages de mots de 32 et 64 bits.
+ *
+ * @param src Les 16 pixels (64 octets)
+ * @param b Reçoit le plan bleu
+ * @param g Reçoit le plan vert
+ * @param r Reçoit le plan rouge
+ */
+static inline void color_load16(const t_pixel *src, __m128i *b, __m128i *g, __m128i *r) {
+    const __m128i *p = (const __m128i *) src;
+    __m128i transpose = _mm_loadu_si128((const __m128i *) COLOR_TRANSPOSE);
+    __m128i t0 = _mm_shuffle_epi8(_mm_loadu_si128(p), transpose);
+    __m128i t1 = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), transpose);
+    __m128i t2 = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), transpose);
+    __m128i t3 = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), transpose);
+
+    // [B0 G0 R0 A0] [B1 G1 R1 A1] ... -> [B0 B1 G0 G1] [R0 R1 A0 A1] ...
+    __m128i bg01 = _mm_unpacklo_epi32(t0, t1);
+    __m128i ra01 = _mm_unpackhi_epi32(t0, t1);
+    __m128i bg23 = _mm_unpacklo_epi32(t2, t3);
+    __m128i ra23 = _mm_unpackhi_epi32(t2, t3);
+
+    *b = _mm_unpacklo_epi64(bg01, bg23);
+    *g = _mm_unpackhi_epi64(bg01, bg23);
+    *r = _mm_unpacklo_epi64(ra01, ra23);
+}
+
+/**
+ * Entrelace trois plans de 16 octets et écrit 16 pixels, en conservant l'alpha de la destination
+ *
+ * @param dst Les 16 pixels destination (64 octets)
+ * @param b Le plan bleu
+ * @param g Le plan vert
+ * @param r Le plan rouge
+ */
+static inline void color_store16(t_pixel *dst, __m128i b, __m128i g, __m128i r) {
+    __m128i *p = (__m128i *) dst;
+    __m128i transpose = _mm_loadu_si128((const __m128i *) COLOR_TRANSPOSE);
+    __m128i alphaMask = _mm_set1_epi32((int) 0xFF000000u);
+    __m128i zero = _mm_setzero_si128();
+
+    // Plan alpha nul, puis transposition inverse de celle de color_load16
+    __m128i bg01 = _mm_unpacklo_epi32(b, g);
+    __m128i bg23 = _mm_unpackhi_epi32(b, g);
+    __m128i ra01 = _mm_unpacklo_epi32(r, zero);
+    __m128i ra23 = _mm_unpackhi_epi32(r, zero);
+    __m128i t[4] = {
+        _mm_unpacklo_epi64(bg01, ra01), _mm_unpackhi_epi64(bg01, ra01),
+        _mm_unpacklo_epi64(bg23, ra23), _mm_unpackhi_epi64(bg23, ra23)
+    };
+
+    for (int k = 0; k < 4; k++) {
+        __m128i alpha = _mm_and_si128(_mm_loadu_si128(p + k), alphaMask);
+        _mm_storeu_si128(p + k, _mm_or_si128(_mm_shuffle_epi8(t[k], transpose), alpha));
+    }
+}
+
+/**
+ * Calcule sur 8 voies 16 bits : (c0 * x0 + c1 * x1 + c2 * x2 + bias) >> shift, en 32 bits exacts
+ *
+ * @param x0 Première entrée
+ * @param x1 Deuxième entrée
+ * @param x2 Troisième entrée
+ * @param c0 Coefficient de x0
+ * @param c1 Coefficient de x1
+ * @param c2 Coefficient de x2
+ * @param bias Constante ajoutée avant le décalage
+ * @param shift Décalage arithmétique final
+ * @return __m128i: 8 résultats sur 16 bits signés (saturés)
+ */
+static inline __m128i color_dot3(__m128i x0, __m128i x1, __m128i x2, int16_t c0, int16_t c1, int16_t c2,
+                                 int32_t bias, int shift) {
+    __m128i c01 = _mm_set_epi16(c1, c0, c1, c0, c1, c0, c1, c0);
+    __m128i c2z = _mm_set_epi16(0, c2, 0, c2, 0, c2, 0, c2);
+    __m128i zero = _mm_setzero_si128();
+    __m128i vbias = _mm_set1_epi32(bias);
+    __m128i count = _mm_cvtsi32_si128(shift);
+
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), c01),
+                               _mm_madd_epi16(_mm_unpacklo_epi16(x2, zero), c2z));
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(x0, x1), c01),
+                               _mm_madd_epi16(_mm_unpackhi_epi16(x2, zero), c2z));
+
+    lo = _mm_sra_epi32(_mm_add_epi32(lo, vbias), count);
+    hi = _mm_sra_epi32(_mm_add_epi32(hi, vbias), count);
+    return _mm_packs_epi32(lo, hi);
+}
+
+#endif
+
+/**
+ * Calcule la luminance BT.601 d'une suite de pixels
+ *
+ * @param src Les pixels source
+ * @param luma Reçoit la luminance de chaque pixel
+ * @param count Nombre de pixels
+ */
+void color_rgbToLuma(const t_pixel *src, uint8_t *luma, int count) {
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i b, g, r;
+        color_load16(src + i, &b, &g, &r);
+
+        __m128i lo = color_dot3(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(b, zero),
+                                COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B, 1 << (COLOR_Q14_SHIFT - 1), COLOR_Q14_SHIFT);
+        __m128i hi = color_dot3(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(b, zero),
+                                COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B, 1 << (COLOR_Q14_SHIFT - 1), COLOR_Q14_SHIFT);
+        _mm_storeu_si128((__m128i *) (luma + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; i < count; i++) {
+        luma[i] = color_pixelLuma(&src[i]);
+    }
+}
+
+/**
+ * Calcule la luminance BT.601 tronquée d'une suite de pixels, comme la conversion flottante d'origine
+ *
+ * En SIMD, la somme S = 299 R + 587 G + 114 B (au plus 255000) est d'abord divisée par 8 pour tenir
+ * sur 16 bits, puis floor(T / 125) = (T * 33555) >> 22 pour tout T <= 31875 (vérifié exhaustivement).
+ *
+ * @param src Les pixels source
+ * @param luma Reçoit la luminance tronquée de chaque pixel
+ * @param count Nombre de pixels
+ */
+void color_rgbToLumaFloor(const t_pixel *src, uint8_t *luma, int count) {
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    __m128i zero = _mm_setzero_si128();
+    __m128i magic = _mm_set1_epi16((int16_t) 33555);
+    for (; i + 16 <= count; i += 16) {
+        __m128i b, g, r;
+        color_load16(src + i, &b, &g, &r);
+
+        __m128i lo = color_dot3(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(b, zero),
+                                COLOR_LUMA_FLOOR_R, COLOR_LUMA_FLOOR_G, COLOR_LUMA_FLOOR_B, 0, 3);
+        __m128i hi = color_dot3(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(b, zero),
+                                COLOR_LUMA_FLOOR_R, COLOR_LUMA_FLOOR_G, COLOR_LUMA_FLOOR_B, 0, 3);
+        lo = _mm_srli_epi16(_mm_mulhi_epu16(lo, magic), 6);
+        hi = _mm_srli_epi16(_mm_mulhi_epu16(hi, magic), 6);
+        _mm_storeu_si128((__m128i *) (luma + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; i < count; i++) {
+        luma[i] = color_pixelLumaFloor(&src[i]);
+    }
+}
+
+/**
+ * Convertit une suite de pixels RGB en YCbCr pleine échelle (JPEG/BT.601)
+ *
+ * @param src Les pixels source
+ * @param y Reçoit la luminance (0-255)
+ * @param cb Reçoit la chrominance bleue, centrée sur 128
+ * @param cr Reçoit la chrominance rouge, centrée sur 128
+ * @param count Nombre de pixels
+ */
+void color_rgbToYCbCr(const t_pixel *src, uint8_t *y, uint8_t *cb, uint8_t *cr, int count) {
+    const int32_t chromaBias = (128 << COLOR_Q14_SHIFT) + (1 << (COLOR_Q14_SHIFT - 1));
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i b, g, r;
+        color_load16(src + i, &b, &g, &r);
+        __m128i rl = _mm_unpacklo_epi8(r, zero), rh = _mm_unpackhi_epi8(r, zero);
+        __m128i gl = _mm_unpacklo_epi8(g, zero), gh = _mm_unpackhi_epi8(g, zero);
+        __m128i bl = _mm_unpacklo_epi8(b, zero), bh = _mm_unpackhi_epi8(b, zero);
+
+        __m128i yl = color_dot3(rl, gl, bl, COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B,
+                                1 << (COLOR_Q14_SHIFT - 1), COLOR_Q14_SHIFT);
+        __m128i yh = color_dot3(rh, gh, bh, COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B,
+                                1 << (COLOR_Q14_SHIFT - 1), COLOR_Q14_SHIFT);
+        __m128i cbl = color_dot3(rl, gl, bl, COLOR_CB_R, COLOR_CB_G, COLOR_CB_B, chromaBias, COLOR_Q14_SHIFT);
+        __m128i cbh = color_dot3(rh, gh, bh, COLOR_CB_R, COLOR_CB_G, COLOR_CB_B, chromaBias, COLOR_Q14_SHIFT);
+        __m128i crl = color_dot3(rl, gl, bl, COLOR_CR_R, COLOR_CR_G, COLOR_CR_B, chromaBias, COLOR_Q14_SHIFT);
+        __m128i crh = color_dot3(rh, gh, bh, COLOR_CR_R, COLOR_CR_G, COLOR_CR_B, chromaBias, COLOR_Q14_SHIFT);
+
+        _mm_storeu_si128((__m128i *) (y + i), _mm_packus_epi16(yl, yh));
+        _mm_storeu_si128((__m128i *) (cb + i), _mm_packus_epi16(cbl, cbh));
+        _mm_storeu_si128((__m128i *) (cr + i), _mm_packus_epi16(crl, crh));
+    }
+#endif
+
+    for (; i < count; i++) {
+        int32_t r = src[i].red, g = src[i].green, b = src[i].blue;
+        y[i] = color_pixelLuma(&src[i]);
+        cb[i] = color_clamp((COLOR_CB_R * r + COLOR_CB_G * g + COLOR_CB_B * b + chromaBias) >> COLOR_Q14_SHIFT);
+        cr[i] = color_clamp((COLOR_CR_R * r + COLOR_CR_G * g + COLOR_CR_B * b + chromaBias) >> COLOR_Q14_SHIFT);
+    }
+}
+
+/**
+ * Convertit une suite de pixels YCbCr pleine échelle en RGB (valeurs limitées à [0, 255])
+ *
+ * @param y La luminance
+ * @param cb La chrominance bleue, centrée sur 128
+ * @param cr La chrominance rouge, centrée sur 128
+ * @param dst Reçoit les pixels RGB
+ * @param count Nombre de pixels
+ */
+void color_yCbCrToRgb(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, t_pixel *dst, int count) {
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    const int32_t half = 1 << (COLOR_Q12_SHIFT - 1);
+    __m128i zero = _mm_setzero_si128();
+    __m128i offset = _mm_set1_epi16(128);
+    for (; i + 16 <= count; i += 16) {
+        __m128i vy = _mm_loadu_si128((const __m128i *) (y + i));
+        __m128i vcb = _mm_loadu_si128((const __m128i *) (cb + i));
+        __m128i vcr = _mm_loadu_si128((const __m128i *) (cr + i));
+        __m128i yl = _mm_unpacklo_epi8(vy, zero), yh = _mm_unpackhi_epi8(vy, zero);
+        __m128i cbl = _mm_sub_epi16(_mm_unpacklo_epi8(vcb, zero), offset);
+        __m128i cbh = _mm_sub_epi16(_mm_unpackhi_epi8(vcb, zero), offset);
+        __m128i crl = _mm_sub_epi16(_mm_unpacklo_epi8(vcr, zero), offset);
+        __m128i crh = _mm_sub_epi16(_mm_unpackhi_epi8(vcr, zero), offset);
+
+        __m128i r = _mm_packus_epi16(
+            color_dot3(yl, crl, zero, COLOR_Q12_ONE, COLOR_YCC_R_CR, 0, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, crh, zero, COLOR_Q12_ONE, COLOR_YCC_R_CR, 0, half, COLOR_Q12_SHIFT));
+        __m128i g = _mm_packus_epi16(
+            color_dot3(yl, cbl, crl, COLOR_Q12_ONE, COLOR_YCC_G_CB, COLOR_YCC_G_CR, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, cbh, crh, COLOR_Q12_ONE, COLOR_YCC_G_CB, COLOR_YCC_G_CR, half, COLOR_Q12_SHIFT));
+        __m128i b = _mm_packus_epi16(
+            color_dot3(yl, cbl, zero, COLOR_Q12_ONE, COLOR_YCC_B_CB, 0, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, cbh, zero, COLOR_Q12_ONE, COLOR_YCC_B_CB, 0, half, COLOR_Q12_SHIFT));
+        color_store16(dst + i, b, g, r);
+    }
+#endif
+
+    for (; i < count; i++) {
+        int32_t yy = y[i] * COLOR_Q12_ONE;
+        int32_t u = cb[i] - 128;
+        int32_t v = cr[i] - 128;
+        dst[i].red = color_clamp(COLOR_ROUND(yy + COLOR_YCC_R_CR * v, COLOR_Q12_SHIFT));
+        dst[i].green = color_clamp(COLOR_ROUND(yy + COLOR_YCC_G_CB * u + COLOR_YCC_G_CR * v, COLOR_Q12_SHIFT));
+        dst[i].blue = color_clamp(COLOR_ROUND(yy + COLOR_YCC_B_CB * u, COLOR_Q12_SHIFT));
+    }
+}
+
+/**
+ * Convertit une suite de pixels RGB en YUV (BT.601 analogique)
+ *
+ * @param src Les pixels source
+ * @param y Reçoit la luminance (0-255)
+ * @param u Reçoit la chrominance U (environ -112 à 112)
+ * @param v Reçoit la chrominance V (environ -157 à 157)
+ * @param count Nombre de pixels
+ */
+void color_rgbToYuv(const t_pixel *src, uint8_t *y, int16_t *u, int16_t *v, int count) {
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    const int32_t half = 1 << (COLOR_Q14_SHIFT - 1);
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i b, g, r;
+        color_load16(src + i, &b, &g, &r);
+        __m128i rl = _mm_unpacklo_epi8(r, zero), rh = _mm_unpackhi_epi8(r, zero);
+        __m128i gl = _mm_unpacklo_epi8(g, zero), gh = _mm_unpackhi_epi8(g, zero);
+        __m128i bl = _mm_unpacklo_epi8(b, zero), bh = _mm_unpackhi_epi8(b, zero);
+
+        __m128i yl = color_dot3(rl, gl, bl, COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B, half, COLOR_Q14_SHIFT);
+        __m128i yh = color_dot3(rh, gh, bh, COLOR_LUMA_R, COLOR_LUMA_G, COLOR_LUMA_B, half, COLOR_Q14_SHIFT);
+        _mm_storeu_si128((__m128i *) (y + i), _mm_packus_epi16(yl, yh));
+
+        _mm_storeu_si128((__m128i *) (u + i),
+                         color_dot3(rl, gl, bl, COLOR_U_R, COLOR_U_G, COLOR_U_B, half, COLOR_Q14_SHIFT));
+        _mm_storeu_si128((__m128i *) (u + i + 8),
+                         color_dot3(rh, gh, bh, COLOR_U_R, COLOR_U_G, COLOR_U_B, half, COLOR_Q14_SHIFT));
+        _mm_storeu_si128((__m128i *) (v + i),
+                         color_dot3(rl, gl, bl, COLOR_V_R, COLOR_V_G, COLOR_V_B, half, COLOR_Q14_SHIFT));
+        _mm_storeu_si128((__m128i *) (v + i + 8),
+                         color_dot3(rh, gh, bh, COLOR_V_R, COLOR_V_G, COLOR_V_B, half, COLOR_Q14_SHIFT));
+    }
+#endif
+
+    for (; i < count; i++) {
+        int32_t r = src[i].red, g = src[i].green, b = src[i].blue;
+        y[i] = color_pixelLuma(&src[i]);
+        u[i] = (int16_t) COLOR_ROUND(COLOR_U_R * r + COLOR_U_G * g + COLOR_U_B * b, COLOR_Q14_SHIFT);
+        v[i] = (int16_t) COLOR_ROUND(COLOR_V_R * r + COLOR_V_G * g + COLOR_V_B * b, COLOR_Q14_SHIFT);
+    }
+}
+
+/**
+ * Convertit une suite de pixels YUV (BT.601 analogique) en RGB (valeurs limitées à [0, 255])
+ *
+ * @param y La luminance
+ * @param u La chrominance U
+ * @param v La chrominance V
+ * @param dst Reçoit les pixels RGB
+ * @param count Nombre de pixels
+ */
+void color_yuvToRgb(const uint8_t *y, const int16_t *u, const int16_t *v, t_pixel *dst, int count) {
+    int i = 0;
+
+#ifdef COLORSPACE_SIMD
+    const int32_t half = 1 << (COLOR_Q12_SHIFT - 1);
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i vy = _mm_loadu_si128((const __m128i *) (y + i));
+        __m128i yl = _mm_unpacklo_epi8(vy, zero), yh = _mm_unpackhi_epi8(vy, zero);
+        __m128i ul = _mm_loadu_si128((const __m128i *) (u + i));
+        __m128i uh = _mm_loadu_si128((const __m128i *) (u + i + 8));
+        __m128i vl = _mm_loadu_si128((const __m128i *) (v + i));
+        __m128i vh = _mm_loadu_si128((const __m128i *) (v + i + 8));
+
+        __m128i r = _mm_packus_epi16(
+            color_dot3(yl, vl, zero, COLOR_Q12_ONE, COLOR_YUV_R_V, 0, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, vh, zero, COLOR_Q12_ONE, COLOR_YUV_R_V, 0, half, COLOR_Q12_SHIFT));
+        __m128i g = _mm_packus_epi16(
+            color_dot3(yl, ul, vl, COLOR_Q12_ONE, COLOR_YUV_G_U, COLOR_YUV_G_V, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, uh, vh, COLOR_Q12_ONE, COLOR_YUV_G_U, COLOR_YUV_G_V, half, COLOR_Q12_SHIFT));
+        __m128i b = _mm_packus_epi16(
+            color_dot3(yl, ul, zero, COLOR_Q12_ONE, COLOR_YUV_B_U, 0, half, COLOR_Q12_SHIFT),
+            color_dot3(yh, uh, zero, COLOR_Q12_ONE, COLOR_YUV_B_U, 0, half, COLOR_Q12_SHIFT));
+        color_store16(dst + i, b, g, r);
+    }
+#endif
+
+    for (; i < count; i++) {
+        int32_t yy = y[i] * COLOR_Q12_ONE;
+        dst[i].red = color_clamp(COLOR_ROUND(yy + COLOR_YUV_R_V * v[i], COLOR_Q12_SHIFT));
+        dst[i].green = color_clamp(COLOR_ROUND(yy + COLOR_YUV_G_U * u[i] + COLOR_YUV_G_V * v[i], COLOR_Q12_SHIFT));
+        dst[i].blue = color_clamp(COLOR_ROUND(yy + COLOR_YUV_B_U * u[i], COLOR_Q12_SHIFT));
+    }
+}
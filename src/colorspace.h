@@ -0,0 +1,113 @@
+#ifndef COLORSPACE_H
+#define COLORSPACE_H
+
+#include <stdint.h>
+
+#include "color.h"
+
+// Conversions d'espaces colorimétriques en virgule fixe sur 16 bits.
+// Toutes les fonctions donnent exactement le même résultat avec ou sans SIMD
+// (mêmes coefficients entiers, même arrondi), quelle que soit la plateforme.
+
+// Coefficients de luminance BT.601 en virgule fixe Q14 (somme = 16384)
+#define COLOR_LUMA_R 4899 // 0.299
+#define COLOR_LUMA_G 9617 // 0.587
+#define COLOR_LUMA_B 1868 // 0.114
+#define COLOR_Q14_SHIFT 14
+
+/**
+ * Calcule la luminance BT.601 d'un pixel en virgule fixe
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance arrondie au plus proche
+ */
+static inline uint8_t color_pixelLuma(const t_pixel *p) {
+    return (uint8_t) ((COLOR_LUMA_R * p->red + COLOR_LUMA_G * p->green + COLOR_LUMA_B * p->blue +
+                       (1 << (COLOR_Q14_SHIFT - 1))) >> COLOR_Q14_SHIFT);
+}
+
+// Coefficients de luminance BT.601 en millièmes, pour la luminance tronquée
+#define COLOR_LUMA_FLOOR_R 299
+#define COLOR_LUMA_FLOOR_G 587
+#define COLOR_LUMA_FLOOR_B 114
+
+/**
+ * Calcule la luminance BT.601 tronquée d'un pixel
+ *
+ * (299 R + 587 G + 114 B) / 1000 vaut exactement (unsigned char) (0.299 * R + 0.587 * G + 0.114 * B)
+ * calculé en flottant, pour les 2^24 couleurs.
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance tronquée
+ */
+static inline uint8_t color_pixelLumaFloor(const t_pixel *p) {
+    return (uint8_t) ((COLOR_LUMA_FLOOR_R * p->red + COLOR_LUMA_FLOOR_G * p->green +
+                       COLOR_LUMA_FLOOR_B * p->blue) / 1000);
+}
+
+/**
+ * Calcule la luminance BT.601 d'une suite de pixels
+ *
+ * @param src Les pixels source
+ * @param luma Reçoit la luminance de chaque pixel
+ * @param count Nombre de pixels
+ */
+void color_rgbToLuma(const t_pixel *src, uint8_t *luma, int count);
+
+/**
+ * Calcule la luminance BT.601 tronquée d'une suite de pixels, comme la conversion flottante d'origine
+ *
+ * Sert de clé d'histogramme aux égalisations 24 bits : l'arrondi de color_rgbToLuma fait passer
+ * des pixels dans la case voisine, ce qui change toute la table sur un histogramme étroit.
+ *
+ * @param src Les pixels source
+ * @param luma Reçoit la luminance tronquée de chaque pixel
+ * @param count Nombre de pixels
+ */
+void color_rgbToLumaFloor(const t_pixel *src, uint8_t *luma, int count);
+
+/**
+ * Convertit une suite de pixels RGB en YCbCr pleine échelle (JPEG/BT.601)
+ *
+ * @param src Les pixels source
+ * @param y Reçoit la luminance (0-255)
+ * @param cb Reçoit la chrominance bleue, centrée sur 128
+ * @param cr Reçoit la chrominance rouge, centrée sur 128
+ * @param count Nombre de pixels
+ */
+void color_rgbToYCbCr(const t_pixel *src, uint8_t *y, uint8_t *cb, uint8_t *cr, int count);
+
+/**
+ * Convertit une suite de pixels YCbCr pleine échelle en RGB (valeurs limitées à [0, 255])
+ *
+ * @param y La luminance
+ * @param cb La chrominance bleue, centrée sur 128
+ * @param cr La chrominance rouge, centrée sur 128
+ * @param dst Reçoit les pixels RGB
+ * @param count Nombre de pixels
+ */
+void color_yCbCrToRgb(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, t_pixel *dst, int count);
+
+/**
+ * Convertit une suite de pixels RGB en YUV (BT.601 analogique)
+ *
+ * @param src Les pixels source
+ * @param y Reçoit la luminance (0-255)
+ * @param u Reçoit la chrominance U (environ -112 à 112)
+ * @param v Reçoit la chrominance V (environ -157 à 157)
+ * @param count Nombre de pixels
+ */
+void color_rgbToYuv(const t_pixel *src, uint8_t *y, int16_t *u, int16_t *v, int count);
+
+/**
+ * Convertit une suite de pixels YUV (BT.601 analogique) en RGB (valeurs limitées à [0, 255])
+ *
+ * @param y La luminance
+ * @param u La chrominance U
+ * @param v La chrominance V
+ * @param dst Reçoit les pixels RGB
+ * @param count Nombre de pixels
+ */
+void color_yuvToRgb(const uint8_t *y, const int16_t *u, const int16_t *v, t_pixel *dst, int count);
+
+#endif //COLORSPACE_H
@@ -1,8 +1,120 @@
 #include "histogram.h"
+#include "arena.h"
+#include "colorspace.h"
+#include "trace.h"
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define HISTOGRAM_SIMD 1
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Nombre de sous-histogrammes entrelacés par thread : des pixels consécutifs de même
+// valeur incrémentent des compteurs différents, ce qui évite d'attendre la fin de
+// l'écriture précédente (dépendance mémoire) sur les images peu variées
+#define HISTOGRAM_LANES 4
+
+// En dessous de ce nombre de pixels, le coût de création des threads domine
+#define HISTOGRAM_PARALLEL_MIN_PIXELS (1 << 18)
+
+// Alignement des tranches de tampon de chaque thread (une ligne de cache, pas de faux partage)
+#define HISTOGRAM_SLICE_ALIGN 64
+
+/**
+ * Renvoie le nombre maximal de threads d'une prochaine région parallèle
+ *
+ * @return int: Le nombre de threads (1 sans OpenMP)
+ */
+static inline int histogram_threadCount(void) {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Renvoie le numéro du thread appelant dans la région parallèle en cours
+ *
+ * @return int: Le numéro du thread (0 hors région ou sans OpenMP)
+ */
+static inline int histogram_threadIndex(void) {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Arrondit la taille du tampon d'un thread à l'alignement des tranches
+ *
+ * @param size Taille en octets
+ * @return size_t: La taille d'une tranche
+ */
+static inline size_t histogram_sliceSize(size_t size) {
+    return (size + HISTOGRAM_SLICE_ALIGN - 1) & ~(size_t) (HISTOGRAM_SLICE_ALIGN - 1);
+}
+
+/**
+ * Ajoute une suite d'octets aux sous-histogrammes entrelacés (octet x compté dans la voie x % 4)
+ *
+ * @param values Les octets
+ * @param count Nombre d'octets
+ * @param lanes Les sous-histogrammes à compléter
+ */
+static inline void histogram_accumulateLanes(const unsigned char *values, int count,
+                                             unsigned int lanes[HISTOGRAM_LANES][256]) {
+    int x = 0;
+    for (; x + HISTOGRAM_LANES <= count; x += HISTOGRAM_LANES) {
+        lanes[0][values[x]]++;
+        lanes[1][values[x + 1]]++;
+        lanes[2][values[x + 2]]++;
+        lanes[3][values[x + 3]]++;
+    }
+    for (; x < count; x++) {
+        lanes[0][values[x]]++;
+    }
+}
+
+/**
+ * Ajoute les canaux d'une suite de pixels aux sous-histogrammes entrelacés R, G et B
+ *
+ * @param pixels Les pixels
+ * @param count Nombre de pixels
+ * @param red Sous-histogrammes du canal rouge
+ * @param green Sous-histogrammes du canal vert
+ * @param blue Sous-histogrammes du canal bleu
+ */
+static inline void histogram_accumulateChannels(const t_pixel *pixels, int count,
+                                                unsigned int red[HISTOGRAM_LANES][256],
+                                                unsigned int green[HISTOGRAM_LANES][256],
+                                                unsigned int blue[HISTOGRAM_LANES][256]) {
+    int x = 0;
+    for (; x + HISTOGRAM_LANES <= count; x += HISTOGRAM_LANES) {
+        for (int lane = 0; lane < HISTOGRAM_LANES; lane++) {
+            red[lane][pixels[x + lane].red]++;
+            green[lane][pixels[x + lane].green]++;
+            blue[lane][pixels[x + lane].blue]++;
+        }
+    }
+    for (; x < count; x++) {
+        red[0][pixels[x].red]++;
+        green[0][pixels[x].green]++;
+        blue[0][pixels[x].blue]++;
+    }
+}
+
 /**
  * Calcule l'histogramme d'une image BMP 8 bits
  *
@@ -17,18 +129,279 @@ unsigned int *bmp8_computeHistogram(t_bmp8 *img) {
     // Allocation de mémoire pour l'histogramme
     // L'histogramme aura 256 compartiments (0-255)
     unsigned int *histogram = (unsigned int *) malloc(256 * sizeof(unsigned int));
+    if (histogram == NULL) {
+        return NULL;
+    }
+
+    bmp8_computeHistogramInto(img, histogram);
+
+    return histogram;
+}
+
+/**
+ * Calcule l'histogramme d'une image BMP 8 bits dans un tableau fourni par l'appelant
+ *
+ * @param img L'image dont on souhaite calculer l'histogramme
+ * @param histogram Tableau de 256 éléments qui reçoit les occurrences de chaque niveau de gris
+ */
+void bmp8_computeHistogramInto(t_bmp8 *img, unsigned int histogram[256]) {
+    if (img != NULL && img->histogramCache && img->histogramValid) {
+        memcpy(histogram, img->histogram, 256 * sizeof(unsigned int));
+        return;
+    }
+
+    memset(histogram, 0, 256 * sizeof(unsigned int));
+    if (img == NULL || img->data == NULL) {
+        return;
+    }
+
+    // Vue construite directement : la palette en attente est prise en compte ci-dessous
+    t_view8 whole = {img->data, (int) img->width, (int) img->height, (int) bmp8_rowSize(img), NULL};
+    view8_computeHistogram(whole, histogram);
+
+    // Mode palette : histogramme des indices ramené aux intensités réelles, sans toucher aux pixels
+    if (img->lutPending) {
+        unsigned int indices[256];
+        memcpy(indices, histogram, sizeof(indices));
+        memset(histogram, 0, 256 * sizeof(unsigned int));
+        for (int i = 0; i < 256; i++) {
+            histogram[img->lut[i]] += indices[i];
+        }
+    }
+
+    if (img->histogramCache) {
+        memcpy(img->histogram, histogram, 256 * sizeof(unsigned int));
+        img->histogramValid = 1;
+        img->cdfValid = 0;
+    }
+}
+
+/**
+ * Calcule l'histogramme des pixels d'une vue d'image 8 bits
+ *
+ * @param view La vue
+ * @param histogram Tableau de 256 éléments qui reçoit les occurrences de chaque niveau de gris
+ */
+void view8_computeHistogram(t_view8 view, unsigned int histogram[256]) {
+    memset(histogram, 0, 256 * sizeof(unsigned int));
+    if (view.data == NULL) {
+        return;
+    }
+
+    TRACE_BEGIN("view8_computeHistogram");
+#pragma omp parallel if ((long) view.width * view.height >= HISTOGRAM_PARALLEL_MIN_PIXELS)
+    {
+        unsigned int lanes[HISTOGRAM_LANES][256];
+        memset(lanes, 0, sizeof(lanes));
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < view.height; y++) {
+            histogram_accumulateLanes(view.data + (ptrdiff_t) y * view.stride, view.width, lanes);
+        }
+
+        // Fusion des sous-histogrammes du thread dans le résultat
+#pragma omp critical(histogram_merge)
+        for (int i = 0; i < 256; i++) {
+            histogram[i] += lanes[0][i] + lanes[1][i] + lanes[2][i] + lanes[3][i];
+        }
+    }
+    TRACE_END(view.width, view.height, (size_t) view.width * view.height);
+}
+
+/**
+ * Calcule les occurrences cumulées des niveaux de gris d'une image BMP 8 bits
+ *
+ * @param img L'image concernée
+ * @param cdf Tableau de 256 éléments : cdf[v] = nombre de pixels de niveau <= v
+ */
+void bmp8_computeCumulative(t_bmp8 *img, unsigned int cdf[256]) {
+    if (img != NULL && img->histogramCache && img->histogramValid && img->cdfValid) {
+        memcpy(cdf, img->cdf, 256 * sizeof(unsigned int));
+        return;
+    }
+
+    unsigned int hist[256];
+    bmp8_computeHistogramInto(img, hist);
+
+    cdf[0] = hist[0];
+    for (int i = 1; i < 256; i++) {
+        cdf[i] = cdf[i - 1] + hist[i];
+    }
 
-    // Initialisation de l'histogramme à zéro
+    if (img != NULL && img->histogramCache && img->histogramValid) {
+        memcpy(img->cdf, cdf, 256 * sizeof(unsigned int));
+        img->cdfValid = 1;
+    }
+}
+
+/**
+ * Calcule le seuil de binarisation automatique par la méthode d'Otsu
+ *
+ * @param img L'image concernée
+ * @return int: Le seuil (0-255) à passer à bmp8_threshold, ou -1 en cas d'erreur
+ */
+int bmp8_otsuThreshold(t_bmp8 *img) {
+    if (img == NULL || img->data == NULL) {
+        return -1;
+    }
+
+    unsigned int hist[256];
+    bmp8_computeHistogramInto(img, hist);
+
+    double total = 0.0, sumAll = 0.0;
     for (int i = 0; i < 256; i++) {
-        histogram[i] = 0;
+        total += hist[i];
+        sumAll += (double) i * hist[i];
+    }
+    if (total == 0.0) {
+        return -1;
     }
 
-    // Associer les valeurs des pixels à l'histogramme
-    for (unsigned int i = 0; i < img->dataSize; i++) {
-        histogram[img->data[i]]++;
+    // Classe « fond » : niveaux < t, classe « objet » : niveaux >= t
+    double weightBack = 0.0, sumBack = 0.0, bestVariance = -1.0;
+    int best = 0;
+    for (int t = 1; t < 256; t++) {
+        weightBack += hist[t - 1];
+        sumBack += (double) (t - 1) * hist[t - 1];
+
+        double weightFore = total - weightBack;
+        if (weightBack == 0.0 || weightFore == 0.0) continue;
+
+        double meanBack = sumBack / weightBack;
+        double meanFore = (sumAll - sumBack) / weightFore;
+        double variance = weightBack * weightFore * (meanBack - meanFore) * (meanBack - meanFore);
+        if (variance > bestVariance) {
+            bestVariance = variance;
+            best = t;
+        }
     }
 
-    return histogram;
+    return best;
+}
+
+/**
+ * Calcule un percentile des niveaux de gris d'une image BMP 8 bits
+ *
+ * @param img L'image concernée
+ * @param percent Le percentile souhaité (0 à 100)
+ * @return int: Le plus petit niveau v tel qu'au moins percent % des pixels sont <= v, ou -1 en cas d'erreur
+ */
+int bmp8_percentile(t_bmp8 *img, double percent) {
+    if (img == NULL || img->data == NULL || percent < 0.0 || percent > 100.0) {
+        return -1;
+    }
+
+    unsigned int cdf[256];
+    bmp8_computeCumulative(img, cdf);
+    if (cdf[255] == 0) {
+        return -1;
+    }
+
+    double target = percent / 100.0 * cdf[255];
+    for (int v = 0; v < 256; v++) {
+        if (cdf[v] >= target) return v;
+    }
+    return 255;
+}
+
+/**
+ * Calcule en une seule passe les histogrammes d'une image BMP 24 bits
+ *
+ * @param img L'image dont on souhaite calculer les histogrammes
+ * @param histY Histogramme de la luminance Y (BT.601, tronquée comme pour l'égalisation), ou NULL
+ * @param histR Histogramme du canal rouge, ou NULL
+ * @param histG Histogramme du canal vert, ou NULL
+ * @param histB Histogramme du canal bleu, ou NULL
+ */
+void bmp24_computeHistograms(const t_bmp24 *img, unsigned int histY[256], unsigned int histR[256],
+                             unsigned int histG[256], unsigned int histB[256]) {
+    // Les rangées sont contiguës (voir bmp24_allocateDataPixels)
+    t_view24 whole = {NULL, 0, 0, 0};
+    if (img != NULL && img->data != NULL) {
+        whole.data = img->data[0];
+        whole.width = img->width;
+        whole.height = img->height;
+        whole.stride = img->width;
+    }
+    view24_computeHistograms(whole, histY, histR, histG, histB);
+}
+
+/**
+ * Calcule en une seule passe les histogrammes d'une vue d'image 24 bits
+ *
+ * @param view La vue
+ * @param histY Histogramme de la luminance Y (BT.601, tronquée comme pour l'égalisation), ou NULL
+ * @param histR Histogramme du canal rouge, ou NULL
+ * @param histG Histogramme du canal vert, ou NULL
+ * @param histB Histogramme du canal bleu, ou NULL
+ */
+void view24_computeHistograms(t_view24 view, unsigned int histY[256], unsigned int histR[256],
+                              unsigned int histG[256], unsigned int histB[256]) {
+    unsigned int *outputs[4] = {histY, histR, histG, histB};
+    for (int c = 0; c < 4; c++) {
+        if (outputs[c] != NULL) memset(outputs[c], 0, 256 * sizeof(unsigned int));
+    }
+    int wantY = histY != NULL, wantRGB = histR != NULL || histG != NULL || histB != NULL;
+    if (view.data == NULL || (!wantY && !wantRGB)) {
+        return;
+    }
+
+    TRACE_BEGIN("view24_computeHistograms");
+    int width = view.width;
+    int height = view.height;
+
+    // Luminance d'une rangée par thread, calculée en SIMD puis comptée comme une image 8 bits.
+    // Les tranches sont prises d'un seul bloc avant la région parallèle : les threads de travail
+    // n'ont pas d'arène courante, et scratch_alloc y retomberait sur malloc à chaque appel
+    size_t lumaSlice = histogram_sliceSize((size_t) width);
+    uint8_t *lumaRows = wantY ? scratch_alloc(lumaSlice * histogram_threadCount()) : NULL;
+    if (wantY && lumaRows == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les histogrammes\n");
+        TRACE_END(view.width, view.height, 0);
+        return;
+    }
+
+#pragma omp parallel if ((long) width * height >= HISTOGRAM_PARALLEL_MIN_PIXELS)
+    {
+        // [canal][voie][valeur] : canaux Y, R, G, B
+        unsigned int lanes[4][HISTOGRAM_LANES][256];
+        memset(lanes, 0, sizeof(lanes));
+        uint8_t *luma = wantY ? lumaRows + lumaSlice * histogram_threadIndex() : NULL;
+
+        // Boucles séparées selon les histogrammes demandés : aucun test par pixel
+        // (le choix est le même pour tous les threads, chacun rencontre la même boucle partagée)
+        if (!wantRGB) {
+#pragma omp for schedule(static)
+            for (int y = 0; y < height; y++) {
+                color_rgbToLumaFloor(view.data + (size_t) y * view.stride, luma, width);
+                histogram_accumulateLanes(luma, width, lanes[0]);
+            }
+        } else if (!wantY) {
+#pragma omp for schedule(static)
+            for (int y = 0; y < height; y++) {
+                histogram_accumulateChannels(view.data + (size_t) y * view.stride, width,
+                                             lanes[1], lanes[2], lanes[3]);
+            }
+        } else {
+#pragma omp for schedule(static)
+            for (int y = 0; y < height; y++) {
+                const t_pixel *row = view.data + (size_t) y * view.stride;
+                color_rgbToLumaFloor(row, luma, width);
+                histogram_accumulateLanes(luma, width, lanes[0]);
+                histogram_accumulateChannels(row, width, lanes[1], lanes[2], lanes[3]);
+            }
+        }
+
+#pragma omp critical(histogram_merge)
+        for (int c = 0; c < 4; c++) {
+            if (outputs[c] == NULL) continue;
+            for (int i = 0; i < 256; i++) {
+                outputs[c][i] += lanes[c][0][i] + lanes[c][1][i] + lanes[c][2][i] + lanes[c][3][i];
+            }
+        }
+    }
+    scratch_free(lumaRows);
+    TRACE_END(view.width, view.height, (size_t) view.width * view.height * sizeof(t_pixel));
 }
 
 /**
@@ -83,20 +456,42 @@ unsigned int *bmp8_computeCDF(unsigned int *hist) {
  * @param img L'image à égaliser
  */
 void bmp8_equalize(t_bmp8 *img) {
+    if (img == NULL || img->data == NULL) {
+        return;
+    }
+
+    TRACE_BEGIN("bmp8_equalize");
     // Calcul de l'histogramme de l'image
-    unsigned int *hist = bmp8_computeHistogram(img);
-    
+    unsigned int hist[256];
+    bmp8_computeHistogramInto(img, hist);
+
     // Calcul de l'histogramme égalisé
-    unsigned int *hist_eq = bmp8_computeCDF(hist);
+    unsigned char hist_eq[256];
+    histogram_computeEqualizationLut(hist, hist_eq);
+
+    // Application de l'égalisation (à la palette seulement en mode palette)
+    bmp8_applyLut(img, hist_eq);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->dataSize);
+}
 
-    // Application de l'égalisation à chaque pixel de l'image
-    for (int i = 0; i < img->dataSize - 1; i++) {
-        img->data[i] = hist_eq[img->data[i]];
+/**
+ * Égalise l'histogramme d'une vue d'image 8 bits (histogramme de la vue seulement)
+ *
+ * @param view La vue à égaliser
+ */
+void view8_equalize(t_view8 view) {
+    if (view.data == NULL) {
+        return;
     }
-    
-    // Libération de la mémoire
-    free(hist);
-    free(hist_eq);
+
+    TRACE_BEGIN("view8_equalize");
+    unsigned int hist[256];
+    view8_computeHistogram(view, hist);
+
+    unsigned char hist_eq[256];
+    histogram_computeEqualizationLut(hist, hist_eq);
+    view8_applyLut(view, hist_eq);
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height);
 }
 
 /**
@@ -110,43 +505,65 @@ void bmp24_equalize(t_bmp24 *img) {
         return;
     }
 
+    TRACE_BEGIN("bmp24_equalize");
     // Nombre de pixels dans l'image
     unsigned int pixelCount = img->width * img->height;
 
-    // 1. Conversion RGB vers YUV (Y: luminance, U,V: chrominance)
-    float *Y = (float *) malloc(pixelCount * sizeof(float));
-    float *U = (float *) malloc(pixelCount * sizeof(float));
-    float *V = (float *) malloc(pixelCount * sizeof(float));
+    // 1. Conversion RGB vers YUV (Y: luminance, U,V: chrominance) en virgule fixe ; Y est ensuite
+    // remplacée par la luminance tronquée, pour classer chaque pixel dans la même case que la
+    // conversion flottante d'origine (même table d'égalisation)
+    unsigned char *Y = (unsigned char *) scratch_alloc(pixelCount * sizeof(unsigned char));
+    int16_t *U = (int16_t *) scratch_alloc(pixelCount * sizeof(int16_t));
+    int16_t *V = (int16_t *) scratch_alloc(pixelCount * sizeof(int16_t));
 
     if (Y == NULL || U == NULL || V == NULL) {
-        if (Y) free(Y);
-        if (U) free(U);
-        if (V) free(V);
+        if (Y) scratch_free(Y);
+        if (U) scratch_free(U);
+        if (V) scratch_free(V);
         return;
     }
 
-    // RGB -> YUV (formule standard de conversion)
     for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            unsigned int idx = y * img->width + x;
-            unsigned char R = img->data[y][x].red;
-            unsigned char G = img->data[y][x].green;
-            unsigned char B = img->data[y][x].blue;
-
-            Y[idx] = 0.299 * R + 0.587 * G + 0.114 * B;          // Luminance
-            U[idx] = -0.14713 * R - 0.28886 * G + 0.436 * B;     // Chrominance bleue
-            V[idx] = 0.615 * R - 0.51499 * G - 0.10001 * B;      // Chrominance rouge
-        }
+        unsigned int idx = y * img->width;
+        color_rgbToYuv(img->data[y], Y + idx, U + idx, V + idx, img->width);
+        color_rgbToLumaFloor(img->data[y], Y + idx, img->width);
     }
 
     // 2. Calcul de l'histogramme de la composante Y (luminance)
     unsigned int hist[256] = {0};
     for (unsigned int i = 0; i < pixelCount; i++) {
-        unsigned char y = (unsigned char) (Y[i] < 0 ? 0 : (Y[i] > 255 ? 255 : Y[i]));
-        hist[y]++;
+        hist[Y[i]]++;
+    }
+
+    // 3. Calcul de la CDF normalisée (histogramme égalisé)
+    unsigned char hist_eq[256];
+    histogram_computeEqualizationLut(hist, hist_eq);
+
+    // 4. Application de l'égalisation à la composante Y uniquement
+    for (unsigned int i = 0; i < pixelCount; i++) {
+        Y[i] = hist_eq[Y[i]];
+    }
+
+    // 5. Reconversion YUV vers RGB
+    for (int y = 0; y < img->height; y++) {
+        unsigned int idx = y * img->width;
+        color_yuvToRgb(Y + idx, U + idx, V + idx, img->data[y], img->width);
     }
 
-    // 3. Calcul de la CDF (Fonction de Distribution Cumulative)
+    // Libération de la mémoire
+    scratch_free(Y);
+    scratch_free(U);
+    scratch_free(V);
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
+}
+
+/**
+ * Calcule la table de correspondance de l'égalisation d'histogramme (CDF normalisée sur [0, 255])
+ *
+ * @param hist L'histogramme original
+ * @param lut Table de 256 éléments qui reçoit la nouvelle valeur de chaque niveau
+ */
+void histogram_computeEqualizationLut(const unsigned int hist[256], unsigned char lut[256]) {
     unsigned int cdf[256];
     cdf[0] = hist[0];
     for (int i = 1; i < 256; i++) {
@@ -162,49 +579,536 @@ void bmp24_equalize(t_bmp24 *img) {
         }
     }
 
-    // 3. Normalisation de la CDF pour obtenir l'histogramme égalisé
-    unsigned int hist_eq[256];
+    unsigned int N = cdf[255];
     for (int i = 0; i < 256; i++) {
         if (cdf[i] < cdf_min) {
-            hist_eq[i] = 0;
+            lut[i] = 0;
+        } else if (N == cdf_min) {
+            // Image d'un seul niveau : rien à égaliser
+            lut[i] = (unsigned char) i;
         } else {
-            hist_eq[i] = (unsigned int) round(((double) (cdf[i] - cdf_min) / (double) (pixelCount - cdf_min)) * 255.0);
+            lut[i] = (unsigned char) round(((double) (cdf[i] - cdf_min) / (double) (N - cdf_min)) * 255.0);
         }
     }
+}
 
-    // 4. Application de l'égalisation à la composante Y uniquement
-    for (unsigned int i = 0; i < pixelCount; i++) {
-        unsigned char y = (unsigned char) (Y[i] < 0 ? 0 : (Y[i] > 255 ? 255 : Y[i]));
-        Y[i] = hist_eq[y];
+// Nombre de pixels dont la luminance est calculée d'un bloc (tampon sur la pile)
+#define HISTOGRAM_LUMA_CHUNK 256
+
+/**
+ * Ajoute la luminance d'une suite de pixels à un histogramme
+ *
+ * @param pixels Les pixels
+ * @param count Nombre de pixels
+ * @param hist Histogramme de 256 éléments à compléter
+ */
+void bmp24_accumulateLumaHistogram(const t_pixel *pixels, int count, unsigned int hist[256]) {
+    unsigned int lanes[HISTOGRAM_LANES][256];
+    memset(lanes, 0, sizeof(lanes));
+
+    uint8_t luma[HISTOGRAM_LUMA_CHUNK];
+    for (int x = 0; x < count; x += HISTOGRAM_LUMA_CHUNK) {
+        int n = count - x < HISTOGRAM_LUMA_CHUNK ? count - x : HISTOGRAM_LUMA_CHUNK;
+        color_rgbToLumaFloor(pixels + x, luma, n);
+        histogram_accumulateLanes(luma, n, lanes);
     }
 
-    // 5. Reconversion YUV vers RGB
+    for (int i = 0; i < 256; i++) {
+        hist[i] += lanes[0][i] + lanes[1][i] + lanes[2][i] + lanes[3][i];
+    }
+}
+
+/**
+ * Prépare l'application d'une table de luminance : pour chaque luminance d'origine, la hausse
+ * et la baisse à appliquer aux trois canaux, sous forme de pixels (alpha à 0)
+ *
+ * @param lut Nouvelle luminance pour chaque luminance d'origine
+ * @param up Reçoit la hausse de chaque canal (0 si la luminance baisse)
+ * @param down Reçoit la baisse de chaque canal (0 si la luminance monte)
+ */
+static void histogram_lumaDeltas(const unsigned char lut[256], t_pixel up[256], t_pixel down[256]) {
+    for (int i = 0; i < 256; i++) {
+        int delta = (int) lut[i] - i;
+        uint8_t rise = (uint8_t) (delta > 0 ? delta : 0);
+        uint8_t fall = (uint8_t) (delta < 0 ? -delta : 0);
+        up[i] = (t_pixel) {rise, rise, rise, 0};
+        down[i] = (t_pixel) {fall, fall, fall, 0};
+    }
+}
+
+/**
+ * Ajoute à chaque pixel la variation de luminance préparée par histogram_lumaDeltas
+ *
+ * La luminance d'origine est calculée en SIMD par blocs ; l'ajout saturé de la hausse puis
+ * la soustraction saturée de la baisse (dont l'une est nulle) limitent chaque canal à [0, 255].
+ *
+ * @param pixels Les pixels à modifier
+ * @param count Nombre de pixels
+ * @param up Hausse de chaque canal selon la luminance d'origine
+ * @param down Baisse de chaque canal selon la luminance d'origine
+ */
+static void histogram_applyLumaDeltas(t_pixel *pixels, int count, const t_pixel up[256], const t_pixel down[256]) {
+    uint8_t luma[HISTOGRAM_LUMA_CHUNK];
+    for (int start = 0; start < count; start += HISTOGRAM_LUMA_CHUNK) {
+        int n = count - start < HISTOGRAM_LUMA_CHUNK ? count - start : HISTOGRAM_LUMA_CHUNK;
+        t_pixel *chunk = pixels + start;
+        color_rgbToLumaFloor(chunk, luma, n);
+
+        int x = 0;
+#ifdef HISTOGRAM_SIMD
+        for (; x + 4 <= n; x += 4) {
+            uint32_t u[4], d[4];
+            for (int i = 0; i < 4; i++) {
+                memcpy(&u[i], &up[luma[x + i]], sizeof(uint32_t));
+                memcpy(&d[i], &down[luma[x + i]], sizeof(uint32_t));
+            }
+            __m128i p = _mm_loadu_si128((const __m128i *) (chunk + x));
+            p = _mm_adds_epu8(p, _mm_setr_epi32((int) u[0], (int) u[1], (int) u[2], (int) u[3]));
+            p = _mm_subs_epu8(p, _mm_setr_epi32((int) d[0], (int) d[1], (int) d[2], (int) d[3]));
+            _mm_storeu_si128((__m128i *) (chunk + x), p);
+        }
+#endif
+        for (; x < n; x++) {
+            t_pixel *p = &chunk[x];
+            const t_pixel *rise = &up[luma[x]];
+            const t_pixel *fall = &down[luma[x]];
+            int r = p->red + rise->red - fall->red;
+            int g = p->green + rise->green - fall->green;
+            int b = p->blue + rise->blue - fall->blue;
+            p->red = (uint8_t) (r < 0 ? 0 : (r > 255 ? 255 : r));
+            p->green = (uint8_t) (g < 0 ? 0 : (g > 255 ? 255 : g));
+            p->blue = (uint8_t) (b < 0 ? 0 : (b > 255 ? 255 : b));
+        }
+    }
+}
+
+/**
+ * Applique une table de correspondance à la luminance d'une suite de pixels en conservant
+ * la chrominance
+ *
+ * À U et V constants, la reconversion YUV -> RGB revient à ajouter la variation de Y
+ * à chacun des trois canaux : aucun plan Y/U/V n'est nécessaire. La variation est celle de
+ * la luminance tronquée (la clé de la table), et non de la luminance exacte : le résultat
+ * s'écarte de la reconversion YUV flottante d'au plus 2 niveaux par canal.
+ *
+ * @param pixels Les pixels à modifier
+ * @param count Nombre de pixels
+ * @param lut Nouvelle luminance pour chaque luminance d'origine
+ */
+void bmp24_applyLumaLut(t_pixel *pixels, int count, const unsigned char lut[256]) {
+    t_pixel up[256], down[256];
+    histogram_lumaDeltas(lut, up, down);
+    histogram_applyLumaDeltas(pixels, count, up, down);
+}
+
+/**
+ * Égalise l'histogramme d'une image BMP 24 bits en deux passes sans plan intermédiaire
+ *
+ * @param img L'image à égaliser
+ */
+void bmp24_equalizeStreaming(t_bmp24 *img) {
+    if (img == NULL || img->data == NULL) {
+        return;
+    }
+
+    TRACE_BEGIN("bmp24_equalizeStreaming");
+    // 1. Histogramme de la luminance, en parallèle par rangées
+    unsigned int hist[256];
+    bmp24_computeHistograms(img, hist, NULL, NULL, NULL);
+
+    // 2. Table de correspondance de la luminance
+    unsigned char lut[256];
+    histogram_computeEqualizationLut(hist, lut);
+
+    // 3. Application directe aux canaux RGB, rangée par rangée
+    t_pixel up[256], down[256];
+    histogram_lumaDeltas(lut, up, down);
+#pragma omp parallel for schedule(static) if ((long) img->width * img->height >= HISTOGRAM_PARALLEL_MIN_PIXELS)
     for (int y = 0; y < img->height; y++) {
-        for (int x = 0; x < img->width; x++) {
-            unsigned int idx = y * img->width + x;
-            float y_val = Y[idx];
-            float u = U[idx];
-            float v = V[idx];
+        histogram_applyLumaDeltas(img->data[y], img->width, up, down);
+    }
+    TRACE_END(img->width, img->height, 2 * (size_t) img->width * img->height * sizeof(t_pixel));
+}
+
+/**
+ * Égalise la luminance d'une vue d'image 24 bits (histogramme de la vue seulement),
+ * en deux passes sur les rangées comme bmp24_equalizeStreaming
+ *
+ * @param view La vue à égaliser
+ */
+void view24_equalize(t_view24 view) {
+    if (view.data == NULL) {
+        return;
+    }
+
+    TRACE_BEGIN("view24_equalize");
+    unsigned int hist[256];
+    view24_computeHistograms(view, hist, NULL, NULL, NULL);
+
+    unsigned char lut[256];
+    histogram_computeEqualizationLut(hist, lut);
+
+    t_pixel up[256], down[256];
+    histogram_lumaDeltas(lut, up, down);
+    for (int y = 0; y < view.height; y++) {
+        histogram_applyLumaDeltas(view.data + (size_t) y * view.stride, view.width, up, down);
+    }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height * sizeof(t_pixel));
+}
+
+/**
+ * Calcule la table de correspondance CLAHE d'une tuile
+ *
+ * @param plane Le plan de luminance
+ * @param stride Nombre d'octets entre une rangée du plan et la suivante (négatif si stocké de bas en haut)
+ * @param x0 Première colonne de la tuile
+ * @param x1 Colonne suivant la dernière colonne de la tuile
+ * @param y0 Première rangée de la tuile
+ * @param y1 Rangée suivant la dernière rangée de la tuile
+ * @param clipLimit Limite de contraste (<= 0 : sans limite)
+ * @param lut Table de 256 éléments à remplir
+ */
+static void clahe_tileLut(const unsigned char *plane, int stride, int x0, int x1, int y0, int y1,
+                          float clipLimit, unsigned char lut[256]) {
+    unsigned int lanes[HISTOGRAM_LANES][256];
+    memset(lanes, 0, sizeof(lanes));
+    for (int y = y0; y < y1; y++) {
+        histogram_accumulateLanes(plane + (ptrdiff_t) y * stride + x0, x1 - x0, lanes);
+    }
+
+    unsigned int hist[256];
+    for (int i = 0; i < 256; i++) {
+        hist[i] = lanes[0][i] + lanes[1][i] + lanes[2][i] + lanes[3][i];
+    }
 
-            // Formules de conversion YUV vers RGB
-            int r = (int) (y_val + 1.13983 * v);
-            int g = (int) (y_val - 0.39465 * u - 0.58060 * v);
-            int b = (int) (y_val + 2.03211 * u);
+    uint64_t tilePixels = (uint64_t) (x1 - x0) * (uint64_t) (y1 - y0);
 
-            // Limiter les valeurs à l'intervalle [0, 255]
-            r = (r < 0) ? 0 : ((r > 255) ? 255 : r);
-            g = (g < 0) ? 0 : ((g > 255) ? 255 : g);
-            b = (b < 0) ? 0 : ((b > 255) ? 255 : b);
+    // Écrêtage de l'histogramme et redistribution uniforme de l'excédent
+    if (clipLimit > 0) {
+        unsigned int limit = (unsigned int) (clipLimit * tilePixels / 256.0f);
+        if (limit < 1) limit = 1;
 
-            // Mise à jour des valeurs des pixels
-            img->data[y][x].red = (unsigned char) r;
-            img->data[y][x].green = (unsigned char) g;
-            img->data[y][x].blue = (unsigned char) b;
+        unsigned int excess = 0;
+        for (int i = 0; i < 256; i++) {
+            if (hist[i] > limit) {
+                excess += hist[i] - limit;
+                hist[i] = limit;
+            }
+        }
+
+        unsigned int perBin = excess / 256;
+        unsigned int remainder = excess % 256;
+        for (int i = 0; i < 256; i++) hist[i] += perBin;
+        if (remainder > 0) {
+            unsigned int step = 256 / remainder;
+            for (unsigned int i = 0; i < 256 && remainder > 0; i += step, remainder--) hist[i]++;
         }
     }
 
-    // Libération de la mémoire
-    free(Y);
-    free(U);
-    free(V);
+    // Fonction de transformation : CDF normalisée sur [0, 255] (sur 64 bits : cdf * 255 dépasse
+    // 32 bits dès qu'une tuile compte plus de 16 millions de pixels)
+    uint64_t cdf = 0;
+    for (int i = 0; i < 256; i++) {
+        cdf += hist[i];
+        lut[i] = (unsigned char) ((cdf * 255u + tilePixels / 2) / tilePixels);
+    }
+}
+
+/**
+ * Prépare l'interpolation le long d'un axe : pour chaque coordonnée, les deux tuiles
+ * dont les centres l'encadrent et le poids de la seconde
+ *
+ * @param size Taille de l'axe en pixels
+ * @param tiles Nombre de tuiles sur cet axe
+ * @param scale Facteur appliqué aux indices de tuiles (décalage d'une tuile dans le tableau de tables)
+ * @param first Reçoit l'indice (multiplié par scale) de la première tuile pour chaque coordonnée
+ * @param second Reçoit l'indice (multiplié par scale) de la seconde tuile pour chaque coordonnée
+ * @param weight Reçoit le poids de la seconde tuile pour chaque coordonnée, sur 8 bits (0-256)
+ */
+static void clahe_axis(int size, int tiles, int scale, int *first, int *second, int *weight) {
+    for (int p = 0; p < size; p++) {
+        // Position en unités de tuiles, centre de la tuile t à t + 0.5
+        float pos = ((float) p + 0.5f) * tiles / size - 0.5f;
+        int t = (int) (pos + 1.0f) - 1; // floor pour pos >= -1
+
+        if (t < 0) {
+            first[p] = second[p] = 0;
+            weight[p] = 0;
+        } else if (t >= tiles - 1) {
+            first[p] = second[p] = (tiles - 1) * scale;
+            weight[p] = 0;
+        } else {
+            first[p] = t * scale;
+            second[p] = (t + 1) * scale;
+            weight[p] = (int) ((pos - (float) t) * 256.0f + 0.5f);
+        }
+    }
+}
+
+/**
+ * Interpole verticalement deux rangées de tables CLAHE : dst = top * (256 - wy) + bottom * wy
+ *
+ * @param top Tables des tuiles au-dessus
+ * @param bottom Tables des tuiles au-dessous
+ * @param wy Poids des tuiles du dessous, sur 8 bits (0-256)
+ * @param dst Reçoit les valeurs interpolées sur 16 bits
+ * @param count Nombre de valeurs (multiple de 256)
+ */
+static void clahe_blendLuts(const unsigned char *top, const unsigned char *bottom, unsigned int wy,
+                            uint16_t *dst, int count) {
+    int i = 0;
+#ifdef HISTOGRAM_SIMD
+    // Somme au plus 255 * 256 : exacte sur 16 bits non signés
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weightTop = _mm_set1_epi16((short) (256 - wy));
+    const __m128i weightBottom = _mm_set1_epi16((short) wy);
+    for (; i + 16 <= count; i += 16) {
+        __m128i t = _mm_loadu_si128((const __m128i *) (top + i));
+        __m128i b = _mm_loadu_si128((const __m128i *) (bottom + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(t, zero), weightTop),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weightBottom));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(t, zero), weightTop),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weightBottom));
+        _mm_storeu_si128((__m128i *) (dst + i), lo);
+        _mm_storeu_si128((__m128i *) (dst + i + 8), hi);
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = (uint16_t) (top[i] * (256 - wy) + bottom[i] * wy);
+    }
+}
+
+/**
+ * Applique CLAHE à un plan de luminance, en place
+ *
+ * @param plane Le plan de luminance
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Nombre d'octets entre une rangée du plan et la suivante (négatif si stocké de bas en haut)
+ * @param tilesX Nombre de tuiles horizontalement
+ * @param tilesY Nombre de tuiles verticalement
+ * @param clipLimit Limite de contraste (<= 0 : sans limite)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int clahe_plane(unsigned char *plane, int width, int height, int stride,
+                       int tilesX, int tilesY, float clipLimit) {
+    // Tables de la rangée de chaque thread, découpées dans un seul bloc (voir view24_computeHistograms)
+    size_t rowLutsSlice = histogram_sliceSize((size_t) tilesX * 256 * sizeof(uint16_t));
+    int threads = histogram_threadCount();
+    unsigned char *luts = scratch_alloc((size_t) tilesX * tilesY * 256);
+    unsigned char *rowLutsBlock = scratch_alloc(rowLutsSlice * threads);
+    int *xFirst = scratch_alloc(width * sizeof(int));
+    int *xSecond = scratch_alloc(width * sizeof(int));
+    int *xWeight = scratch_alloc(width * sizeof(int));
+    int *xEnd = scratch_alloc(width * sizeof(int));
+    int *yFirst = scratch_alloc(height * sizeof(int));
+    int *ySecond = scratch_alloc(height * sizeof(int));
+    int *yWeight = scratch_alloc(height * sizeof(int));
+    if (luts == NULL || rowLutsBlock == NULL || xFirst == NULL || xSecond == NULL || xWeight == NULL ||
+        xEnd == NULL || yFirst == NULL || ySecond == NULL || yWeight == NULL) {
+        scratch_free(luts);
+        scratch_free(rowLutsBlock);
+        scratch_free(xFirst);
+        scratch_free(xSecond);
+        scratch_free(xWeight);
+        scratch_free(xEnd);
+        scratch_free(yFirst);
+        scratch_free(ySecond);
+        scratch_free(yWeight);
+        return -1;
+    }
+
+    // 1. Histogramme écrêté et table de correspondance de chaque tuile, en parallèle
+#pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < tilesX * tilesY; t++) {
+        int tx = t % tilesX;
+        int ty = t / tilesX;
+        clahe_tileLut(plane, stride,
+                      tx * width / tilesX, (tx + 1) * width / tilesX,
+                      ty * height / tilesY, (ty + 1) * height / tilesY,
+                      clipLimit, luts + (size_t) t * 256);
+    }
+
+    // 2. Interpolation bilinéaire entre les tables des quatre tuiles voisines
+    clahe_axis(width, tilesX, 256, xFirst, xSecond, xWeight);
+    clahe_axis(height, tilesY, tilesX * 256, yFirst, ySecond, yWeight);
+
+    // Fin du segment de colonnes qui partagent les mêmes deux tuiles, pour chaque colonne
+    xEnd[width - 1] = width;
+    for (int x = width - 2; x >= 0; x--) {
+        xEnd[x] = xFirst[x] == xFirst[x + 1] && xSecond[x] == xSecond[x + 1] ? xEnd[x + 1] : x + 1;
+    }
+
+#pragma omp parallel num_threads(threads)
+    {
+        // Tables de la rangée : interpolation verticale faite une fois par rangée pour chaque
+        // tuile, il ne reste par pixel que deux lectures et l'interpolation horizontale
+        uint16_t *rowLuts = (uint16_t *) (rowLutsBlock + rowLutsSlice * histogram_threadIndex());
+
+#pragma omp for schedule(static)
+        for (int y = 0; y < height; y++) {
+            unsigned char *row = plane + (ptrdiff_t) y * stride;
+            clahe_blendLuts(luts + yFirst[y], luts + ySecond[y], (unsigned int) yWeight[y], rowLuts, tilesX * 256);
+
+            // Par segment de colonnes entre deux centres de tuiles : mêmes deux tables,
+            // a * (256 - wx) + b * wx calculé comme a * 256 + (b - a) * wx
+            for (int x = 0; x < width;) {
+                const uint16_t *first = rowLuts + xFirst[x];
+                const uint16_t *second = rowLuts + xSecond[x];
+                int end = xEnd[x];
+                for (; x < end; x++) {
+                    int v = row[x];
+                    int a = first[v];
+                    row[x] = (unsigned char) ((a * 256 + (second[v] - a) * xWeight[x] + 32768) >> 16);
+                }
+            }
+        }
+    }
+
+    scratch_free(luts);
+    scratch_free(rowLutsBlock);
+    scratch_free(xFirst);
+    scratch_free(xSecond);
+    scratch_free(xWeight);
+    scratch_free(xEnd);
+    scratch_free(yFirst);
+    scratch_free(ySecond);
+    scratch_free(yWeight);
+    return 0;
+}
+
+/**
+ * Vérifie les paramètres de CLAHE
+ *
+ * @param width Largeur de l'image
+ * @param height Hauteur de l'image
+ * @param tilesX Nombre de tuiles horizontalement
+ * @param tilesY Nombre de tuiles verticalement
+ * @return int: 1 si les paramètres sont valides, 0 sinon
+ */
+static int clahe_checkArgs(int width, int height, int tilesX, int tilesY) {
+    if (tilesX < 1 || tilesY < 1 || tilesX > width || tilesY > height) {
+        fprintf(stderr, "Grille de tuiles CLAHE invalide (%d x %d) pour une image %d x %d\n",
+                tilesX, tilesY, width, height);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Égalise une image BMP 8 bits par CLAHE (égalisation adaptative à contraste limité)
+ *
+ * @param img L'image à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void bmp8_equalizeCLAHE(t_bmp8 *img, int tilesX, int tilesY, float clipLimit) {
+    if (img == NULL || img->data == NULL) {
+        return;
+    }
+
+    // Palette ramenée aux intensités réelles dont les histogrammes locaux ont besoin
+    view8_equalizeCLAHE(bmp8_storageView(img), tilesX, tilesY, clipLimit);
+}
+
+/**
+ * Égalise une vue d'image 8 bits par CLAHE (tuiles réparties sur la vue)
+ *
+ * @param view La vue à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void view8_equalizeCLAHE(t_view8 view, int tilesX, int tilesY, float clipLimit) {
+    if (view.data == NULL) {
+        return;
+    }
+    if (!clahe_checkArgs(view.width, view.height, tilesX, tilesY)) {
+        return;
+    }
+
+    TRACE_BEGIN("view8_equalizeCLAHE");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    if (clahe_plane(view.data, view.width, view.height, view.stride, tilesX, tilesY, clipLimit) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour CLAHE\n");
+    }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height);
+}
+
+/**
+ * Égalise la luminance d'une image BMP 24 bits par CLAHE
+ *
+ * @param img L'image à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void bmp24_equalizeCLAHE(t_bmp24 *img, int tilesX, int tilesY, float clipLimit) {
+    if (img == NULL || img->data == NULL) {
+        return;
+    }
+
+    view24_equalizeCLAHE(bmp24_view(img, 0, 0, img->width, img->height), tilesX, tilesY, clipLimit);
+}
+
+/**
+ * Égalise la luminance d'une vue d'image 24 bits par CLAHE (tuiles réparties sur la vue)
+ *
+ * @param view La vue à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void view24_equalizeCLAHE(t_view24 view, int tilesX, int tilesY, float clipLimit) {
+    if (view.data == NULL) {
+        return;
+    }
+    if (!clahe_checkArgs(view.width, view.height, tilesX, tilesY)) {
+        return;
+    }
+
+    TRACE_BEGIN("view24_equalizeCLAHE");
+    int width = view.width;
+    int height = view.height;
+
+    // Plans de luminance : original et égalisé (1 octet par pixel chacun)
+    unsigned char *luma = scratch_alloc((size_t) 2 * width * height);
+    if (luma == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour CLAHE\n");
+        return;
+    }
+    unsigned char *equalized = luma + (size_t) width * height;
+
+    for (int y = 0; y < height; y++) {
+        color_rgbToLuma(view.data + (size_t) y * view.stride, luma + (size_t) y * width, width);
+    }
+    memcpy(equalized, luma, (size_t) width * height);
+
+    if (clahe_plane(equalized, width, height, width, tilesX, tilesY, clipLimit) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour CLAHE\n");
+        scratch_free(luma);
+        return;
+    }
+
+    // À U et V constants, la reconversion YUV -> RGB revient à ajouter la variation de Y
+    // à chacun des trois canaux
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t idx = (size_t) y * width + x;
+            int delta = (int) equalized[idx] - (int) luma[idx];
+            t_pixel *p = view.data + (size_t) y * view.stride + x;
+
+            int r = p->red + delta;
+            int g = p->green + delta;
+            int b = p->blue + delta;
+            p->red = (uint8_t) (r < 0 ? 0 : (r > 255 ? 255 : r));
+            p->green = (uint8_t) (g < 0 ? 0 : (g > 255 ? 255 : g));
+            p->blue = (uint8_t) (b < 0 ? 0 : (b > 255 ? 255 : b));
+        }
+    }
+
+    scratch_free(luma);
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height * sizeof(t_pixel));
 }
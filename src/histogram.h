@@ -12,6 +12,75 @@
  */
 unsigned int *bmp8_computeHistogram(t_bmp8 *img);
 
+/**
+ * Calcule l'histogramme d'une image BMP 8 bits dans un tableau fourni par l'appelant
+ * (plusieurs sous-histogrammes entrelacés par thread, fusionnés à la fin)
+ *
+ * @param img L'image dont on souhaite calculer l'histogramme
+ * @param histogram Tableau de 256 éléments qui reçoit les occurrences de chaque niveau de gris
+ */
+void bmp8_computeHistogramInto(t_bmp8 *img, unsigned int histogram[256]);
+
+/**
+ * Calcule l'histogramme des pixels d'une vue d'image 8 bits (intensités stockées, sans cache)
+ *
+ * @param view La vue
+ * @param histogram Tableau de 256 éléments qui reçoit les occurrences de chaque niveau de gris
+ */
+void view8_computeHistogram(t_view8 view, unsigned int histogram[256]);
+
+/**
+ * Calcule les occurrences cumulées des niveaux de gris d'une image BMP 8 bits
+ * (O(256) si le cache d'histogramme de l'image est valide)
+ *
+ * @param img L'image concernée
+ * @param cdf Tableau de 256 éléments : cdf[v] = nombre de pixels de niveau <= v
+ */
+void bmp8_computeCumulative(t_bmp8 *img, unsigned int cdf[256]);
+
+/**
+ * Calcule le seuil de binarisation automatique par la méthode d'Otsu
+ * (maximisation de la variance inter-classes)
+ *
+ * @param img L'image concernée
+ * @return int: Le seuil (0-255) à passer à bmp8_threshold, ou -1 en cas d'erreur
+ */
+int bmp8_otsuThreshold(t_bmp8 *img);
+
+/**
+ * Calcule un percentile des niveaux de gris d'une image BMP 8 bits
+ *
+ * @param img L'image concernée
+ * @param percent Le percentile souhaité (0 à 100)
+ * @return int: Le plus petit niveau v tel qu'au moins percent % des pixels sont <= v, ou -1 en cas d'erreur
+ */
+int bmp8_percentile(t_bmp8 *img, double percent);
+
+/**
+ * Calcule en une seule passe les histogrammes d'une image BMP 24 bits
+ * Chaque tableau peut être NULL si le canal correspondant n'est pas demandé
+ *
+ * @param img L'image dont on souhaite calculer les histogrammes
+ * @param histY Histogramme de la luminance Y (BT.601, tronquée comme pour l'égalisation), ou NULL
+ * @param histR Histogramme du canal rouge, ou NULL
+ * @param histG Histogramme du canal vert, ou NULL
+ * @param histB Histogramme du canal bleu, ou NULL
+ */
+void bmp24_computeHistograms(const t_bmp24 *img, unsigned int histY[256], unsigned int histR[256],
+                             unsigned int histG[256], unsigned int histB[256]);
+
+/**
+ * Calcule en une seule passe les histogrammes d'une vue d'image 24 bits
+ *
+ * @param view La vue
+ * @param histY Histogramme de la luminance Y (BT.601, tronquée comme pour l'égalisation), ou NULL
+ * @param histR Histogramme du canal rouge, ou NULL
+ * @param histG Histogramme du canal vert, ou NULL
+ * @param histB Histogramme du canal bleu, ou NULL
+ */
+void view24_computeHistograms(t_view24 view, unsigned int histY[256], unsigned int histR[256],
+                              unsigned int histG[256], unsigned int histB[256]);
+
 /**
  * Calcule la fonction de distribution cumulative (CDF) d'un histogramme
  *
@@ -27,6 +96,13 @@ unsigned int *bmp8_computeCDF(unsigned int *hist);
  */
 void bmp8_equalize(t_bmp8 *img);
 
+/**
+ * Égalise l'histogramme d'une vue d'image 8 bits (histogramme de la vue seulement)
+ *
+ * @param view La vue à égaliser
+ */
+void view8_equalize(t_view8 view);
+
 /**
  * Égalise l'histogramme d'une image BMP 24 bits pour améliorer son contraste
  * en utilisant l'espace colorimétrique YUV
@@ -35,4 +111,93 @@ void bmp8_equalize(t_bmp8 *img);
  */
 void bmp24_equalize(t_bmp24 *img);
 
+/**
+ * Calcule la table de correspondance de l'égalisation d'histogramme (CDF normalisée sur [0, 255])
+ *
+ * @param hist L'histogramme original
+ * @param lut Table de 256 éléments qui reçoit la nouvelle valeur de chaque niveau
+ */
+void histogram_computeEqualizationLut(const unsigned int hist[256], unsigned char lut[256]);
+
+/**
+ * Ajoute la luminance d'une suite de pixels à un histogramme (première passe de l'égalisation
+ * en flux : peut être appelée bande par bande)
+ *
+ * @param pixels Les pixels
+ * @param count Nombre de pixels
+ * @param hist Histogramme de 256 éléments à compléter
+ */
+void bmp24_accumulateLumaHistogram(const t_pixel *pixels, int count, unsigned int hist[256]);
+
+/**
+ * Applique une table de correspondance à la luminance d'une suite de pixels en conservant
+ * la chrominance (seconde passe de l'égalisation en flux : peut être appelée bande par bande)
+ *
+ * @param pixels Les pixels à modifier
+ * @param count Nombre de pixels
+ * @param lut Nouvelle luminance pour chaque luminance d'origine
+ */
+void bmp24_applyLumaLut(t_pixel *pixels, int count, const unsigned char lut[256]);
+
+/**
+ * Égalise l'histogramme d'une image BMP 24 bits en deux passes sans plan intermédiaire :
+ * histogramme de la luminance, puis variation de luminance appliquée directement aux canaux RGB.
+ * Même table que bmp24_equalize (luminance tronquée), avec quelques Ko de mémoire supplémentaire ;
+ * ajouter la variation de luminance aux canaux au lieu de reconvertir depuis YUV donne au plus
+ * 2 niveaux d'écart par canal avec l'égalisation YUV flottante d'origine (valeurs limitées à [0, 255]).
+ *
+ * @param img L'image à égaliser
+ */
+void bmp24_equalizeStreaming(t_bmp24 *img);
+
+/**
+ * Égalise la luminance d'une vue d'image 24 bits (histogramme de la vue seulement)
+ *
+ * @param view La vue à égaliser
+ */
+void view24_equalize(t_view24 view);
+
+/**
+ * Égalise une image BMP 8 bits par CLAHE (égalisation adaptative à contraste limité) :
+ * une table de correspondance est calculée par tuile, puis interpolée bilinéairement
+ * entre les centres des tuiles voisines
+ *
+ * @param img L'image à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void bmp8_equalizeCLAHE(t_bmp8 *img, int tilesX, int tilesY, float clipLimit);
+
+/**
+ * Égalise une vue d'image 8 bits par CLAHE (tuiles réparties sur la vue)
+ *
+ * @param view La vue à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void view8_equalizeCLAHE(t_view8 view, int tilesX, int tilesY, float clipLimit);
+
+/**
+ * Égalise la luminance d'une image BMP 24 bits par CLAHE
+ * La chrominance est conservée : la variation de Y est ajoutée aux trois canaux
+ *
+ * @param img L'image à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void bmp24_equalizeCLAHE(t_bmp24 *img, int tilesX, int tilesY, float clipLimit);
+
+/**
+ * Égalise la luminance d'une vue d'image 24 bits par CLAHE (tuiles réparties sur la vue)
+ *
+ * @param view La vue à égaliser
+ * @param tilesX Nombre de tuiles horizontalement (>= 1)
+ * @param tilesY Nombre de tuiles verticalement (>= 1)
+ * @param clipLimit Limite de contraste, en multiple de la hauteur moyenne d'un compartiment (<= 0 : sans limite)
+ */
+void view24_equalizeCLAHE(t_view24 view, int tilesX, int tilesY, float clipLimit);
+
 #endif
@@ -0,0 +1,454 @@
+#include "history.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Pixels d'une image vus comme des rangées d'octets (rangées stockées, bourrage exclu)
+typedef struct {
+    unsigned char *base; // Première rangée stockée
+    size_t stride; // Octets entre deux rangées
+    int bytesPerPixel; // 1 (8 bits) ou 4 (24 bits)
+} t_history_pixels;
+
+/**
+ * Pixels d'une image 8 bits
+ */
+static t_history_pixels history_pixelsBmp8(const t_bmp8 *img) {
+    t_history_pixels pixels = {img->data, bmp8_rowSize(img), 1};
+    return pixels;
+}
+
+/**
+ * Pixels d'une image 24 bits (rangées contiguës)
+ */
+static t_history_pixels history_pixelsBmp24(const t_bmp24 *img) {
+    t_history_pixels pixels = {(unsigned char *) img->data[0], (size_t) img->width * sizeof(t_pixel),
+                               (int) sizeof(t_pixel)};
+    return pixels;
+}
+
+/**
+ * Rectangle couvert par une tuile
+ *
+ * @param state L'étape
+ * @param index Numéro de la tuile
+ * @param x Reçoit la première colonne
+ * @param y Reçoit la première rangée stockée
+ * @param width Reçoit la largeur (plus petite au bord droit)
+ * @param height Reçoit la hauteur (plus petite au dernier rang)
+ */
+static void history_tileRect(const t_history_state *state, int index, int *x, int *y, int *width, int *height) {
+    *x = index % state->tilesX * HISTORY_TILE;
+    *y = index / state->tilesX * HISTORY_TILE;
+    *width = state->width - *x < HISTORY_TILE ? state->width - *x : HISTORY_TILE;
+    *height = state->height - *y < HISTORY_TILE ? state->height - *y : HISTORY_TILE;
+}
+
+/**
+ * Copie les pixels d'un rectangle de l'image dans une nouvelle tuile
+ *
+ * @return t_history_tile*: La tuile (une référence) ou NULL en cas d'erreur
+ */
+static t_history_tile *history_copyTile(t_history *history, t_history_pixels pixels, int x, int y, int width,
+                                        int height) {
+    size_t rowBytes = (size_t) width * pixels.bytesPerPixel;
+    t_history_tile *tile = (t_history_tile *) malloc(sizeof(t_history_tile) + rowBytes * height);
+    if (tile == NULL) return NULL;
+
+    tile->refs = 1;
+    tile->size = rowBytes * height;
+    for (int row = 0; row < height; row++) {
+        const unsigned char *src = pixels.base + (size_t) (y + row) * pixels.stride + (size_t) x * pixels.bytesPerPixel;
+        memcpy(tile->data + row * rowBytes, src, rowBytes);
+    }
+    history->tileBytes += tile->size;
+    history->tilesCopied++;
+    return tile;
+}
+
+/**
+ * Recopie une tuile dans les pixels de l'image
+ */
+static void history_writeTile(const t_history_tile *tile, t_history_pixels pixels, int x, int y, int width,
+                              int height) {
+    size_t rowBytes = (size_t) width * pixels.bytesPerPixel;
+    for (int row = 0; row < height; row++) {
+        unsigned char *dst = pixels.base + (size_t) (y + row) * pixels.stride + (size_t) x * pixels.bytesPerPixel;
+        memcpy(dst, tile->data + row * rowBytes, rowBytes);
+    }
+}
+
+/**
+ * Libère une référence à une tuile (la tuile est libérée avec sa dernière référence)
+ */
+static void history_releaseTile(t_history *history, t_history_tile *tile) {
+    if (tile == NULL || --tile->refs > 0) return;
+    history->tileBytes -= tile->size;
+    free(tile);
+}
+
+/**
+ * Libère les tuiles d'une étape
+ */
+static void history_releaseState(t_history *history, t_history_state *state) {
+    for (int i = 0; i < state->tilesX * state->tilesY; i++) {
+        history_releaseTile(history, state->tiles[i]);
+    }
+    free(state->tiles);
+    state->tiles = NULL;
+}
+
+/**
+ * Oublie les étapes les plus anciennes tant que les tuiles dépassent maxBytes (l'étape courante reste)
+ *
+ * @param history L'historique
+ */
+static void history_trim(t_history *history) {
+    int dropped = 0;
+    while (history->tileBytes > history->maxBytes && dropped < history->current) {
+        history_releaseState(history, &history->states[dropped]);
+        dropped++;
+    }
+    if (dropped > 0) {
+        memmove(history->states, history->states + dropped,
+                (size_t) (history->count - dropped) * sizeof(t_history_state));
+        history->count -= dropped;
+        history->current -= dropped;
+    }
+}
+
+/**
+ * Efface les zones déclarées : l'image correspond désormais à l'étape courante
+ *
+ * @param history L'historique
+ */
+static void history_resetDirty(t_history *history) {
+    history->dirtyMarked = 0;
+    if (history->current < 0) return;
+
+    const t_history_state *state = &history->states[history->current];
+    int count = state->tilesX * state->tilesY;
+    if (count > history->dirtyCapacity) {
+        // Sans marques, les déclarations sont ignorées et l'instantané suivant copie toute l'image
+        free(history->dirty);
+        history->dirtyCapacity = 0;
+        history->dirty = (unsigned char *) malloc((size_t) count);
+        if (history->dirty == NULL) return;
+        history->dirtyCapacity = count;
+    }
+    memset(history->dirty, 0, (size_t) count);
+}
+
+/**
+ * Ajoute une étape : tuiles déclarées modifiées copiées, autres tuiles partagées avec l'étape courante
+ *
+ * @param history L'historique
+ * @param state La nouvelle étape (dimensions et paramètres renseignés, tuiles à construire)
+ * @param pixels Les pixels de l'image
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int history_commit(t_history *history, t_history_state *state, t_history_pixels pixels) {
+    // Les étapes annulées ne peuvent plus être rétablies
+    while (history->count > history->current + 1) {
+        history_releaseState(history, &history->states[--history->count]);
+    }
+
+    if (history->count == history->capacity) {
+        int capacity = history->capacity * 2;
+        t_history_state *states = (t_history_state *) realloc(history->states,
+                                                              (size_t) capacity * sizeof(t_history_state));
+        if (states == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour l'historique\n");
+            return -1;
+        }
+        history->states = states;
+        history->capacity = capacity;
+    }
+
+    state->tilesX = (state->width + HISTORY_TILE - 1) / HISTORY_TILE;
+    state->tilesY = (state->height + HISTORY_TILE - 1) / HISTORY_TILE;
+    int count = state->tilesX * state->tilesY;
+    state->tiles = (t_history_tile **) calloc((size_t) count, sizeof(t_history_tile *));
+    if (state->tiles == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'historique\n");
+        return -1;
+    }
+
+    const t_history_state *previous = history->current >= 0 ? &history->states[history->current] : NULL;
+    int shared = previous != NULL && history->dirtyMarked && previous->depth == state->depth &&
+                 previous->width == state->width && previous->height == state->height;
+
+    for (int i = 0; i < count; i++) {
+        if (shared && !history->dirty[i]) {
+            state->tiles[i] = previous->tiles[i];
+            state->tiles[i]->refs++;
+            history->tilesShared++;
+            continue;
+        }
+
+        int x, y, width, height;
+        history_tileRect(state, i, &x, &y, &width, &height);
+        state->tiles[i] = history_copyTile(history, pixels, x, y, width, height);
+        if (state->tiles[i] == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour l'historique\n");
+            history_releaseState(history, state);
+            return -1;
+        }
+    }
+
+    history->states[history->count++] = *state;
+    history->current = history->count - 1;
+    history_trim(history);
+    history_resetDirty(history);
+    return 0;
+}
+
+/**
+ * Crée un historique d'annulation vide
+ *
+ * @param maxBytes Mémoire maximale des tuiles conservées (en octets)
+ * @return t_history*: Pointeur vers l'historique créé ou NULL en cas d'erreur
+ */
+t_history *history_create(size_t maxBytes) {
+    t_history *history = (t_history *) calloc(1, sizeof(t_history));
+    if (history == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'historique\n");
+        return NULL;
+    }
+
+    history->capacity = 16;
+    history->states = (t_history_state *) malloc(history->capacity * sizeof(t_history_state));
+    if (history->states == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'historique\n");
+        free(history);
+        return NULL;
+    }
+    history->current = -1;
+    history->maxBytes = maxBytes;
+    return history;
+}
+
+/**
+ * Vide l'historique
+ *
+ * @param history L'historique
+ */
+void history_clear(t_history *history) {
+    if (history == NULL) return;
+
+    for (int i = 0; i < history->count; i++) {
+        history_releaseState(history, &history->states[i]);
+    }
+    history->count = 0;
+    history->current = -1;
+    history->dirtyMarked = 0;
+}
+
+/**
+ * Libère un historique et toutes ses tuiles
+ *
+ * @param history L'historique à libérer
+ */
+void history_destroy(t_history *history) {
+    if (history == NULL) return;
+
+    history_clear(history);
+    free(history->dirty);
+    free(history->states);
+    free(history);
+}
+
+/**
+ * Déclare un rectangle de l'image courante modifié depuis la dernière étape
+ *
+ * @param history L'historique
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ */
+void history_markDirty(t_history *history, int x, int y, int width, int height) {
+    if (history == NULL || history->current < 0 || history->dirty == NULL) return;
+    const t_history_state *state = &history->states[history->current];
+
+    // Rectangle ramené à l'image
+    if (x < 0) {
+        width += x;
+        x = 0;
+    }
+    if (y < 0) {
+        height += y;
+        y = 0;
+    }
+    if (width > state->width - x) width = state->width - x;
+    if (height > state->height - y) height = state->height - y;
+    if (width <= 0 || height <= 0) return;
+
+    // Tuiles dans l'ordre des rangées stockées : de bas en haut pour une image 8 bits
+    if (state->depth == 8) y = state->height - y - height;
+
+    for (int ty = y / HISTORY_TILE; ty <= (y + height - 1) / HISTORY_TILE; ty++) {
+        for (int tx = x / HISTORY_TILE; tx <= (x + width - 1) / HISTORY_TILE; tx++) {
+            history->dirty[ty * state->tilesX + tx] = 1;
+        }
+    }
+    history->dirtyMarked = 1;
+}
+
+/**
+ * Ajoute l'état courant d'une image 8 bits comme nouvelle étape
+ *
+ * @param history L'historique
+ * @param img L'image (palette en attente appliquée aux pixels)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int history_commitBmp8(t_history *history, t_bmp8 *img) {
+    if (history == NULL || img == NULL || img->data == NULL) return -1;
+    // Une table en attente vient d'une opération ponctuelle sur toute l'image depuis la dernière étape
+    if (img->lutPending) history->dirtyMarked = 0;
+    bmp8_resolvePalette(img); // Les tuiles conservent les intensités réelles
+
+    t_history_state state;
+    memset(&state, 0, sizeof(state));
+    state.depth = 8;
+    state.width = (int) img->width;
+    state.height = (int) img->height;
+    state.colorDepth = (int) img->colorDepth;
+    state.topDown = img->topDown;
+    memcpy(state.header8, img->header, sizeof(state.header8));
+    memcpy(state.colorTable, img->colorTable, sizeof(state.colorTable));
+    return history_commit(history, &state, history_pixelsBmp8(img));
+}
+
+/**
+ * Ajoute l'état courant d'une image 24 bits comme nouvelle étape
+ *
+ * @param history L'historique
+ * @param img L'image
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int history_commitBmp24(t_history *history, const t_bmp24 *img) {
+    if (history == NULL || img == NULL || img->data == NULL) return -1;
+
+    t_history_state state;
+    memset(&state, 0, sizeof(state));
+    state.depth = 24;
+    state.width = img->width;
+    state.height = img->height;
+    state.colorDepth = img->colorDepth;
+    state.topDown = img->topDown;
+    state.header = img->header;
+    state.headerInfo = img->header_info;
+    memcpy(state.masks, img->masks, sizeof(state.masks));
+    return history_commit(history, &state, history_pixelsBmp24(img));
+}
+
+/**
+ * Passe de l'étape courante à une autre étape
+ *
+ * @param history L'historique
+ * @param target L'étape à afficher
+ * @param img Image 8 bits courante (ou NULL), remplacée au besoin
+ * @param img24 Image 24 bits courante (ou NULL), remplacée au besoin
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int history_moveTo(t_history *history, int target, t_bmp8 **img, t_bmp24 **img24) {
+    const t_history_state *from = &history->states[history->current];
+    const t_history_state *to = &history->states[target];
+
+    // Même géométrie : l'image courante correspond à from, seules les tuiles non partagées sont recopiées
+    int inPlace = from->depth == to->depth && from->width == to->width && from->height == to->height &&
+                  (to->depth == 8 ? *img != NULL : *img24 != NULL);
+    t_bmp8 *dst8 = inPlace ? *img : NULL;
+    t_bmp24 *dst24 = inPlace ? *img24 : NULL;
+    if (!inPlace) {
+        if (to->depth == 8) dst8 = bmp8_allocate((unsigned int) to->width, (unsigned int) to->height);
+        else dst24 = bmp24_allocate(to->width, to->height, to->colorDepth);
+        if (dst8 == NULL && dst24 == NULL) return -1;
+    }
+
+    t_history_pixels pixels = dst8 != NULL ? history_pixelsBmp8(dst8) : history_pixelsBmp24(dst24);
+    for (int i = 0; i < to->tilesX * to->tilesY; i++) {
+        if (inPlace && to->tiles[i] == from->tiles[i]) continue;
+        int x, y, width, height;
+        history_tileRect(to, i, &x, &y, &width, &height);
+        history_writeTile(to->tiles[i], pixels, x, y, width, height);
+    }
+
+    if (dst8 != NULL) {
+        memcpy(dst8->header, to->header8, sizeof(dst8->header));
+        memcpy(dst8->colorTable, to->colorTable, sizeof(dst8->colorTable));
+        dst8->colorDepth = (unsigned int) to->colorDepth;
+        dst8->topDown = to->topDown;
+        bmp8_invalidateCache(dst8);
+    } else {
+        dst24->header = to->header;
+        dst24->header_info = to->headerInfo;
+        dst24->colorDepth = to->colorDepth;
+        memcpy(dst24->masks, to->masks, sizeof(dst24->masks));
+        dst24->topDown = to->topDown;
+    }
+
+    if (!inPlace) {
+        bmp8_free(*img);
+        bmp24_free(*img24);
+        *img = dst8;
+        *img24 = dst24;
+    }
+    history->current = target;
+    history_resetDirty(history);
+    return 0;
+}
+
+/**
+ * Revient à l'étape précédente
+ *
+ * @param history L'historique
+ * @param img Image 8 bits courante (ou NULL), remplacée au besoin
+ * @param img24 Image 24 bits courante (ou NULL), remplacée au besoin
+ * @return int: 0 en cas de succès, -1 s'il n'y a rien à annuler ou en cas d'erreur
+ */
+int history_undo(t_history *history, t_bmp8 **img, t_bmp24 **img24) {
+    if (history == NULL || history->current <= 0) return -1;
+    return history_moveTo(history, history->current - 1, img, img24);
+}
+
+/**
+ * Rétablit l'étape suivante
+ *
+ * @param history L'historique
+ * @param img Image 8 bits courante (ou NULL), remplacée au besoin
+ * @param img24 Image 24 bits courante (ou NULL), remplacée au besoin
+ * @return int: 0 en cas de succès, -1 s'il n'y a rien à rétablir ou en cas d'erreur
+ */
+int history_redo(t_history *history, t_bmp8 **img, t_bmp24 **img24) {
+    if (history == NULL || history->current < 0 || history->current + 1 >= history->count) return -1;
+    return history_moveTo(history, history->current + 1, img, img24);
+}
+
+/**
+ * Affiche les statistiques d'un historique
+ *
+ * @param history L'historique
+ */
+void history_printStats(const t_history *history) {
+    if (history == NULL) {
+        printf("⚠️ Historique non valide\n");
+        return;
+    }
+
+    // Mémoire qu'occuperaient des copies complètes de chaque étape
+    size_t fullBytes = 0;
+    for (int i = 0; i < history->count; i++) {
+        const t_history_state *state = &history->states[i];
+        fullBytes += (size_t) state->width * state->height * (state->depth == 8 ? 1 : sizeof(t_pixel));
+    }
+
+    unsigned long total = history->tilesCopied + history->tilesShared;
+    printf("Étapes: %d (courante: %d)\n", history->count, history->current + 1);
+    printf("Tuiles: %lu copiées, %lu partagées (%.1f%%)\n", history->tilesCopied, history->tilesShared,
+           total > 0 ? 100.0 * history->tilesShared / total : 0.0);
+    printf("Mémoire des tuiles: %zu / %zu octets (copies complètes : %zu octets)\n", history->tileBytes,
+           history->maxBytes, fullBytes);
+}
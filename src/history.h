@@ -0,0 +1,152 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bmp8.h"
+#include "color.h"
+
+// Historique d'annulation par instantanés découpés en tuiles partagées (copie sur écriture) :
+// un instantané ne copie que les tuiles modifiées depuis l'état précédent et partage les autres
+// (compteur de références). La mémoire de l'historique suit donc la surface réellement modifiée,
+// pas le nombre d'étapes multiplié par la taille de l'image.
+// Les zones modifiées sont déclarées par history_markDirty au moment du traitement : un instantané
+// ne fait qu'incrémenter le compteur des tuiles intactes et copier les tuiles marquées, sans relire
+// les autres pixels. Sans zone déclarée, toute l'image est considérée comme modifiée.
+
+#define HISTORY_TILE 64 // Côté d'une tuile en pixels
+
+// Tuile de pixels partagée entre instantanés (rangées de la tuile consécutives, sans bourrage)
+typedef struct {
+    int refs; // Nombre d'instantanés qui utilisent la tuile
+    size_t size; // Taille des pixels en octets
+    unsigned char data[]; // Pixels
+} t_history_tile;
+
+// État complet d'une image à une étape
+typedef struct {
+    int depth; // 8 (t_bmp8) ou 24 (t_bmp24)
+    int width;
+    int height;
+    int tilesX; // Tuiles par rangée de tuiles
+    int tilesY;
+    t_history_tile **tiles; // tilesX * tilesY tuiles, dans l'ordre des rangées stockées
+
+    // Paramètres d'enregistrement de l'image
+    int colorDepth;
+    int topDown;
+    unsigned char header8[54]; // En-tête d'une image 8 bits
+    unsigned char colorTable[1024]; // Palette d'une image 8 bits
+    t_bmp_header header; // En-têtes d'une image 24 bits
+    t_bmp_info headerInfo;
+    uint32_t masks[4];
+} t_history_state;
+
+typedef struct {
+    t_history_state *states; // Étapes, de la plus ancienne à la plus récente
+    int count;
+    int capacity;
+    int current; // Étape affichée (-1 si l'historique est vide) ; les suivantes peuvent être rétablies
+    size_t maxBytes; // Mémoire maximale des tuiles conservées (les étapes les plus anciennes sont oubliées)
+    size_t tileBytes; // Mémoire actuellement occupée par les tuiles
+
+    // Tuiles de l'étape courante modifiées depuis (déclarées par history_markDirty)
+    unsigned char *dirty; // Une marque par tuile, dans l'ordre des tuiles de l'étape courante
+    int dirtyCapacity; // Nombre de marques allouées
+    int dirtyMarked; // 1 si une zone a été déclarée depuis l'étape courante
+
+    // Statistiques
+    unsigned long tilesCopied; // Tuiles copiées par les instantanés
+    unsigned long tilesShared; // Tuiles partagées avec l'étape précédente
+} t_history;
+
+/**
+ * Crée un historique d'annulation vide
+ *
+ * @param maxBytes Mémoire maximale des tuiles conservées (en octets)
+ * @return t_history*: Pointeur vers l'historique créé ou NULL en cas d'erreur
+ */
+t_history *history_create(size_t maxBytes);
+
+/**
+ * Libère un historique et toutes ses tuiles
+ *
+ * @param history L'historique à libérer
+ */
+void history_destroy(t_history *history);
+
+/**
+ * Vide l'historique (nouvelle image chargée par exemple)
+ *
+ * @param history L'historique
+ */
+void history_clear(t_history *history);
+
+/**
+ * Déclare un rectangle de l'image courante modifié depuis la dernière étape (à appeler par le traitement
+ * qui écrit dans une vue, avant l'instantané suivant). Les rectangles déclarés s'additionnent ;
+ * sans déclaration, l'instantané suivant copie toute l'image.
+ *
+ * @param history L'historique
+ * @param x Colonne du coin supérieur gauche
+ * @param y Rangée du coin supérieur gauche (0 = haut de l'image, comme bmp8_view et bmp24_view)
+ * @param width Largeur du rectangle
+ * @param height Hauteur du rectangle
+ */
+void history_markDirty(t_history *history, int x, int y, int width, int height);
+
+/**
+ * Ajoute l'état courant d'une image 8 bits comme nouvelle étape (les étapes annulées sont oubliées).
+ * Seules les tuiles déclarées par history_markDirty sont copiées, les autres sont partagées avec
+ * l'étape précédente ; l'image entière est copiée si ses dimensions ou sa profondeur ont changé
+ * ou si une table de palette est en attente (opération ponctuelle sur toute l'image).
+ * En cas d'erreur, la dernière étape ne correspond plus à l'image : vider l'historique avant d'annuler.
+ *
+ * @param history L'historique
+ * @param img L'image (palette en attente appliquée aux pixels)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int history_commitBmp8(t_history *history, t_bmp8 *img);
+
+/**
+ * Ajoute l'état courant d'une image 24 bits comme nouvelle étape (les étapes annulées sont oubliées),
+ * en ne copiant que les tuiles déclarées par history_markDirty comme pour history_commitBmp8.
+ * En cas d'erreur, la dernière étape ne correspond plus à l'image : vider l'historique avant d'annuler.
+ *
+ * @param history L'historique
+ * @param img L'image
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int history_commitBmp24(t_history *history, const t_bmp24 *img);
+
+/**
+ * Revient à l'étape précédente. Seules les tuiles qui diffèrent entre les deux étapes sont recopiées ;
+ * si la profondeur ou les dimensions changent, l'image est remplacée par une nouvelle image.
+ * Les zones déclarées par history_markDirty depuis la dernière étape sont oubliées.
+ *
+ * @param history L'historique
+ * @param img Image 8 bits courante (ou NULL), remplacée au besoin
+ * @param img24 Image 24 bits courante (ou NULL), remplacée au besoin
+ * @return int: 0 en cas de succès, -1 s'il n'y a rien à annuler ou en cas d'erreur
+ */
+int history_undo(t_history *history, t_bmp8 **img, t_bmp24 **img24);
+
+/**
+ * Rétablit l'étape suivante (annulée par history_undo)
+ *
+ * @param history L'historique
+ * @param img Image 8 bits courante (ou NULL), remplacée au besoin
+ * @param img24 Image 24 bits courante (ou NULL), remplacée au besoin
+ * @return int: 0 en cas de succès, -1 s'il n'y a rien à rétablir ou en cas d'erreur
+ */
+int history_redo(t_history *history, t_bmp8 **img, t_bmp24 **img24);
+
+/**
+ * Affiche les statistiques d'un historique (étapes, tuiles copiées et partagées, mémoire)
+ *
+ * @param history L'historique
+ */
+void history_printStats(const t_history *history);
+
+#endif //HISTORY_H
@@ -0,0 +1,190 @@
+#include "job.h"
+#include "histogram.h"
+#include "shm.h"
+#include "utils/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Applique un filtre nommé à une image 8 ou 24 bits (l'autre pointeur est NULL)
+ *
+ * @param name Le nom du filtre
+ * @param img L'image 8 bits ou NULL
+ * @param img24 L'image 24 bits ou NULL
+ * @return int: 0 en cas de succès, -1 si le filtre est inconnu
+ */
+int job_applyFilter(const char *name, t_bmp8 *img, t_bmp24 *img24) {
+    if (strcmp(name, "negatif") == 0) {
+        if (img24 != NULL) bmp24_negative(img24);
+        else bmp8_negative(img);
+    } else if (strcmp(name, "luminosite") == 0) {
+        if (img24 != NULL) bmp24_brightness(img24, 50);
+        else bmp8_brightness(img, 50);
+    } else if (strcmp(name, "binarisation") == 0 && img != NULL) {
+        bmp8_threshold(img, 128);
+    } else if (strcmp(name, "flou") == 0) {
+        if (img24 != NULL) bmp24_boxBlur(img24);
+        else bmp8_box_blur(img);
+    } else if (strcmp(name, "gaussien") == 0) {
+        if (img24 != NULL) bmp24_gaussianBlur(img24);
+        else bmp8_gaussian_blur(img);
+    } else if (strcmp(name, "contour") == 0) {
+        if (img24 != NULL) bmp24_outline(img24);
+        else bmp8_outline(img);
+    } else if (strcmp(name, "relief") == 0) {
+        if (img24 != NULL) bmp24_emboss(img24);
+        else bmp8_emboss(img);
+    } else if (strcmp(name, "nettete") == 0) {
+        if (img24 != NULL) bmp24_sharpen(img24);
+        else bmp8_sharpen(img);
+    } else if (strcmp(name, "egalisation") == 0) {
+        if (img24 != NULL) bmp24_equalize(img24);
+        else bmp8_equalize(img);
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Écrit un fichier BMP déjà encodé (résultat trouvé dans le cache)
+ *
+ * @param path Chemin complet du fichier
+ * @param data Le fichier BMP
+ * @param size Taille du fichier
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int job_writeFile(const char *path, const unsigned char *data, size_t size) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return -1;
+    int written = fwrite(data, 1, size, file) == size;
+    return fclose(file) == 0 && written ? 0 : -1;
+}
+
+/**
+ * Vérifie qu'un nom de fichier désigne bien un fichier de ./images : ni séparateur, ni ".."
+ *
+ * @param name Le nom reçu (ligne de commande ou requête du serveur)
+ * @return int: 1 si le nom est accepté, 0 sinon
+ */
+static int job_isPlainName(const char *name) {
+    return name[0] != '\0' && strchr(name, '/') == NULL && strchr(name, '\\') == NULL && strstr(name, "..") == NULL;
+}
+
+/**
+ * Applique les filtres sur place à l'image d'un segment partagé, puis publie la trame
+ *
+ * @param name Nom POSIX du segment ("/nom")
+ * @param output Fichier où sauvegarder aussi le résultat, ou "-"
+ * @param filters Les noms des filtres
+ * @param count Nombre de filtres
+ * @param error Reçoit la cause de l'échec (peut être NULL)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int job_runShared(const char *name, const char *output, char **filters, int count, const char **error) {
+    if (strcmp(output, "-") != 0 && !job_isPlainName(output)) {
+        if (error != NULL) *error = "nom de fichier invalide (« / » et « .. » interdits)";
+        return -1;
+    }
+
+    t_shm_image *image = shm_attach(name);
+    if (image == NULL) {
+        if (error != NULL) *error = "segment partagé introuvable ou non valide";
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (job_applyFilter(filters[i], image->img8, image->img24) != 0) {
+            if (error != NULL) *error = "filtre inconnu ou non applicable";
+            shm_detach(image);
+            return -1;
+        }
+    }
+
+    if (strcmp(output, "-") != 0) {
+        if (image->img8 != NULL) bmp8_saveImage(image->img8, output);
+        else bmp24_saveImage(image->img24, output);
+    }
+    shm_publish(image);
+    shm_detach(image);
+    return 0;
+}
+
+/**
+ * Charge une image BMP, applique les filtres dans l'ordre et sauvegarde le résultat
+ *
+ * @param input Le fichier d'entrée (dans ./images/...), ou "shm:/nom" pour filtrer sur place un segment partagé
+ * @param output Le fichier de sortie (dans ./images/...), ou "-" pour une entrée partagée sans sauvegarde
+ * @param filters Les noms des filtres
+ * @param count Nombre de filtres
+ * @param cache Le cache de résultats ou NULL
+ * @param cached Reçoit 1 si le résultat vient du cache, 0 sinon (peut être NULL)
+ * @param error Reçoit la cause de l'échec (peut être NULL)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int job_run(const char *input, const char *output, char **filters, int count, t_result_cache *cache, int *cached,
+            const char **error) {
+    const char *cause = NULL;
+    if (cached != NULL) *cached = 0;
+
+    // Entrée "shm:/nom" : image d'un segment partagé, filtrée sur place sans chargement ni cache
+    if (strncmp(input, "shm:", 4) == 0) return job_runShared(input + 4, output, filters, count, error);
+
+    // Noms pris tels quels après "../images/" : un chemin ne doit pas en sortir
+    if (!job_isPlainName(input) || !job_isPlainName(output)) {
+        if (error != NULL) *error = "nom de fichier invalide (« / » et « .. » interdits)";
+        return -1;
+    }
+
+    BMP_Type type = bmp_getFileType(input);
+    if (type != BMP_8BIT && type != BMP_24BIT) {
+        if (error != NULL) *error = "impossible de charger l'image";
+        return -1;
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "../images/%s", output);
+
+    // Clé calculée sur les octets du fichier d'entrée : un résultat en cache est rendu sans décoder l'image
+    t_cache_key key = {0, 0};
+    int keyed = 0;
+    if (cache != NULL) {
+        char inputPath[512];
+        snprintf(inputPath, sizeof(inputPath), "../images/%s", input);
+        keyed = cache_keyFile(inputPath, cache_chainHash(filters, count), &key) == 0;
+
+        size_t size;
+        unsigned char *result = keyed ? cache_lookup(cache, key, &size) : NULL;
+        if (result != NULL) {
+            if (job_writeFile(path, result, size) != 0) cause = "impossible de créer le fichier de sortie";
+            else if (cached != NULL) *cached = 1;
+            free(result);
+            if (cause != NULL && error != NULL) *error = cause;
+            return cause != NULL ? -1 : 0;
+        }
+    }
+
+    t_bmp8 *img = type == BMP_8BIT ? bmp8_loadImage(input) : NULL;
+    t_bmp24 *img24 = type == BMP_24BIT ? bmp24_loadImage(input) : NULL;
+    if (img == NULL && img24 == NULL) {
+        if (error != NULL) *error = "impossible de charger l'image";
+        return -1;
+    }
+
+    for (int i = 0; i < count && cause == NULL; i++) {
+        if (job_applyFilter(filters[i], img, img24) != 0) cause = "filtre inconnu ou non applicable";
+    }
+
+    if (cause == NULL) {
+        if (img != NULL) bmp8_saveImage(img, output);
+        else bmp24_saveImage(img24, output);
+        if (keyed) cache_storeFile(cache, key, path);
+    }
+    bmp8_free(img);
+    bmp24_free(img24);
+
+    if (cause != NULL && error != NULL) *error = cause;
+    return cause != NULL ? -1 : 0;
+}
@@ -0,0 +1,41 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include "bmp8.h"
+#include "cache.h"
+#include "color.h"
+
+// Traitement d'un fichier par une chaîne de filtres nommés, commun aux modes --pipe, --apply
+// et au serveur de traitements.
+// Filtres : negatif, luminosite, binarisation (8 bits), flou, gaussien, contour, relief, nettete, egalisation
+
+/**
+ * Applique un filtre nommé à une image 8 ou 24 bits (l'autre pointeur est NULL)
+ *
+ * @param name Le nom du filtre
+ * @param img L'image 8 bits ou NULL
+ * @param img24 L'image 24 bits ou NULL
+ * @return int: 0 en cas de succès, -1 si le filtre est inconnu
+ */
+int job_applyFilter(const char *name, t_bmp8 *img, t_bmp24 *img24);
+
+/**
+ * Charge une image BMP, applique les filtres dans l'ordre et sauvegarde le résultat.
+ * Une entrée partagée (shm.h) est filtrée sur place puis la trame est publiée.
+ * Avec un cache, le résultat est d'abord cherché (clé : pixels de l'entrée et chaîne de filtres)
+ * et recopié tel quel s'il y est, sans aucun traitement ; sinon il y est ajouté.
+ * Les noms de fichiers contenant "/" ou ".." sont refusés (ils sortiraient de ./images).
+ *
+ * @param input Le fichier d'entrée (dans ./images/...), ou "shm:/nom" pour filtrer sur place un segment partagé
+ * @param output Le fichier de sortie (dans ./images/...), ou "-" pour une entrée partagée sans sauvegarde
+ * @param filters Les noms des filtres
+ * @param count Nombre de filtres
+ * @param cache Le cache de résultats ou NULL
+ * @param cached Reçoit 1 si le résultat vient du cache, 0 sinon (peut être NULL)
+ * @param error Reçoit la cause de l'échec (peut être NULL)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int job_run(const char *input, const char *output, char **filters, int count, t_result_cache *cache, int *cached,
+            const char **error);
+
+#endif //JOB_H
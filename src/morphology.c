@@ -0,0 +1,717 @@
+#include "morphology.h"
+#include "arena.h"
+#include "trace.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Applique l'opérateur morphologique élémentaire (min pour l'érosion, max pour la dilatation)
+ *
+ * @param a Première valeur
+ * @param b Seconde valeur
+ * @param isMax 1 pour la dilatation (max), 0 pour l'érosion (min)
+ * @return unsigned char: Le résultat de l'opérateur
+ */
+static inline unsigned char morph_op(unsigned char a, unsigned char b, int isMax) {
+    if (isMax) return a > b ? a : b;
+    return a < b ? a : b;
+}
+
+/**
+ * Applique l'opérateur élément par élément sur deux rangées : dst = op(a, b)
+ *
+ * @param dst La rangée destination (peut être égale à a)
+ * @param a Première rangée
+ * @param b Seconde rangée
+ * @param width Nombre de pixels
+ * @param isMax 1 pour max, 0 pour min
+ */
+static void morph_opRow(unsigned char *dst, const unsigned char *a, const unsigned char *b, int width, int isMax) {
+    if (isMax) {
+        for (int x = 0; x < width; x++) dst[x] = a[x] > b[x] ? a[x] : b[x];
+    } else {
+        for (int x = 0; x < width; x++) dst[x] = a[x] < b[x] ? a[x] : b[x];
+    }
+}
+
+/**
+ * Passe horizontale de van Herk/Gil-Werman sur une rangée
+ *
+ * La rangée (complétée par l'élément neutre) est découpée en segments de k pixels.
+ * Pour chaque segment on calcule le min/max cumulé depuis la gauche (g) et depuis
+ * la droite (h) ; la fenêtre [x, x + k - 1] vaut alors op(h[x], g[x + k - 1]),
+ * soit 3 comparaisons par pixel quel que soit k.
+ *
+ * @param row La rangée à modifier
+ * @param width Nombre de pixels de la rangée
+ * @param k Taille de la fenêtre
+ * @param a Ancre de la fenêtre : le pixel x reçoit le résultat de [x - a, x - a + k - 1]
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ * @param p Tampon de travail (au moins paddedLength octets)
+ * @param g Tampon de travail (au moins paddedLength octets)
+ * @param h Tampon de travail (au moins paddedLength octets)
+ * @param paddedLength Longueur complétée, multiple de k et >= width + k - 1
+ */
+static void morph_line(unsigned char *row, int width, int k, int a, int isMax,
+                       unsigned char *p, unsigned char *g, unsigned char *h, int paddedLength) {
+    unsigned char identity = isMax ? 0 : 255;
+
+    // Rangée complétée par l'élément neutre de chaque côté
+    memset(p, identity, paddedLength);
+    memcpy(p + a, row, width);
+
+    for (int start = 0; start < paddedLength; start += k) {
+        g[start] = p[start];
+        for (int i = start + 1; i < start + k; i++) g[i] = morph_op(g[i - 1], p[i], isMax);
+
+        h[start + k - 1] = p[start + k - 1];
+        for (int i = start + k - 2; i >= start; i--) h[i] = morph_op(h[i + 1], p[i], isMax);
+    }
+
+    for (int x = 0; x < width; x++) {
+        row[x] = morph_op(h[x], g[x + k - 1], isMax);
+    }
+}
+
+/**
+ * Passe verticale de van Herk/Gil-Werman, appliquée à des rangées entières
+ *
+ * Même principe que morph_line mais chaque « élément » est une rangée complète, ce qui
+ * donne des boucles internes contiguës. Seuls les cumuls h de deux segments et le cumul g
+ * courant sont conservés, et l'ordre des calculs garantit que chaque rangée source est lue
+ * avant d'être écrasée : l'opération se fait en place.
+ *
+ * @param data Les données de l'image
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Nombre d'octets entre une rangée et la suivante (négatif si l'image est stockée de bas en haut)
+ * @param k Hauteur de la fenêtre
+ * @param a Ancre de la fenêtre : la rangée y reçoit le résultat de [y - a, y - a + k - 1]
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int morph_columns(unsigned char *data, int width, int height, int stride, int k, int a, int isMax) {
+    if (k <= 1) return 0;
+
+    unsigned char *identity = scratch_alloc(width);
+    unsigned char *hBuf = scratch_alloc((size_t) 2 * k * width);
+    unsigned char *gRow = scratch_alloc(width);
+    if (identity == NULL || hBuf == NULL || gRow == NULL) {
+        scratch_free(identity);
+        scratch_free(hBuf);
+        scratch_free(gRow);
+        return -1;
+    }
+    memset(identity, isMax ? 0 : 255, width);
+
+    // Rangée i de l'image complétée : les a premières et les dernières sont neutres
+#define MORPH_ROW(i) (((i) >= a && (i) - a < height) ? data + (ptrdiff_t) ((i) - a) * stride : identity)
+
+    // Cumul depuis la droite pour le segment s
+#define MORPH_SEGMENT_H(s) do { \
+        unsigned char *seg = hBuf + (size_t) ((s) & 1) * k * width; \
+        int base = (s) * k; \
+        memcpy(seg + (size_t) (k - 1) * width, MORPH_ROW(base + k - 1), width); \
+        for (int t = k - 2; t >= 0; t--) { \
+            morph_opRow(seg + (size_t) t * width, seg + (size_t) (t + 1) * width, MORPH_ROW(base + t), width, isMax); \
+        } \
+    } while (0)
+
+    // Cumul depuis la gauche jusqu'à la fin du premier segment
+    memcpy(gRow, MORPH_ROW(0), width);
+    for (int t = 1; t < k; t++) morph_opRow(gRow, gRow, MORPH_ROW(t), width, isMax);
+
+    MORPH_SEGMENT_H(0);
+
+    for (int s = 0; s * k < height; s++) {
+        // Les rangées du segment suivant sont lues avant toute écriture dans ce segment
+        MORPH_SEGMENT_H(s + 1);
+        const unsigned char *hSeg = hBuf + (size_t) (s & 1) * k * width;
+        int next = (s + 1) * k;
+
+        for (int t = 0; t < k; t++) {
+            int y = s * k + t;
+            if (y >= height) break;
+
+            if (t == 1) memcpy(gRow, MORPH_ROW(next), width);
+            else if (t > 1) morph_opRow(gRow, gRow, MORPH_ROW(next + t - 1), width, isMax);
+
+            morph_opRow(data + (ptrdiff_t) y * stride, hSeg + (size_t) t * width, gRow, width, isMax);
+        }
+
+        // Compléter le cumul gauche jusqu'à la fin du segment suivant
+        morph_opRow(gRow, gRow, MORPH_ROW(next + k - 1), width, isMax);
+    }
+
+#undef MORPH_SEGMENT_H
+#undef MORPH_ROW
+
+    scratch_free(identity);
+    scratch_free(hBuf);
+    scratch_free(gRow);
+    return 0;
+}
+
+/**
+ * Vérifie si une image ne contient que des 0 et des 255 (masque binaire)
+ *
+ * @param data Les données de l'image
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Nombre d'octets entre une rangée et la suivante (négatif si l'image est stockée de bas en haut)
+ * @return int: 1 si l'image est binaire, 0 sinon
+ */
+static int morph_isBinary(const unsigned char *data, int width, int height, int stride) {
+    for (int y = 0; y < height; y++) {
+        const unsigned char *row = data + (ptrdiff_t) y * stride;
+        unsigned char other = 0;
+        for (int x = 0; x < width; x++) {
+            // Vaut 0 pour 0 et 255, non nul pour toute autre valeur
+            other |= (unsigned char) (row[x] + 1) & 0xFE;
+        }
+        if (other) return 0;
+    }
+    return 1;
+}
+
+/**
+ * Décale une rangée de bits vers le début et la combine avec elle-même :
+ * bits[x] = op(bits[x], bits[x + shift]), en place
+ *
+ * @param bits La rangée de bits (bit x dans le mot x / 64, position x % 64)
+ * @param words Nombre de mots de 64 bits
+ * @param shift Décalage en bits
+ * @param identity Mot neutre utilisé au-delà de la fin de la rangée
+ * @param isMax 1 pour OU (dilatation), 0 pour ET (érosion)
+ */
+static void morph_bitsShiftCombine(uint64_t *bits, int words, int shift, uint64_t identity, int isMax) {
+    int ws = shift / 64;
+    int bs = shift % 64;
+
+    for (int w = 0; w < words; w++) {
+        uint64_t lo = (w + ws < words) ? bits[w + ws] : identity;
+        uint64_t shifted = lo;
+        if (bs != 0) {
+            uint64_t hi = (w + ws + 1 < words) ? bits[w + ws + 1] : identity;
+            shifted = (lo >> bs) | (hi << (64 - bs));
+        }
+        bits[w] = isMax ? (bits[w] | shifted) : (bits[w] & shifted);
+    }
+}
+
+/**
+ * Érosion/dilatation d'un masque compacté déjà entouré de sa marge
+ *
+ * Une fenêtre de k pixels est obtenue par doublements successifs
+ * (fenêtres 1, 2, 4, ... puis un dernier recouvrement), soit O(log k)
+ * opérations sur des mots de 64 bits, horizontalement puis verticalement.
+ * La colonne x doit être placée au bit x + aW et la rangée y à la rangée y + aH
+ * (ancre de l'élément structurant), la marge valant identity ; le résultat du pixel (x, y) se lit
+ * ensuite au bit x de la rangée y.
+ *
+ * @param bits Les rangées compactées
+ * @param words Nombre de mots de 64 bits par rangée
+ * @param rows Nombre de rangées (hauteur + seHeight - 1)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param identity Mot neutre (0 pour la dilatation, tous les bits à 1 pour l'érosion)
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ */
+static void morph_packedWindow(uint64_t *bits, int words, int rows, int seWidth, int seHeight,
+                               uint64_t identity, int isMax) {
+    // Passe horizontale : fenêtre [x, x + seWidth - 1]
+    for (int r = 0; r < rows; r++) {
+        uint64_t *packed = bits + (size_t) r * words;
+        int span = 1;
+        while (2 * span <= seWidth) {
+            morph_bitsShiftCombine(packed, words, span, identity, isMax);
+            span *= 2;
+        }
+        if (span < seWidth) morph_bitsShiftCombine(packed, words, seWidth - span, identity, isMax);
+    }
+
+    // Passe verticale : rangée r combinée avec les rangées [r, r + seHeight - 1]
+    int span = 1;
+    while (span < seHeight) {
+        int step = (2 * span <= seHeight) ? span : seHeight - span;
+        for (int r = 0; r + step < rows; r++) {
+            uint64_t *dst = bits + (size_t) r * words;
+            const uint64_t *src = bits + (size_t) (r + step) * words;
+            for (int w = 0; w < words; w++) dst[w] = isMax ? (dst[w] | src[w]) : (dst[w] & src[w]);
+        }
+        span += step;
+    }
+}
+
+/**
+ * Érosion/dilatation rapide d'un masque binaire, compacté le temps du calcul (64 pixels par mot)
+ *
+ * @param data Les données de l'image (valeurs 0 ou 255)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Nombre d'octets entre une rangée et la suivante (négatif si l'image est stockée de bas en haut)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param aW Ancre horizontale de l'élément structurant
+ * @param aH Ancre verticale de l'élément structurant
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int morph_binary(unsigned char *data, int width, int height, int stride,
+                        int seWidth, int seHeight, int aW, int aH, int isMax) {
+    int words = (width + seWidth - 1 + 63) / 64;
+    int rows = height + seHeight - 1;
+    uint64_t identity = isMax ? 0 : ~(uint64_t) 0;
+
+    uint64_t *bits = scratch_alloc((size_t) rows * words * sizeof(uint64_t));
+    if (bits == NULL) return -1;
+
+    // Compactage : la colonne x est placée au bit x + aW, la rangée y à la rangée y + aH
+    for (int r = 0; r < rows; r++) {
+        uint64_t *packed = bits + (size_t) r * words;
+        for (int w = 0; w < words; w++) packed[w] = identity;
+
+        int y = r - aH;
+        if (y < 0 || y >= height) continue;
+
+        const unsigned char *row = data + (ptrdiff_t) y * stride;
+        for (int x = 0; x < width; x++) {
+            int b = x + aW;
+            uint64_t mask = (uint64_t) 1 << (b % 64);
+            if (row[x]) packed[b / 64] |= mask;
+            else packed[b / 64] &= ~mask;
+        }
+    }
+
+    morph_packedWindow(bits, words, rows, seWidth, seHeight, identity, isMax);
+
+    // Décompactage
+    for (int y = 0; y < height; y++) {
+        const uint64_t *packed = bits + (size_t) y * words;
+        unsigned char *row = data + (ptrdiff_t) y * stride;
+        for (int x = 0; x < width; x++) {
+            row[x] = (packed[x / 64] >> (x % 64)) & 1 ? 255 : 0;
+        }
+    }
+
+    scratch_free(bits);
+    return 0;
+}
+
+/**
+ * Recopie count bits à partir du bit offset d'une rangée compactée (bits de destination remplacés)
+ *
+ * @param dst La rangée destination
+ * @param offset Position du premier bit écrit
+ * @param src Les bits à écrire (bit 0 du mot 0 en premier)
+ * @param count Nombre de bits
+ */
+static void morph_insertBits(uint64_t *dst, int offset, const uint64_t *src, int count) {
+    for (int w = 0; w * 64 < count; w++) {
+        int n = count - w * 64 < 64 ? count - w * 64 : 64;
+        uint64_t mask = n == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << n) - 1;
+        uint64_t value = src[w] & mask;
+        int p = offset + w * 64;
+        int s = p % 64;
+
+        dst[p / 64] = (dst[p / 64] & ~(mask << s)) | (value << s);
+        if (s != 0 && s + n > 64) {
+            dst[p / 64 + 1] = (dst[p / 64 + 1] & ~(mask >> (64 - s))) | (value >> (64 - s));
+        }
+    }
+}
+
+/**
+ * Ancre d'un élément structurant de taille k : k / 2, ou (k - 1) / 2 pour l'élément réfléchi.
+ * Les deux ne diffèrent que pour une taille paire ; l'ouverture et la fermeture appliquent
+ * leur seconde étape avec l'élément réfléchi pour rester anti-extensive et extensive.
+ *
+ * @param k Taille de l'élément structurant
+ * @param reflect 1 pour l'élément réfléchi
+ * @return int: L'ancre
+ */
+static inline int morph_anchor(int k, int reflect) {
+    return reflect ? (k - 1) / 2 : k / 2;
+}
+
+/**
+ * Érode ou dilate un bloc de pixels avec un élément structurant rectangulaire
+ *
+ * @param data Les données de l'image
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Nombre d'octets entre une rangée et la suivante (négatif si l'image est stockée de bas en haut)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ * @param reflect 1 pour l'élément structurant réfléchi (seconde étape d'une ouverture ou fermeture)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int morph_apply(unsigned char *data, int width, int height, int stride,
+                       int seWidth, int seHeight, int isMax, int reflect) {
+    if (width <= 0 || height <= 0) return 0;
+
+    int aW = morph_anchor(seWidth, reflect);
+    int aH = morph_anchor(seHeight, reflect);
+    if (morph_isBinary(data, width, height, stride)) {
+        return morph_binary(data, width, height, stride, seWidth, seHeight, aW, aH, isMax);
+    }
+
+    if (seWidth > 1) {
+        int paddedLength = (width + seWidth - 1 + seWidth - 1) / seWidth * seWidth;
+        unsigned char *buffer = scratch_alloc((size_t) 3 * paddedLength);
+        if (buffer == NULL) return -1;
+
+        for (int y = 0; y < height; y++) {
+            morph_line(data + (ptrdiff_t) y * stride, width, seWidth, aW, isMax,
+                       buffer, buffer + paddedLength, buffer + 2 * paddedLength, paddedLength);
+        }
+        scratch_free(buffer);
+    }
+
+    return morph_columns(data, width, height, stride, seHeight, aH, isMax);
+}
+
+/**
+ * Vérifie la taille de l'élément structurant
+ *
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @return int: 1 si la taille est valide, 0 sinon
+ */
+static int morph_checkElement(int seWidth, int seHeight) {
+    if (seWidth < 1 || seHeight < 1) {
+        fprintf(stderr, "Taille d'élément structurant invalide (%d x %d)\n", seWidth, seHeight);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Renvoie la vue de l'image entière après vérification des paramètres
+ *
+ * @param img L'image à modifier
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @return t_view8: La vue (palette résolue), ou une vue vide si les paramètres sont invalides
+ */
+static t_view8 morph_wholeView(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 empty = {NULL, 0, 0, 0, NULL};
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Impossible d'appliquer une opération morphologique à une image NULL\n");
+        return empty;
+    }
+    if (!morph_checkElement(seWidth, seHeight)) return empty;
+
+    // Palette ramenée aux intensités réelles dont le voisinage a besoin ; ordre de stockage
+    // pour qu'un élément de taille paire garde son ancrage historique
+    return bmp8_storageView(img);
+}
+
+/**
+ * Érode une image BMP 8 bits avec un élément structurant rectangulaire
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_erode(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 view = morph_wholeView(img, seWidth, seHeight);
+    if (view.data != NULL) view8_erode(view, seWidth, seHeight);
+}
+
+/**
+ * Dilate une image BMP 8 bits avec un élément structurant rectangulaire
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_dilate(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 view = morph_wholeView(img, seWidth, seHeight);
+    if (view.data != NULL) view8_dilate(view, seWidth, seHeight);
+}
+
+/**
+ * Applique une ouverture morphologique (érosion puis dilatation)
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_open(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 view = morph_wholeView(img, seWidth, seHeight);
+    if (view.data != NULL) view8_open(view, seWidth, seHeight);
+}
+
+/**
+ * Applique une fermeture morphologique (dilatation puis érosion)
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_close(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 view = morph_wholeView(img, seWidth, seHeight);
+    if (view.data != NULL) view8_close(view, seWidth, seHeight);
+}
+
+/**
+ * Calcule le gradient morphologique (dilatation - érosion)
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_morphGradient(t_bmp8 *img, int seWidth, int seHeight) {
+    t_view8 view = morph_wholeView(img, seWidth, seHeight);
+    if (view.data != NULL) view8_morphGradient(view, seWidth, seHeight);
+}
+
+/**
+ * Érode une vue d'image 8 bits (le voisinage est limité à la vue)
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_erode(t_view8 view, int seWidth, int seHeight) {
+    if (view.data == NULL || !morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("view8_erode");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    if (morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 0, 0) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'érosion\n");
+    }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height);
+}
+
+/**
+ * Dilate une vue d'image 8 bits (le voisinage est limité à la vue)
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_dilate(t_view8 view, int seWidth, int seHeight) {
+    if (view.data == NULL || !morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("view8_dilate");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    if (morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 1, 0) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la dilatation\n");
+    }
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height);
+}
+
+/**
+ * Applique une ouverture morphologique à une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_open(t_view8 view, int seWidth, int seHeight) {
+    if (view.data == NULL || !morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("view8_open");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    if (morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 0, 0) != 0 ||
+        morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 1, 1) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'ouverture\n");
+    }
+    TRACE_END(view.width, view.height, 4 * (size_t) view.width * view.height);
+}
+
+/**
+ * Applique une fermeture morphologique à une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_close(t_view8 view, int seWidth, int seHeight) {
+    if (view.data == NULL || !morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("view8_close");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    if (morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 1, 0) != 0 ||
+        morph_apply(view.data, view.width, view.height, view.stride, seWidth, seHeight, 0, 1) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la fermeture\n");
+    }
+    TRACE_END(view.width, view.height, 4 * (size_t) view.width * view.height);
+}
+
+/**
+ * Calcule le gradient morphologique d'une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_morphGradient(t_view8 view, int seWidth, int seHeight) {
+    if (view.data == NULL || !morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("view8_morphGradient");
+    if (view.image != NULL) bmp8_invalidateCache(view.image);
+    int width = view.width;
+    int height = view.height;
+
+    // Copie compacte qui recevra l'érosion pendant que la vue reçoit la dilatation
+    unsigned char *eroded = scratch_alloc((size_t) width * height);
+    if (eroded == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le gradient morphologique\n");
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(eroded + (size_t) y * width, view.data + (ptrdiff_t) y * view.stride, (size_t) width);
+    }
+
+    if (morph_apply(eroded, width, height, width, seWidth, seHeight, 0, 0) != 0 ||
+        morph_apply(view.data, width, height, view.stride, seWidth, seHeight, 1, 0) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le gradient morphologique\n");
+        scratch_free(eroded);
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        unsigned char *dst = view.data + (ptrdiff_t) y * view.stride;
+        const unsigned char *src = eroded + (size_t) y * width;
+        for (int x = 0; x < width; x++) dst[x] = dst[x] - src[x];
+    }
+
+    scratch_free(eroded);
+    TRACE_END(view.width, view.height, 2 * (size_t) view.width * view.height);
+}
+
+/**
+ * Érode ou dilate une image binaire compactée sans la décompacter
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ * @param reflect 1 pour l'élément structurant réfléchi (seconde étape d'une ouverture ou fermeture)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int morph_bitmap(t_bitmap *bitmap, int seWidth, int seHeight, int isMax, int reflect) {
+    int width = bitmap->width;
+    int height = bitmap->height;
+    int aW = morph_anchor(seWidth, reflect);
+    int aH = morph_anchor(seHeight, reflect);
+    int words = (width + seWidth - 1 + 63) / 64;
+    int rows = height + seHeight - 1;
+    uint64_t identity = isMax ? 0 : ~(uint64_t) 0;
+
+    uint64_t *bits = scratch_alloc((size_t) rows * words * sizeof(uint64_t));
+    if (bits == NULL) return -1;
+
+    // Même disposition que morph_binary, remplie mot par mot
+    for (int r = 0; r < rows; r++) {
+        uint64_t *packed = bits + (size_t) r * words;
+        for (int w = 0; w < words; w++) packed[w] = identity;
+
+        int y = r - aH;
+        if (y >= 0 && y < height) morph_insertBits(packed, aW, bitmap->bits + (size_t) y * bitmap->words, width);
+    }
+
+    morph_packedWindow(bits, words, rows, seWidth, seHeight, identity, isMax);
+
+    uint64_t tail = width % 64 == 0 ? ~(uint64_t) 0 : ((uint64_t) 1 << (width % 64)) - 1;
+    for (int y = 0; y < height; y++) {
+        uint64_t *dst = bitmap->bits + (size_t) y * bitmap->words;
+        memcpy(dst, bits + (size_t) y * words, (size_t) bitmap->words * sizeof(uint64_t));
+        dst[bitmap->words - 1] &= tail;
+    }
+
+    scratch_free(bits);
+    return 0;
+}
+
+/**
+ * Érode une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_erode(t_bitmap *bitmap, int seWidth, int seHeight) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible d'appliquer une opération morphologique à une image NULL\n");
+        return;
+    }
+    if (!morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("bitmap_erode");
+    if (morph_bitmap(bitmap, seWidth, seHeight, 0, 0) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'érosion\n");
+    }
+    TRACE_END(bitmap->width, bitmap->height, 2 * (size_t) bitmap->words * bitmap->height * sizeof(uint64_t));
+}
+
+/**
+ * Dilate une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_dilate(t_bitmap *bitmap, int seWidth, int seHeight) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible d'appliquer une opération morphologique à une image NULL\n");
+        return;
+    }
+    if (!morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("bitmap_dilate");
+    if (morph_bitmap(bitmap, seWidth, seHeight, 1, 0) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la dilatation\n");
+    }
+    TRACE_END(bitmap->width, bitmap->height, 2 * (size_t) bitmap->words * bitmap->height * sizeof(uint64_t));
+}
+
+/**
+ * Applique une ouverture morphologique à une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_open(t_bitmap *bitmap, int seWidth, int seHeight) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible d'appliquer une opération morphologique à une image NULL\n");
+        return;
+    }
+    if (!morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("bitmap_open");
+    if (morph_bitmap(bitmap, seWidth, seHeight, 0, 0) != 0 || morph_bitmap(bitmap, seWidth, seHeight, 1, 1) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'ouverture\n");
+    }
+    TRACE_END(bitmap->width, bitmap->height, 4 * (size_t) bitmap->words * bitmap->height * sizeof(uint64_t));
+}
+
+/**
+ * Applique une fermeture morphologique à une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_close(t_bitmap *bitmap, int seWidth, int seHeight) {
+    if (bitmap == NULL || bitmap->bits == NULL) {
+        fprintf(stderr, "Impossible d'appliquer une opération morphologique à une image NULL\n");
+        return;
+    }
+    if (!morph_checkElement(seWidth, seHeight)) return;
+
+    TRACE_BEGIN("bitmap_close");
+    if (morph_bitmap(bitmap, seWidth, seHeight, 1, 0) != 0 || morph_bitmap(bitmap, seWidth, seHeight, 0, 1) != 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la fermeture\n");
+    }
+    TRACE_END(bitmap->width, bitmap->height, 4 * (size_t) bitmap->words * bitmap->height * sizeof(uint64_t));
+}
@@ -0,0 +1,138 @@
+#ifndef MORPHOLOGY_H
+#define MORPHOLOGY_H
+
+#include "bitmap.h"
+#include "bmp8.h"
+
+/**
+ * Érode une image BMP 8 bits avec un élément structurant rectangulaire
+ * (minimum sur le voisinage, coût constant par pixel quelle que soit la taille)
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_erode(t_bmp8 *img, int seWidth, int seHeight);
+
+/**
+ * Dilate une image BMP 8 bits avec un élément structurant rectangulaire
+ * (maximum sur le voisinage, coût constant par pixel quelle que soit la taille)
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_dilate(t_bmp8 *img, int seWidth, int seHeight);
+
+/**
+ * Applique une ouverture morphologique (érosion puis dilatation par l'élément réfléchi)
+ * Supprime les petits objets clairs d'un masque ; le résultat ne dépasse jamais l'image,
+ * y compris pour un élément structurant de taille paire
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_open(t_bmp8 *img, int seWidth, int seHeight);
+
+/**
+ * Applique une fermeture morphologique (dilatation puis érosion par l'élément réfléchi)
+ * Bouche les petits trous sombres d'un masque ; le résultat n'est jamais sous l'image
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_close(t_bmp8 *img, int seWidth, int seHeight);
+
+/**
+ * Calcule le gradient morphologique (dilatation - érosion), qui fait ressortir les contours
+ *
+ * @param img L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bmp8_morphGradient(t_bmp8 *img, int seWidth, int seHeight);
+
+/**
+ * Érode une vue d'image 8 bits (le voisinage est limité à la vue)
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_erode(t_view8 view, int seWidth, int seHeight);
+
+/**
+ * Dilate une vue d'image 8 bits (le voisinage est limité à la vue)
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_dilate(t_view8 view, int seWidth, int seHeight);
+
+/**
+ * Applique une ouverture morphologique à une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_open(t_view8 view, int seWidth, int seHeight);
+
+/**
+ * Applique une fermeture morphologique à une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_close(t_view8 view, int seWidth, int seHeight);
+
+/**
+ * Calcule le gradient morphologique d'une vue d'image 8 bits
+ *
+ * @param view La vue à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void view8_morphGradient(t_view8 view, int seWidth, int seHeight);
+
+/**
+ * Érode une image binaire compactée sans la décompacter
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_erode(t_bitmap *bitmap, int seWidth, int seHeight);
+
+/**
+ * Dilate une image binaire compactée sans la décompacter
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_dilate(t_bitmap *bitmap, int seWidth, int seHeight);
+
+/**
+ * Applique une ouverture morphologique à une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_open(t_bitmap *bitmap, int seWidth, int seHeight);
+
+/**
+ * Applique une fermeture morphologique à une image binaire compactée
+ *
+ * @param bitmap L'image à modifier
+ * @param seWidth La largeur de l'élément structurant (>= 1)
+ * @param seHeight La hauteur de l'élément structurant (>= 1)
+ */
+void bitmap_close(t_bitmap *bitmap, int seWidth, int seHeight);
+
+#endif //MORPHOLOGY_H
@@ -0,0 +1,164 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall
+#endif
+
+#include "perfcount.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#define PERFCOUNT_THREAD_LOCAL __declspec(thread)
+#else
+#define PERFCOUNT_THREAD_LOCAL __thread
+#endif
+
+static PERFCOUNT_THREAD_LOCAL char perfcountError[160] = "";
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Descripteurs du groupe de compteurs du thread (le premier est le meneur du groupe)
+static PERFCOUNT_THREAD_LOCAL int perfcountFds[PERFCOUNT_EVENTS] = {-1, -1, -1, -1};
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} perfcountConfigs[PERFCOUNT_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+/**
+ * Ouvre un compteur du thread appelant (espace utilisateur seulement)
+ *
+ * @param event Le compteur
+ * @param group Descripteur du meneur du groupe, ou -1 pour créer le groupe
+ * @return int: Le descripteur, ou -1 en cas d'erreur (errno renseigné)
+ */
+static int perfcount_openEvent(int event, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = perfcountConfigs[event].type;
+    attr.config = perfcountConfigs[event].config;
+    attr.disabled = group == -1; // Le groupe démarre d'un bloc une fois complet
+    attr.exclude_kernel = 1; // Permis sans privilège jusqu'à perf_event_paranoid = 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/**
+ * Ouvre et démarre les compteurs du thread appelant
+ *
+ * @return int: 0 en cas de succès, -1 si les compteurs ne sont pas disponibles
+ */
+int perfcount_open(void) {
+    if (perfcountFds[0] != -1) return 0;
+
+    for (int i = 0; i < PERFCOUNT_EVENTS; i++) {
+        perfcountFds[i] = perfcount_openEvent(i, i == 0 ? -1 : perfcountFds[0]);
+        if (perfcountFds[i] == -1) {
+            int error = errno;
+            if (error == EACCES || error == EPERM) {
+                snprintf(perfcountError, sizeof(perfcountError),
+                         "perf_event_open refusé : /proc/sys/kernel/perf_event_paranoid doit valoir 2 ou moins");
+            } else if (error == ENOENT || error == EOPNOTSUPP) {
+                snprintf(perfcountError, sizeof(perfcountError),
+                         "compteurs matériels non pris en charge (machine virtuelle sans PMU ?)");
+            } else {
+                snprintf(perfcountError, sizeof(perfcountError), "perf_event_open : %s", strerror(error));
+            }
+            perfcount_close();
+            return -1;
+        }
+    }
+
+    ioctl(perfcountFds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perfcountFds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    perfcountError[0] = '\0';
+    return 0;
+}
+
+/**
+ * Lit les valeurs courantes des compteurs du thread appelant
+ *
+ * @param values Tableau qui reçoit les PERFCOUNT_EVENTS valeurs
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int perfcount_read(uint64_t values[PERFCOUNT_EVENTS]) {
+    if (perfcountFds[0] == -1) return -1;
+
+    // Format de groupe : nombre, temps activé, temps mesuré, puis une valeur par compteur
+    uint64_t buffer[3 + PERFCOUNT_EVENTS];
+    if (read(perfcountFds[0], buffer, sizeof(buffer)) != (ssize_t) sizeof(buffer)) return -1;
+
+    uint64_t enabled = buffer[1];
+    uint64_t running = buffer[2];
+    for (int i = 0; i < PERFCOUNT_EVENTS; i++) {
+        // Extrapolation si le noyau a partagé les compteurs avec d'autres groupes
+        values[i] = running > 0 && running < enabled
+                        ? (uint64_t) ((double) buffer[3 + i] * (double) enabled / (double) running)
+                        : buffer[3 + i];
+    }
+    return 0;
+}
+
+/**
+ * Ferme les compteurs du thread appelant
+ */
+void perfcount_close(void) {
+    for (int i = PERFCOUNT_EVENTS - 1; i >= 0; i--) {
+        if (perfcountFds[i] != -1) close(perfcountFds[i]);
+        perfcountFds[i] = -1;
+    }
+}
+
+#else
+
+/**
+ * Compteurs matériels non disponibles sur ce système
+ *
+ * @return int: -1
+ */
+int perfcount_open(void) {
+    snprintf(perfcountError, sizeof(perfcountError), "compteurs matériels disponibles seulement sous Linux");
+    return -1;
+}
+
+/**
+ * Compteurs matériels non disponibles sur ce système
+ *
+ * @param values Non modifié
+ * @return int: -1
+ */
+int perfcount_read(uint64_t values[PERFCOUNT_EVENTS]) {
+    (void) values;
+    return -1;
+}
+
+/**
+ * Sans effet sur ce système
+ */
+void perfcount_close(void) {
+}
+
+#endif
+
+/**
+ * Explique pourquoi les compteurs n'ont pas pu être ouverts dans ce thread
+ *
+ * @return const char*: Le message, ou une chaîne vide
+ */
+const char *perfcount_error(void) {
+    return perfcountError;
+}
@@ -0,0 +1,47 @@
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <stdint.h>
+
+// Compteurs matériels du processeur (Linux, perf_event_open) pour le thread appelant.
+// Sans privilège, la mesure de l'espace utilisateur est permise tant que
+// /proc/sys/kernel/perf_event_paranoid vaut 2 ou moins. Ailleurs (autre système, machine
+// virtuelle sans PMU, paranoid >= 3) perfcount_open échoue et les compteurs sont simplement absents.
+
+#define PERFCOUNT_EVENTS 4
+
+typedef enum {
+    PERFCOUNT_CYCLES = 0,
+    PERFCOUNT_INSTRUCTIONS,
+    PERFCOUNT_CACHE_MISSES, // Défauts du dernier niveau de cache
+    PERFCOUNT_BRANCH_MISSES
+} t_perfcount_event;
+
+/**
+ * Ouvre et démarre les compteurs du thread appelant (sans effet s'ils sont déjà ouverts)
+ *
+ * @return int: 0 en cas de succès, -1 si les compteurs ne sont pas disponibles
+ */
+int perfcount_open(void);
+
+/**
+ * Lit les valeurs courantes des compteurs du thread appelant (ouverts par perfcount_open)
+ *
+ * @param values Tableau qui reçoit les PERFCOUNT_EVENTS valeurs, dans l'ordre de t_perfcount_event
+ * @return int: 0 en cas de succès, -1 si les compteurs ne sont pas ouverts ou en cas d'erreur
+ */
+int perfcount_read(uint64_t values[PERFCOUNT_EVENTS]);
+
+/**
+ * Ferme les compteurs du thread appelant
+ */
+void perfcount_close(void);
+
+/**
+ * Explique pourquoi les compteurs n'ont pas pu être ouverts dans ce thread
+ *
+ * @return const char*: Le message, ou une chaîne vide
+ */
+const char *perfcount_error(void);
+
+#endif //PERFCOUNT_H
@@ -0,0 +1,355 @@
+#include "pnm.h"
+#include "arena.h"
+#include "trace.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define PNM_SIMD 1
+#endif
+
+/**
+ * Lit un entier décimal d'un en-tête PNM (espaces et commentaires '#' ignorés).
+ * Le caractère qui suit le nombre est consommé : après la valeur maximale, c'est l'unique
+ * espace qui précède les pixels.
+ *
+ * @param file Le flux
+ * @param value Reçoit le nombre
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int pnm_readNumber(FILE *file, int *value) {
+    int c = getc(file);
+    while (c != EOF && (isspace(c) || c == '#')) {
+        if (c == '#') {
+            while (c != EOF && c != '\n') c = getc(file);
+        }
+        c = getc(file);
+    }
+    if (c == EOF || !isdigit(c)) return -1;
+
+    long number = 0;
+    while (c != EOF && isdigit(c)) {
+        number = number * 10 + (c - '0');
+        if (number > 1000000) return -1;
+        c = getc(file);
+    }
+    if (c != EOF && !isspace(c)) return -1;
+
+    *value = (int) number;
+    return 0;
+}
+
+/**
+ * Lit l'en-tête de l'image suivante d'un flux PGM/PPM binaire
+ *
+ * @param stream Reçoit la description de l'image
+ * @param file Le flux (stdin par exemple)
+ * @return int: 0 si une image suit, 1 en fin de flux, -1 en cas d'erreur
+ */
+int pnm_readHeader(t_pnm_stream *stream, FILE *file) {
+    if (stream == NULL || file == NULL) return -1;
+
+    int c = getc(file);
+    while (c != EOF && isspace(c)) c = getc(file);
+    if (c == EOF) return 1;
+
+    int kind = getc(file);
+    if (c != 'P' || (kind != '5' && kind != '6')) {
+        fprintf(stderr, "Flux PGM/PPM binaire non valide (P5 ou P6 attendu)\n");
+        return -1;
+    }
+
+    stream->file = file;
+    stream->channels = kind == '5' ? 1 : 3;
+    stream->row = 0;
+    if (pnm_readNumber(file, &stream->width) != 0 || pnm_readNumber(file, &stream->height) != 0 ||
+        pnm_readNumber(file, &stream->maxValue) != 0) {
+        fprintf(stderr, "En-tête PGM/PPM non valide\n");
+        return -1;
+    }
+    if (stream->width <= 0 || stream->height <= 0 || stream->width > 10000 || stream->height > 10000) {
+        fprintf(stderr, "Dimensions PGM/PPM invalides (%d x %d)\n", stream->width, stream->height);
+        return -1;
+    }
+    if (stream->maxValue < 1 || stream->maxValue > 255) {
+        fprintf(stderr, "Valeur maximale PGM/PPM non prise en charge (%d, 8 bits seulement)\n", stream->maxValue);
+        return -1;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        int value = i > stream->maxValue ? stream->maxValue : i;
+        stream->scale[i] = (unsigned char) ((value * 255 + stream->maxValue / 2) / stream->maxValue);
+    }
+    return 0;
+}
+
+/**
+ * Lit la rangée suivante (de haut en bas) de l'image courante
+ *
+ * @param stream Le flux dont l'en-tête a été lu
+ * @param row Reçoit width * channels octets (ordre R, G, B pour P6)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_readRow(t_pnm_stream *stream, unsigned char *row) {
+    if (stream == NULL || row == NULL || stream->row >= stream->height) return -1;
+
+    size_t size = (size_t) stream->width * stream->channels;
+    if (fread(row, 1, size, stream->file) != size) {
+        fprintf(stderr, "Flux PGM/PPM interrompu (rangée %d sur %d)\n", stream->row, stream->height);
+        return -1;
+    }
+    if (stream->maxValue != 255) {
+        for (size_t i = 0; i < size; i++) row[i] = stream->scale[row[i]];
+    }
+
+    stream->row++;
+    return 0;
+}
+
+/**
+ * Écrit l'en-tête d'une image PGM/PPM binaire
+ *
+ * @param stream Reçoit la description de l'image
+ * @param file Le flux (stdout par exemple)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param channels 1 (P5) ou 3 (P6)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_writeHeader(t_pnm_stream *stream, FILE *file, int width, int height, int channels) {
+    if (stream == NULL || file == NULL || width <= 0 || height <= 0 || (channels != 1 && channels != 3)) {
+        fprintf(stderr, "Paramètres PGM/PPM invalides\n");
+        return -1;
+    }
+
+    stream->file = file;
+    stream->width = width;
+    stream->height = height;
+    stream->channels = channels;
+    stream->maxValue = 255;
+    stream->row = 0;
+    for (int i = 0; i < 256; i++) stream->scale[i] = (unsigned char) i;
+
+    if (fprintf(file, "P%c\n%d %d\n255\n", channels == 1 ? '5' : '6', width, height) < 0) {
+        fprintf(stderr, "Erreur d'écriture de l'en-tête PGM/PPM\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Écrit la rangée suivante (de haut en bas) de l'image courante
+ *
+ * @param stream Le flux dont l'en-tête a été écrit
+ * @param row Les width * channels octets de la rangée
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_writeRow(t_pnm_stream *stream, const unsigned char *row) {
+    if (stream == NULL || row == NULL || stream->row >= stream->height) return -1;
+
+    size_t size = (size_t) stream->width * stream->channels;
+    if (fwrite(row, 1, size, stream->file) != size) {
+        fprintf(stderr, "Erreur d'écriture du flux PGM/PPM\n");
+        return -1;
+    }
+
+    stream->row++;
+    if (stream->row == stream->height) fflush(stream->file); // L'étape suivante du tube peut commencer
+    return 0;
+}
+
+/**
+ * Convertit une rangée RGB (3 octets par pixel) en pixels BGRA opaques
+ *
+ * @param src La rangée RGB
+ * @param dst Reçoit les pixels
+ * @param width Largeur en pixels
+ */
+static void pnm_rgbToPixels(const unsigned char *src, t_pixel *dst, int width) {
+    int x = 0;
+#ifdef PNM_SIMD
+    // 12 octets RGB -> 4 pixels BGRA ; les 16 octets lus restent dans la rangée tant que x + 6 <= width
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha = _mm_set1_epi32((int) 0xFF000000u);
+    for (; x + 6 <= width; x += 4) {
+        __m128i rgb = _mm_loadu_si128((const __m128i *) (src + 3 * x));
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    }
+#endif
+    for (; x < width; x++) {
+        dst[x].red = src[3 * x];
+        dst[x].green = src[3 * x + 1];
+        dst[x].blue = src[3 * x + 2];
+        dst[x].alpha = 255;
+    }
+}
+
+/**
+ * Convertit des pixels BGRA en rangée RGB (3 octets par pixel)
+ *
+ * @param src Les pixels
+ * @param dst Reçoit la rangée RGB
+ * @param width Largeur en pixels
+ */
+static void pnm_pixelsToRgb(const t_pixel *src, unsigned char *dst, int width) {
+    int x = 0;
+#ifdef PNM_SIMD
+    // 4 pixels -> 12 octets RGB ; les 16 octets écrits restent dans la rangée tant que x + 6 <= width
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    for (; x + 6 <= width; x += 4) {
+        __m128i bgra = _mm_loadu_si128((const __m128i *) (src + x));
+        _mm_storeu_si128((__m128i *) (dst + 3 * x), _mm_shuffle_epi8(bgra, shuffle));
+    }
+#endif
+    for (; x < width; x++) {
+        dst[3 * x] = src[x].red;
+        dst[3 * x + 1] = src[x].green;
+        dst[3 * x + 2] = src[x].blue;
+    }
+}
+
+/**
+ * Lit les pixels d'une image PGM (P5) dont l'en-tête vient d'être lu
+ *
+ * @param stream Le flux
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_readPnm(t_pnm_stream *stream) {
+    if (stream == NULL || stream->channels != 1) {
+        fprintf(stderr, "Une image PGM (P5) est attendue pour une image 8 bits\n");
+        return NULL;
+    }
+
+    t_bmp8 *img = bmp8_allocate((unsigned int) stream->width, (unsigned int) stream->height);
+    if (img == NULL) return NULL;
+    TRACE_BEGIN("bmp8_readPnm");
+
+    // Rangées de haut en bas dans le flux, de bas en haut dans t_bmp8 : lecture directe à leur place
+    unsigned int stride = bmp8_rowSize(img);
+    for (int y = stream->height - 1; y >= 0; y--) {
+        if (pnm_readRow(stream, img->data + (size_t) y * stride) != 0) {
+            bmp8_free(img);
+            return NULL;
+        }
+    }
+
+    TRACE_END(img->width, img->height, img->dataSize);
+    return img;
+}
+
+/**
+ * Lit les pixels d'une image PPM (P6) dont l'en-tête vient d'être lu
+ *
+ * @param stream Le flux
+ * @return t_bmp24*: L'image (alpha à 255) ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_readPnm(t_pnm_stream *stream) {
+    if (stream == NULL || stream->channels != 3) {
+        fprintf(stderr, "Une image PPM (P6) est attendue pour une image 24 bits\n");
+        return NULL;
+    }
+
+    t_bmp24 *img = bmp24_allocate(stream->width, stream->height, 24);
+    if (img == NULL) return NULL;
+
+    unsigned char *row = scratch_alloc((size_t) stream->width * 3);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        bmp24_free(img);
+        return NULL;
+    }
+    TRACE_BEGIN("bmp24_readPnm");
+
+    for (int y = 0; y < stream->height; y++) {
+        if (pnm_readRow(stream, row) != 0) {
+            scratch_free(row);
+            bmp24_free(img);
+            return NULL;
+        }
+        pnm_rgbToPixels(row, img->data[y], stream->width);
+    }
+
+    scratch_free(row);
+    TRACE_END(img->width, img->height, (size_t) img->width * img->height * sizeof(t_pixel));
+    return img;
+}
+
+/**
+ * Écrit une image BMP 8 bits au format PGM binaire (P5)
+ *
+ * @param img L'image
+ * @param file Le flux destination
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int bmp8_writePgm(const t_bmp8 *img, FILE *file) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Impossible d'écrire une image NULL\n");
+        return -1;
+    }
+
+    t_pnm_stream stream;
+    if (pnm_writeHeader(&stream, file, (int) img->width, (int) img->height, 1) != 0) return -1;
+
+    // En mode palette, les pixels sont des indices : la table en attente donne l'intensité réelle
+    unsigned char *mapped = NULL;
+    if (img->lutPending) {
+        mapped = scratch_alloc(img->width);
+        if (mapped == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire\n");
+            return -1;
+        }
+    }
+    TRACE_BEGIN("bmp8_writePgm");
+
+    int status = 0;
+    unsigned int stride = bmp8_rowSize(img);
+    for (int y = (int) img->height - 1; y >= 0 && status == 0; y--) {
+        const unsigned char *row = img->data + (size_t) y * stride;
+        if (mapped != NULL) {
+            for (unsigned int x = 0; x < img->width; x++) mapped[x] = img->lut[row[x]];
+            row = mapped;
+        }
+        status = pnm_writeRow(&stream, row);
+    }
+
+    if (mapped != NULL) scratch_free(mapped);
+    TRACE_END(img->width, img->height, img->dataSize);
+    return status;
+}
+
+/**
+ * Écrit une image BMP 24 bits au format PPM binaire (P6), alpha ignoré
+ *
+ * @param img L'image
+ * @param file Le flux destination
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int bmp24_writePpm(const t_bmp24 *img, FILE *file) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Impossible d'écrire une image NULL\n");
+        return -1;
+    }
+
+    t_pnm_stream stream;
+    if (pnm_writeHeader(&stream, file, img->width, img->height, 3) != 0) return -1;
+
+    unsigned char *row = scratch_alloc((size_t) img->width * 3);
+    if (row == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return -1;
+    }
+    TRACE_BEGIN("bmp24_writePpm");
+
+    int status = 0;
+    for (int y = 0; y < img->height && status == 0; y++) {
+        pnm_pixelsToRgb(img->data[y], row, img->width);
+        status = pnm_writeRow(&stream, row);
+    }
+
+    scratch_free(row);
+    TRACE_END(img->width, img->height, (size_t) img->width * img->height * sizeof(t_pixel));
+    return status;
+}
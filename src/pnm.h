@@ -0,0 +1,95 @@
+#ifndef PNM_H
+#define PNM_H
+
+#include <stdio.h>
+
+#include "bmp8.h"
+#include "color.h"
+
+// Flux PGM binaire (P5, 1 canal) ou PPM binaire (P6, 3 canaux RGB) : rangées de haut en bas,
+// sans bourrage, lues ou écrites une par une (compatible avec les tubes stdin/stdout).
+// Plusieurs images peuvent se suivre dans un même flux.
+typedef struct {
+    FILE *file; // Le flux
+    int width; // Largeur en pixels
+    int height; // Hauteur en pixels
+    int channels; // 1 (P5) ou 3 (P6)
+    int maxValue; // Valeur maximale d'un échantillon (1 à 255)
+    int row; // Nombre de rangées déjà lues ou écrites
+    unsigned char scale[256]; // Échantillon ramené à l'échelle 0-255 (identité si maxValue = 255)
+} t_pnm_stream;
+
+/**
+ * Lit l'en-tête de l'image suivante d'un flux PGM/PPM binaire
+ *
+ * @param stream Reçoit la description de l'image
+ * @param file Le flux (stdin par exemple)
+ * @return int: 0 si une image suit, 1 en fin de flux, -1 en cas d'erreur
+ */
+int pnm_readHeader(t_pnm_stream *stream, FILE *file);
+
+/**
+ * Lit la rangée suivante (de haut en bas) de l'image courante
+ *
+ * @param stream Le flux dont l'en-tête a été lu
+ * @param row Reçoit width * channels octets (ordre R, G, B pour P6)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_readRow(t_pnm_stream *stream, unsigned char *row);
+
+/**
+ * Écrit l'en-tête d'une image PGM/PPM binaire
+ *
+ * @param stream Reçoit la description de l'image
+ * @param file Le flux (stdout par exemple)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param channels 1 (P5) ou 3 (P6)
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_writeHeader(t_pnm_stream *stream, FILE *file, int width, int height, int channels);
+
+/**
+ * Écrit la rangée suivante (de haut en bas) de l'image courante
+ *
+ * @param stream Le flux dont l'en-tête a été écrit
+ * @param row Les width * channels octets de la rangée
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int pnm_writeRow(t_pnm_stream *stream, const unsigned char *row);
+
+/**
+ * Lit les pixels d'une image PGM (P5) dont l'en-tête vient d'être lu
+ *
+ * @param stream Le flux
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp8_readPnm(t_pnm_stream *stream);
+
+/**
+ * Lit les pixels d'une image PPM (P6) dont l'en-tête vient d'être lu
+ *
+ * @param stream Le flux
+ * @return t_bmp24*: L'image (alpha à 255) ou NULL en cas d'erreur
+ */
+t_bmp24 *bmp24_readPnm(t_pnm_stream *stream);
+
+/**
+ * Écrit une image BMP 8 bits au format PGM binaire (P5)
+ *
+ * @param img L'image
+ * @param file Le flux destination
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int bmp8_writePgm(const t_bmp8 *img, FILE *file);
+
+/**
+ * Écrit une image BMP 24 bits au format PPM binaire (P6), alpha ignoré
+ *
+ * @param img L'image
+ * @param file Le flux destination
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int bmp24_writePpm(const t_bmp24 *img, FILE *file);
+
+#endif //PNM_H
@@ -0,0 +1,285 @@
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Calcule la mémoire occupée par une image BMP 8 bits
+ *
+ * @param img L'image
+ * @return size_t: Taille en octets (structure et pixels)
+ */
+static size_t pool_bytesBmp8(const t_bmp8 *img) {
+    return sizeof(t_bmp8) + img->dataSize;
+}
+
+/**
+ * Calcule la mémoire occupée par une image BMP 24 bits
+ *
+ * @param img L'image
+ * @return size_t: Taille en octets (structure, pointeurs de rangées et pixels)
+ */
+static size_t pool_bytesBmp24(const t_bmp24 *img) {
+    return sizeof(t_bmp24) + (size_t) img->height * sizeof(t_pixel *) +
+           (size_t) img->width * img->height * sizeof(t_pixel);
+}
+
+/**
+ * Libère définitivement l'image d'un emplacement
+ *
+ * @param slot L'emplacement
+ */
+static void pool_freeSlot(t_pool_slot *slot) {
+    if (slot->depth == 8) {
+        bmp8_free((t_bmp8 *) slot->image);
+    } else {
+        bmp24_free((t_bmp24 *) slot->image);
+    }
+}
+
+/**
+ * Retire du pool l'image disponible la plus récente ayant ces dimensions
+ *
+ * @param pool Le pool
+ * @param depth La profondeur (8 ou 24)
+ * @param width La largeur
+ * @param height La hauteur
+ * @return void*: L'image, ou NULL si aucune ne correspond
+ */
+static void *pool_take(t_image_pool *pool, int depth, unsigned int width, unsigned int height) {
+    for (int i = pool->count - 1; i >= 0; i--) {
+        t_pool_slot *slot = &pool->slots[i];
+        if (slot->depth != depth || slot->width != width || slot->height != height) continue;
+
+        void *image = slot->image;
+        pool->retainedBytes -= slot->bytes;
+        memmove(slot, slot + 1, (size_t) (pool->count - 1 - i) * sizeof(t_pool_slot));
+        pool->count--;
+        pool->hits++;
+        return image;
+    }
+
+    pool->misses++;
+    return NULL;
+}
+
+/**
+ * Conserve une image dans le pool, en libérant les plus anciennes si maxBytes serait dépassé
+ *
+ * @param pool Le pool
+ * @param slot L'image à conserver et ses dimensions
+ */
+static void pool_put(t_image_pool *pool, t_pool_slot slot) {
+    if (slot.bytes > pool->maxBytes) {
+        pool_freeSlot(&slot);
+        pool->evictions++;
+        return;
+    }
+
+    int evicted = 0;
+    while (pool->retainedBytes + slot.bytes > pool->maxBytes && evicted < pool->count) {
+        pool_freeSlot(&pool->slots[evicted]);
+        pool->retainedBytes -= pool->slots[evicted].bytes;
+        pool->evictions++;
+        evicted++;
+    }
+    if (evicted > 0) {
+        memmove(pool->slots, pool->slots + evicted, (size_t) (pool->count - evicted) * sizeof(t_pool_slot));
+        pool->count -= evicted;
+    }
+
+    if (pool->count == pool->capacity) {
+        int capacity = pool->capacity * 2;
+        t_pool_slot *slots = (t_pool_slot *) realloc(pool->slots, (size_t) capacity * sizeof(t_pool_slot));
+        if (slots == NULL) {
+            pool_freeSlot(&slot);
+            pool->evictions++;
+            return;
+        }
+        pool->slots = slots;
+        pool->capacity = capacity;
+    }
+
+    pool->slots[pool->count++] = slot;
+    pool->retainedBytes += slot.bytes;
+}
+
+/**
+ * Crée un pool d'images
+ *
+ * @param maxBytes Mémoire maximale conservée par le pool (en octets)
+ * @return t_image_pool*: Pointeur vers le pool créé ou NULL en cas d'erreur
+ */
+t_image_pool *pool_create(size_t maxBytes) {
+    t_image_pool *pool = (t_image_pool *) malloc(sizeof(t_image_pool));
+    if (pool == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le pool d'images\n");
+        return NULL;
+    }
+
+    pool->capacity = 16;
+    pool->slots = (t_pool_slot *) malloc(pool->capacity * sizeof(t_pool_slot));
+    if (pool->slots == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le pool d'images\n");
+        free(pool);
+        return NULL;
+    }
+
+    pool->count = 0;
+    pool->maxBytes = maxBytes;
+    pool->retainedBytes = 0;
+    pool->hits = 0;
+    pool->misses = 0;
+    pool->evictions = 0;
+    return pool;
+}
+
+/**
+ * Libère un pool et toutes les images qu'il conserve
+ *
+ * @param pool Le pool à libérer
+ */
+void pool_destroy(t_image_pool *pool) {
+    if (pool == NULL) return;
+
+    for (int i = 0; i < pool->count; i++) {
+        pool_freeSlot(&pool->slots[i]);
+    }
+    free(pool->slots);
+    free(pool);
+}
+
+/**
+ * Fournit une image BMP 8 bits (en-tête et palette de gris réinitialisés, pixels indéterminés)
+ *
+ * @param pool Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+t_bmp8 *pool_acquireBmp8(t_image_pool *pool, unsigned int width, unsigned int height) {
+    if (pool == NULL) return bmp8_allocate(width, height);
+
+    t_bmp8 *img = (t_bmp8 *) pool_take(pool, 8, width, height);
+    if (img == NULL) return bmp8_allocate(width, height);
+
+    bmp8_reset(img);
+    return img;
+}
+
+/**
+ * Fournit une image BMP 24 bits (en-têtes et masques réinitialisés, pixels indéterminés)
+ *
+ * @param pool Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp24*: L'image ou NULL en cas d'erreur
+ */
+t_bmp24 *pool_acquireBmp24(t_image_pool *pool, int width, int height) {
+    if (pool == NULL || width <= 0 || height <= 0) return bmp24_allocate(width, height, 24);
+
+    t_bmp24 *img = (t_bmp24 *) pool_take(pool, 24, (unsigned int) width, (unsigned int) height);
+    if (img == NULL) return bmp24_allocate(width, height, 24);
+
+    bmp24_reset(img);
+    return img;
+}
+
+/**
+ * Rend une image BMP 8 bits au pool
+ *
+ * @param pool Le pool
+ * @param img L'image à recycler
+ */
+void pool_releaseBmp8(t_image_pool *pool, t_bmp8 *img) {
+    if (img == NULL) return;
+    if (pool == NULL) {
+        bmp8_free(img);
+        return;
+    }
+
+    t_pool_slot slot = {img, 8, img->width, img->height, pool_bytesBmp8(img)};
+    pool_put(pool, slot);
+}
+
+/**
+ * Rend une image BMP 24 bits au pool
+ *
+ * @param pool Le pool
+ * @param img L'image à recycler
+ */
+void pool_releaseBmp24(t_image_pool *pool, t_bmp24 *img) {
+    if (img == NULL) return;
+    if (pool == NULL) {
+        bmp24_free(img);
+        return;
+    }
+
+    t_pool_slot slot = {img, 24, (unsigned int) img->width, (unsigned int) img->height, pool_bytesBmp24(img)};
+    pool_put(pool, slot);
+}
+
+/**
+ * Allocateur de chargement 8 bits qui puise dans le pool
+ *
+ * @param context Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+static t_bmp8 *pool_allocatorBmp8(void *context, unsigned int width, unsigned int height) {
+    return pool_acquireBmp8((t_image_pool *) context, width, height);
+}
+
+/**
+ * Allocateur de chargement 24 bits qui puise dans le pool
+ *
+ * @param context Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp24*: L'image ou NULL en cas d'erreur
+ */
+static t_bmp24 *pool_allocatorBmp24(void *context, int width, int height) {
+    return pool_acquireBmp24((t_image_pool *) context, width, height);
+}
+
+/**
+ * Charge une image BMP 8 bits dans une image du pool
+ *
+ * @param pool Le pool
+ * @param filename Le chemin vers le fichier à charger
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *pool_loadBmp8(t_image_pool *pool, const char *filename) {
+    return bmp8_loadImageWith(filename, pool_allocatorBmp8, pool);
+}
+
+/**
+ * Charge une image BMP 24 bits dans une image du pool
+ *
+ * @param pool Le pool
+ * @param filename Nom du fichier à charger
+ * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp24 *pool_loadBmp24(t_image_pool *pool, const char *filename) {
+    return bmp24_loadImageWith(filename, pool_allocatorBmp24, pool);
+}
+
+/**
+ * Affiche les statistiques d'un pool
+ *
+ * @param pool Le pool
+ */
+void pool_printStats(const t_image_pool *pool) {
+    if (pool == NULL) {
+        printf("⚠️ Pool d'images non valide\n");
+        return;
+    }
+
+    unsigned long total = pool->hits + pool->misses;
+    printf("Acquisitions: %lu (recyclées: %lu, allouées: %lu, taux: %.1f%%)\n", total, pool->hits, pool->misses,
+           total > 0 ? 100.0 * pool->hits / total : 0.0);
+    printf("Évictions: %lu\n", pool->evictions);
+    printf("Mémoire conservée: %zu / %zu octets (%d images)\n", pool->retainedBytes, pool->maxBytes, pool->count);
+}
@@ -0,0 +1,111 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+#include "bmp8.h"
+#include "color.h"
+
+// Pool d'images recyclées pour les traitements par lots d'images de mêmes dimensions.
+// Une image libérée dans le pool garde sa structure et ses pixels (déjà en mémoire physique) ;
+// l'acquisition suivante de même taille et profondeur la réutilise sans allocation.
+// Un pool n'est pas partagé entre threads : utiliser un pool par thread.
+
+typedef struct {
+    void *image; // t_bmp8* ou t_bmp24*
+    int depth; // 8 ou 24
+    unsigned int width;
+    unsigned int height;
+    size_t bytes; // Mémoire occupée par l'image
+} t_pool_slot;
+
+typedef struct {
+    t_pool_slot *slots; // Images disponibles, de la plus ancienne à la plus récente
+    int count;
+    int capacity;
+    size_t maxBytes; // Mémoire maximale conservée par le pool
+    size_t retainedBytes; // Mémoire actuellement conservée
+
+    // Statistiques
+    unsigned long hits; // Acquisitions servies par une image recyclée
+    unsigned long misses; // Acquisitions qui ont dû allouer une image
+    unsigned long evictions; // Images libérées pour respecter maxBytes
+} t_image_pool;
+
+/**
+ * Crée un pool d'images
+ *
+ * @param maxBytes Mémoire maximale conservée par le pool (en octets)
+ * @return t_image_pool*: Pointeur vers le pool créé ou NULL en cas d'erreur
+ */
+t_image_pool *pool_create(size_t maxBytes);
+
+/**
+ * Libère un pool et toutes les images qu'il conserve
+ *
+ * @param pool Le pool à libérer
+ */
+void pool_destroy(t_image_pool *pool);
+
+/**
+ * Fournit une image BMP 8 bits (en-tête et palette de gris réinitialisés, pixels indéterminés)
+ *
+ * @param pool Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp8*: L'image ou NULL en cas d'erreur
+ */
+t_bmp8 *pool_acquireBmp8(t_image_pool *pool, unsigned int width, unsigned int height);
+
+/**
+ * Fournit une image BMP 24 bits (en-têtes et masques réinitialisés, pixels indéterminés)
+ *
+ * @param pool Le pool
+ * @param width Largeur de l'image en pixels
+ * @param height Hauteur de l'image en pixels
+ * @return t_bmp24*: L'image ou NULL en cas d'erreur
+ */
+t_bmp24 *pool_acquireBmp24(t_image_pool *pool, int width, int height);
+
+/**
+ * Rend une image BMP 8 bits au pool (à la place de bmp8_free)
+ *
+ * @param pool Le pool
+ * @param img L'image à recycler
+ */
+void pool_releaseBmp8(t_image_pool *pool, t_bmp8 *img);
+
+/**
+ * Rend une image BMP 24 bits au pool (à la place de bmp24_free)
+ *
+ * @param pool Le pool
+ * @param img L'image à recycler
+ */
+void pool_releaseBmp24(t_image_pool *pool, t_bmp24 *img);
+
+/**
+ * Charge une image BMP 8 bits dans une image du pool
+ *
+ * @param pool Le pool
+ * @param filename Le chemin vers le fichier à charger
+ * @return t_bmp8*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp8 *pool_loadBmp8(t_image_pool *pool, const char *filename);
+
+/**
+ * Charge une image BMP 24 bits dans une image du pool
+ *
+ * @param pool Le pool
+ * @param filename Nom du fichier à charger
+ * @return t_bmp24*: Pointeur vers l'image chargée ou NULL en cas d'erreur
+ */
+t_bmp24 *pool_loadBmp24(t_image_pool *pool, const char *filename);
+
+/**
+ * Affiche les statistiques d'un pool (succès, échecs, évictions, mémoire conservée)
+ *
+ * @param pool Le pool
+ */
+void pool_printStats(const t_image_pool *pool);
+
+#endif //POOL_H
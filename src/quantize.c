@@ -0,0 +1,421 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "quantize.h"
+#include "arena.h"
+#include "trace.h"
+
+// Profondeur de l'octree : une feuille par couleur 24 bits distincte au plus
+#define OCTREE_DEPTH 8
+
+typedef struct {
+    uint64_t red, green, blue; // Sommes des composantes des pixels du nœud
+    uint32_t count; // Nombre de pixels du nœud
+    int children[8]; // Indices des fils (-1 si absent)
+    int next; // Nœud réductible suivant de même niveau, ou nœud libre suivant
+    int leaf; // 1 si le nœud est une feuille (une couleur de la palette)
+} t_octree_node;
+
+typedef struct {
+    t_octree_node *nodes; // Nœuds alloués en un seul tableau, référencés par indice
+    int size;
+    int capacity;
+    int freeList; // Nœuds libérés par les réductions, réutilisables
+    int reducible[OCTREE_DEPTH]; // Nœuds internes de chaque niveau
+    int leaves; // Nombre de feuilles
+} t_octree;
+
+/**
+ * Crée un nœud vide dans l'octree
+ *
+ * @param tree L'octree
+ * @param level Le niveau du nœud (0 pour la racine)
+ * @return int: Indice du nœud ou -1 en cas d'erreur d'allocation
+ */
+static int octree_newNode(t_octree *tree, int level) {
+    int index;
+    if (tree->freeList != -1) {
+        index = tree->freeList;
+        tree->freeList = tree->nodes[index].next;
+    } else {
+        if (tree->size == tree->capacity) {
+            int capacity = tree->capacity * 2;
+            t_octree_node *nodes = (t_octree_node *) realloc(tree->nodes, (size_t) capacity * sizeof(t_octree_node));
+            if (nodes == NULL) return -1;
+            tree->nodes = nodes;
+            tree->capacity = capacity;
+        }
+        index = tree->size++;
+    }
+
+    t_octree_node *node = &tree->nodes[index];
+    memset(node, 0, sizeof(t_octree_node));
+    for (int i = 0; i < 8; i++) node->children[i] = -1;
+
+    if (level == OCTREE_DEPTH) {
+        node->leaf = 1;
+        node->next = -1;
+        tree->leaves++;
+    } else {
+        node->next = tree->reducible[level];
+        tree->reducible[level] = index;
+    }
+    return index;
+}
+
+/**
+ * Ajoute un pixel dans l'octree
+ *
+ * @param tree L'octree
+ * @param p Le pixel
+ * @return int: 1 en cas de succès, 0 en cas d'erreur d'allocation
+ */
+static int octree_insert(t_octree *tree, const t_pixel *p) {
+    int index = 0;
+    for (int level = 0; !tree->nodes[index].leaf; level++) {
+        int shift = 7 - level;
+        int branch = (((p->red >> shift) & 1) << 2) | (((p->green >> shift) & 1) << 1) | ((p->blue >> shift) & 1);
+
+        int child = tree->nodes[index].children[branch];
+        if (child == -1) {
+            child = octree_newNode(tree, level + 1);
+            if (child == -1) return 0;
+            tree->nodes[index].children[branch] = child;
+        }
+        index = child;
+    }
+
+    t_octree_node *node = &tree->nodes[index];
+    node->red += p->red;
+    node->green += p->green;
+    node->blue += p->blue;
+    node->count++;
+    return 1;
+}
+
+/**
+ * Fusionne les fils d'un nœud interne du niveau le plus profond en une seule feuille
+ * (la racine n'est jamais réduite, pour garder au moins ses fils comme couleurs)
+ *
+ * @param tree L'octree
+ * @return int: 1 si un nœud a été réduit, 0 s'il ne reste que la racine
+ */
+static int octree_reduce(t_octree *tree) {
+    int level = OCTREE_DEPTH - 1;
+    while (level > 0 && tree->reducible[level] == -1) level--;
+    if (level == 0) return 0;
+
+    int index = tree->reducible[level];
+    t_octree_node *node = &tree->nodes[index];
+    tree->reducible[level] = node->next;
+
+    // Les niveaux plus profonds sont vides : tous les fils sont des feuilles
+    for (int i = 0; i < 8; i++) {
+        int child = node->children[i];
+        if (child == -1) continue;
+
+        t_octree_node *leaf = &tree->nodes[child];
+        node->red += leaf->red;
+        node->green += leaf->green;
+        node->blue += leaf->blue;
+        node->count += leaf->count;
+
+        leaf->next = tree->freeList;
+        tree->freeList = child;
+        node->children[i] = -1;
+        tree->leaves--;
+    }
+
+    node->leaf = 1;
+    node->next = -1;
+    tree->leaves++;
+    return 1;
+}
+
+/**
+ * Parcourt l'octree et recueille les sommes de chaque feuille non vide
+ *
+ * @param tree L'octree
+ * @param index Le nœud courant
+ * @param leaves Reçoit les feuilles (seuls les champs de sommes et count sont utilisés)
+ * @param count Nombre de feuilles déjà recueillies
+ */
+static void octree_collect(const t_octree *tree, int index, t_octree_node *leaves, int *count) {
+    const t_octree_node *node = &tree->nodes[index];
+    if (node->leaf) {
+        if (node->count > 0) leaves[(*count)++] = *node;
+        return;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (node->children[i] != -1) octree_collect(tree, node->children[i], leaves, count);
+    }
+}
+
+/**
+ * Fusionne les deux feuilles dont la réunion augmente le moins l'erreur (critère de Ward)
+ * Seulement nécessaire pour moins de 8 couleurs : la racine n'est jamais réduite
+ *
+ * @param leaves Les feuilles
+ * @param count Nombre de feuilles, décrémenté
+ */
+static void octree_mergeClosest(t_octree_node *leaves, int *count) {
+    int bestA = 0, bestB = 1;
+    double bestCost = -1.0;
+    for (int a = 0; a < *count; a++) {
+        for (int b = a + 1; b < *count; b++) {
+            double na = leaves[a].count, nb = leaves[b].count;
+            double dr = leaves[a].red / na - leaves[b].red / nb;
+            double dg = leaves[a].green / na - leaves[b].green / nb;
+            double db = leaves[a].blue / na - leaves[b].blue / nb;
+            double cost = na * nb / (na + nb) * (dr * dr + dg * dg + db * db);
+            if (bestCost < 0.0 || cost < bestCost) {
+                bestCost = cost;
+                bestA = a;
+                bestB = b;
+            }
+        }
+    }
+
+    leaves[bestA].red += leaves[bestB].red;
+    leaves[bestA].green += leaves[bestB].green;
+    leaves[bestA].blue += leaves[bestB].blue;
+    leaves[bestA].count += leaves[bestB].count;
+    leaves[bestB] = leaves[--(*count)];
+}
+
+/**
+ * Construit la palette d'une image par octree
+ *
+ * @param img L'image source
+ * @param colors Nombre maximal de couleurs
+ * @param palette Reçoit la palette (bleu, vert, rouge, réservé)
+ * @return int: Nombre de couleurs de la palette, 0 en cas d'erreur
+ */
+static int quantize_buildPalette(const t_bmp24 *img, int colors, unsigned char *palette) {
+    t_octree tree;
+    tree.capacity = 1024;
+    tree.size = 0;
+    tree.freeList = -1;
+    tree.leaves = 0;
+    for (int i = 0; i < OCTREE_DEPTH; i++) tree.reducible[i] = -1;
+    tree.nodes = (t_octree_node *) malloc((size_t) tree.capacity * sizeof(t_octree_node));
+    if (tree.nodes == NULL || octree_newNode(&tree, 0) == -1) {
+        free(tree.nodes);
+        return 0;
+    }
+
+    // La réduction au fil de l'insertion borne la taille de l'arbre
+    for (int y = 0; y < img->height; y++) {
+        const t_pixel *row = img->data[y];
+        for (int x = 0; x < img->width; x++) {
+            if (!octree_insert(&tree, &row[x])) {
+                free(tree.nodes);
+                return 0;
+            }
+            while (tree.leaves > colors && octree_reduce(&tree));
+        }
+    }
+
+    // Au plus max(colors, 8) feuilles
+    t_octree_node leaves[256];
+    int count = 0;
+    octree_collect(&tree, 0, leaves, &count);
+    free(tree.nodes);
+    while (count > colors) octree_mergeClosest(leaves, &count);
+
+    for (int i = 0; i < count; i++) {
+        const t_octree_node *leaf = &leaves[i];
+        unsigned char *entry = palette + i * 4;
+        entry[0] = (unsigned char) ((leaf->blue + leaf->count / 2) / leaf->count);
+        entry[1] = (unsigned char) ((leaf->green + leaf->count / 2) / leaf->count);
+        entry[2] = (unsigned char) ((leaf->red + leaf->count / 2) / leaf->count);
+        entry[3] = 0;
+    }
+    return count;
+}
+
+/**
+ * Construit la table de couleur inverse : indice de la couleur de palette la plus proche
+ * du centre de chaque cellule RGB de 8x8x8 valeurs
+ *
+ * @param palette La palette (bleu, vert, rouge, réservé)
+ * @param count Nombre de couleurs de la palette
+ * @param inverse Reçoit QUANTIZE_INVERSE_LEVELS^3 indices, dans l'ordre [rouge][vert][bleu]
+ */
+static void quantize_buildInverse(const unsigned char *palette, int count, unsigned char *inverse) {
+    const int cellShift = 8 - QUANTIZE_INVERSE_BITS;
+
+    #pragma omp parallel for
+    for (int r = 0; r < QUANTIZE_INVERSE_LEVELS; r++) {
+        int red = (r << cellShift) + (1 << (cellShift - 1));
+        for (int g = 0; g < QUANTIZE_INVERSE_LEVELS; g++) {
+            int green = (g << cellShift) + (1 << (cellShift - 1));
+            for (int b = 0; b < QUANTIZE_INVERSE_LEVELS; b++) {
+                int blue = (b << cellShift) + (1 << (cellShift - 1));
+
+                int best = 0, bestDistance = 3 * 256 * 256;
+                for (int i = 0; i < count; i++) {
+                    const unsigned char *entry = palette + i * 4;
+                    int db = blue - entry[0], dg = green - entry[1], dr = red - entry[2];
+                    int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = i;
+                    }
+                }
+                inverse[(r * QUANTIZE_INVERSE_LEVELS + g) * QUANTIZE_INVERSE_LEVELS + b] = (unsigned char) best;
+            }
+        }
+    }
+}
+
+/**
+ * Renvoie l'indice de palette d'une couleur via la table de couleur inverse
+ *
+ * @param inverse La table de couleur inverse
+ * @param red, green, blue Les composantes (0-255)
+ * @return int: L'indice de la couleur de palette
+ */
+static inline int quantize_lookup(const unsigned char *inverse, int red, int green, int blue) {
+    const int cellShift = 8 - QUANTIZE_INVERSE_BITS;
+    return inverse[((red >> cellShift) * QUANTIZE_INVERSE_LEVELS + (green >> cellShift)) * QUANTIZE_INVERSE_LEVELS +
+                   (blue >> cellShift)];
+}
+
+/**
+ * Limite une valeur à l'intervalle [0, 255]
+ *
+ * @param value La valeur
+ * @return int: La valeur limitée
+ */
+static inline int quantize_clamp(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+/**
+ * Associe chaque pixel à une couleur de la palette avec diffusion d'erreur de Floyd-Steinberg
+ * (7/16 à droite, 3/16 en bas à gauche, 5/16 en bas, 1/16 en bas à droite)
+ *
+ * @param img L'image source
+ * @param palette La palette (bleu, vert, rouge, réservé)
+ * @param inverse La table de couleur inverse
+ * @param out L'image 8 bits destination
+ * @return int: 1 en cas de succès, 0 en cas d'erreur d'allocation
+ */
+static int quantize_dither(const t_bmp24 *img, const unsigned char *palette, const unsigned char *inverse, t_bmp8 *out) {
+    int width = img->width;
+    unsigned int stride = bmp8_rowSize(out);
+
+    // Erreurs en seizièmes, une case de marge de chaque côté, trois canaux (rouge, vert, bleu)
+    int *errors = (int *) scratch_calloc((size_t) (width + 2) * 3 * 2 * sizeof(int));
+    if (errors == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        return 0;
+    }
+    int *current = errors;
+    int *next = errors + (width + 2) * 3;
+
+    for (int y = 0; y < img->height; y++) {
+        const t_pixel *row = img->data[y];
+        unsigned char *dst = out->data + (size_t) (img->height - 1 - y) * stride;
+        memset(next, 0, (size_t) (width + 2) * 3 * sizeof(int));
+
+        for (int x = 0; x < width; x++) {
+            int *e = current + (x + 1) * 3;
+            int red = quantize_clamp(row[x].red + e[0] / 16);
+            int green = quantize_clamp(row[x].green + e[1] / 16);
+            int blue = quantize_clamp(row[x].blue + e[2] / 16);
+
+            int index = quantize_lookup(inverse, red, green, blue);
+            dst[x] = (unsigned char) index;
+
+            const unsigned char *entry = palette + index * 4;
+            int diff[3] = {red - entry[2], green - entry[1], blue - entry[0]};
+            int *below = next + (x + 1) * 3;
+            for (int c = 0; c < 3; c++) {
+                e[3 + c] += diff[c] * 7;
+                below[c - 3] += diff[c] * 3;
+                below[c] += diff[c] * 5;
+                below[c + 3] += diff[c];
+            }
+        }
+
+        int *swap = current;
+        current = next;
+        next = swap;
+    }
+
+    scratch_free(errors);
+    return 1;
+}
+
+/**
+ * Réduit une image BMP 24 bits à une image BMP 8 bits palettisée (quantification par octree)
+ *
+ * @param img Pointeur vers l'image à convertir (non modifiée)
+ * @param colors Nombre maximal de couleurs de la palette (2 à 256)
+ * @param dither 1 pour activer la diffusion d'erreur de Floyd-Steinberg, 0 sinon
+ * @return t_bmp8*: Nouvelle image 8 bits avec sa palette de couleurs ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_quantize(const t_bmp24 *img, int colors, int dither) {
+    if (img == NULL || img->data == NULL) {
+        fprintf(stderr, "Erreur: Impossible de quantifier une image NULL\n");
+        return NULL;
+    }
+    if (colors < 2 || colors > 256) {
+        fprintf(stderr, "Erreur: Le nombre de couleurs doit être compris entre 2 et 256\n");
+        return NULL;
+    }
+    TRACE_BEGIN("bmp24_quantize");
+
+    t_bmp8 *out = bmp8_allocate(img->width, img->height);
+    if (out == NULL) return NULL;
+
+    unsigned char palette[256 * 4];
+    memset(palette, 0, sizeof(palette));
+    int count = quantize_buildPalette(img, colors, palette);
+    if (count == 0) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la quantification\n");
+        bmp8_free(out);
+        return NULL;
+    }
+
+    unsigned char *inverse = (unsigned char *) scratch_alloc(QUANTIZE_INVERSE_LEVELS * QUANTIZE_INVERSE_LEVELS *
+                                                             QUANTIZE_INVERSE_LEVELS);
+    if (inverse == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la quantification\n");
+        bmp8_free(out);
+        return NULL;
+    }
+    quantize_buildInverse(palette, count, inverse);
+
+    if (dither) {
+        if (!quantize_dither(img, palette, inverse, out)) {
+            scratch_free(inverse);
+            bmp8_free(out);
+            return NULL;
+        }
+    } else {
+        unsigned int stride = bmp8_rowSize(out);
+
+        #pragma omp parallel for
+        for (int y = 0; y < img->height; y++) {
+            const t_pixel *row = img->data[y];
+            unsigned char *dst = out->data + (size_t) (img->height - 1 - y) * stride;
+            for (int x = 0; x < img->width; x++) {
+                dst[x] = (unsigned char) quantize_lookup(inverse, row[x].red, row[x].green, row[x].blue);
+            }
+        }
+    }
+    scratch_free(inverse);
+
+    // Palette de couleurs réelle : les entrées inutilisées restent noires
+    memcpy(out->colorTable, palette, sizeof(palette));
+    out->header[46] = (unsigned char) (count & 0xFF);
+    out->header[47] = (unsigned char) (count >> 8);
+
+    TRACE_END(img->width, img->height, (size_t) img->width * img->height * sizeof(t_pixel) + out->dataSize);
+    return out;
+}
@@ -0,0 +1,23 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include "bmp8.h"
+#include "color.h"
+
+// Nombre de niveaux par canal de la table de couleur inverse (5 bits par canal)
+#define QUANTIZE_INVERSE_BITS 5
+#define QUANTIZE_INVERSE_LEVELS (1 << QUANTIZE_INVERSE_BITS)
+
+/**
+ * Réduit une image BMP 24 bits à une image BMP 8 bits palettisée (quantification par octree)
+ * Chaque pixel est ensuite associé à la couleur la plus proche de la palette via une table
+ * de couleur inverse 32x32x32, éventuellement avec une diffusion d'erreur de Floyd-Steinberg
+ *
+ * @param img Pointeur vers l'image à convertir (non modifiée)
+ * @param colors Nombre maximal de couleurs de la palette (2 à 256)
+ * @param dither 1 pour activer la diffusion d'erreur de Floyd-Steinberg, 0 sinon
+ * @return t_bmp8*: Nouvelle image 8 bits avec sa palette de couleurs ou NULL en cas d'erreur
+ */
+t_bmp8 *bmp24_quantize(const t_bmp24 *img, int colors, int dither);
+
+#endif //QUANTIZE_H
@@ -0,0 +1,425 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sigaction, clock_gettime
+#endif
+
+#include "server.h"
+#include "job.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#define SERVER_QUEUE 256 // Connexions acceptées en attente d'un thread
+
+// File des connexions acceptées, partagée entre le thread d'écoute et les threads de traitement
+typedef struct {
+    int fds[SERVER_QUEUE];
+    int head; // Prochaine connexion à traiter
+    int count;
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    const char *cacheDirectory;
+} t_server_queue;
+
+static volatile sig_atomic_t serverStop = 0;
+
+/**
+ * Gestionnaire de SIGINT et SIGTERM : interrompt accept et arrête le serveur
+ */
+static void server_onSignal(int signal) {
+    (void) signal;
+    serverStop = 1;
+}
+
+/**
+ * Temps monotone en microsecondes
+ */
+static double server_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+/**
+ * Écrit un bloc en entier sur un descripteur
+ *
+ * @param fd Le descripteur
+ * @param data Les octets
+ * @param size Nombre d'octets
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+static int server_writeAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return -1;
+        data += written;
+        size -= (size_t) written;
+    }
+    return 0;
+}
+
+/**
+ * Exécute une requête et écrit la réponse
+ *
+ * @param fd La connexion
+ * @param line La requête (modifiée par le découpage)
+ * @param cache Le cache du thread ou NULL
+ * @return int: 0 en cas de succès, -1 si la réponse n'a pas pu être envoyée
+ */
+static int server_handle(int fd, char *line, t_result_cache *cache) {
+    char *args[SERVER_MAX_FILTERS + 2];
+    int count = 0;
+    char *next = NULL;
+    for (char *token = strtok_r(line, " \t\r\n", &next); token != NULL; token = strtok_r(NULL, " \t\r\n", &next)) {
+        if (count == SERVER_MAX_FILTERS + 2) break;
+        args[count++] = token;
+    }
+
+    char reply[256];
+    if (count < 2) {
+        snprintf(reply, sizeof(reply), "ERREUR requête attendue : <entrée> <sortie> [filtre...]\n");
+    } else {
+        int cached = 0;
+        const char *error = NULL;
+        double start = server_now();
+        int status = job_run(args[0], args[1], args + 2, count - 2, cache, &cached, &error);
+        double elapsed = server_now() - start;
+        if (status == 0) snprintf(reply, sizeof(reply), "OK %.0f %d\n", elapsed, cached);
+        else snprintf(reply, sizeof(reply), "ERREUR %s\n", error != NULL ? error : "échec du traitement");
+    }
+    return server_writeAll(fd, reply, strlen(reply));
+}
+
+/**
+ * Traite les requêtes d'une connexion jusqu'à sa fermeture
+ *
+ * @param fd La connexion (fermée en fin de traitement)
+ * @param cache Le cache du thread ou NULL
+ */
+static void server_serve(int fd, t_result_cache *cache) {
+    FILE *input = fdopen(fd, "r");
+    if (input == NULL) {
+        close(fd);
+        return;
+    }
+
+    char line[SERVER_MAX_LINE];
+    while (fgets(line, sizeof(line), input) != NULL) {
+        size_t length = strlen(line);
+        if (length == sizeof(line) - 1 && line[length - 1] != '\n') {
+            // Requête plus longue que SERVER_MAX_LINE : refusée, et la fin de la ligne est ignorée
+            // au lieu d'être lue comme une nouvelle requête
+            int c;
+            while ((c = fgetc(input)) != EOF && c != '\n') {
+            }
+            const char *reply = "ERREUR requête trop longue\n";
+            if (server_writeAll(fd, reply, strlen(reply)) != 0) break;
+            continue;
+        }
+        if (server_handle(fd, line, cache) != 0) break;
+    }
+    fclose(input);
+}
+
+/**
+ * Thread de traitement : prend les connexions de la file une par une
+ *
+ * @param context La file
+ * @return void*: NULL
+ */
+static void *server_worker(void *context) {
+    t_server_queue *queue = (t_server_queue *) context;
+
+    // Un cache par thread : la mémoire n'est pas partagée, le dossier l'est
+    t_result_cache *cache = NULL;
+    if (queue->cacheDirectory != NULL) {
+        cache = cache_create(queue->cacheDirectory, SERVER_CACHE_MEMORY_BYTES, SERVER_CACHE_DISK_BYTES);
+    }
+
+    while (1) {
+        pthread_mutex_lock(&queue->lock);
+        while (queue->count == 0) pthread_cond_wait(&queue->ready, &queue->lock);
+        int fd = queue->fds[queue->head];
+        queue->head = (queue->head + 1) % SERVER_QUEUE;
+        queue->count--;
+        pthread_mutex_unlock(&queue->lock);
+
+        server_serve(fd, cache);
+    }
+    return NULL;
+}
+
+/**
+ * Démarre le serveur et traite les requêtes jusqu'à SIGINT ou SIGTERM
+ *
+ * @param socketPath Chemin du socket Unix (remplacé s'il existe déjà)
+ * @param workers Nombre de threads de traitement (au moins 1)
+ * @param cacheDirectory Dossier du cache de résultats, ou NULL sans cache
+ * @return int: Code de retour du programme
+ */
+int server_run(const char *socketPath, int workers, const char *cacheDirectory) {
+    struct sockaddr_un address;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Chemin de socket trop long : %s\n", socketPath);
+        return 1;
+    }
+    if (workers < 1) workers = 1;
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        fprintf(stderr, "Impossible de créer le socket : %s\n", strerror(errno));
+        return 1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    unlink(socketPath);
+
+    // Socket créé en mode 0600 : seul le propriétaire peut soumettre des traitements (le masque
+    // est propre au processus, modifié avant la création des threads)
+    mode_t previousMask = umask(0177);
+    int bound = bind(listener, (struct sockaddr *) &address, sizeof(address));
+    umask(previousMask);
+    if (bound != 0 || listen(listener, SERVER_QUEUE) != 0) {
+        fprintf(stderr, "Impossible d'écouter sur %s : %s\n", socketPath, strerror(errno));
+        close(listener);
+        return 1;
+    }
+
+    // Sans SA_RESTART, accept est interrompu par le signal d'arrêt
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = server_onSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN); // Client parti avant la réponse : erreur d'écriture, pas d'arrêt
+
+    static t_server_queue queue;
+    queue.head = 0;
+    queue.count = 0;
+    queue.cacheDirectory = cacheDirectory;
+    pthread_mutex_init(&queue.lock, NULL);
+    pthread_cond_init(&queue.ready, NULL);
+    for (int i = 0; i < workers; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, server_worker, &queue) != 0) {
+            fprintf(stderr, "Impossible de créer le thread de traitement %d\n", i);
+            close(listener);
+            unlink(socketPath);
+            return 1;
+        }
+        pthread_detach(thread);
+    }
+    fprintf(stderr, "Serveur à l'écoute sur %s (%d threads%s)\n", socketPath, workers,
+            cacheDirectory != NULL ? ", cache" : "");
+
+    while (!serverStop) {
+        int fd = accept(listener, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            fprintf(stderr, "Erreur d'acceptation : %s\n", strerror(errno));
+            break;
+        }
+
+        pthread_mutex_lock(&queue.lock);
+        if (queue.count == SERVER_QUEUE) {
+            pthread_mutex_unlock(&queue.lock);
+            close(fd); // File pleine : le client réessaiera
+            continue;
+        }
+        queue.fds[(queue.head + queue.count) % SERVER_QUEUE] = fd;
+        queue.count++;
+        pthread_cond_signal(&queue.ready);
+        pthread_mutex_unlock(&queue.lock);
+    }
+
+    // Les connexions en cours se terminent avec le processus
+    close(listener);
+    unlink(socketPath);
+    fprintf(stderr, "Serveur arrêté\n");
+    return 0;
+}
+
+/**
+ * Ordre croissant des latences (pour qsort)
+ */
+static int server_compareLatencies(const void *a, const void *b) {
+    double la = *(const double *) a, lb = *(const double *) b;
+    return (la > lb) - (la < lb);
+}
+
+/**
+ * Affiche le résumé d'une série de latences
+ *
+ * @param label Le nom de la série
+ * @param latencies Les latences en microsecondes (triées par la fonction)
+ * @param count Nombre de latences
+ */
+static void server_printLatencies(const char *label, double *latencies, int count) {
+    if (count == 0) return;
+    qsort(latencies, (size_t) count, sizeof(double), server_compareLatencies);
+    double total = 0;
+    for (int i = 0; i < count; i++) total += latencies[i];
+    printf("%-12s %6d requêtes  min %9.0f µs  médiane %9.0f µs  p99 %9.0f µs  moyenne %9.0f µs\n", label, count,
+           latencies[0], latencies[count / 2], latencies[(count - 1) * 99 / 100], total / count);
+}
+
+/**
+ * Mesure le même traitement lancé comme un nouveau processus à chaque requête
+ *
+ * @param program Chemin du programme
+ * @param requests Nombre de lancements
+ * @param job Entrée, sortie puis filtres
+ * @param count Nombre d'éléments de job
+ * @param latencies Reçoit les durées en microsecondes
+ * @return int: Nombre de lancements réussis
+ */
+static int server_measureProcesses(const char *program, int requests, char **job, int count, double *latencies) {
+    char **argv = (char **) malloc((size_t) (count + 3) * sizeof(char *));
+    if (argv == NULL) return 0;
+    argv[0] = (char *) program;
+    argv[1] = "--apply";
+    for (int i = 0; i < count; i++) argv[i + 2] = job[i];
+    argv[count + 2] = NULL;
+
+    int done = 0;
+    for (int i = 0; i < requests; i++) {
+        double start = server_now();
+        pid_t pid = fork();
+        if (pid == 0) {
+            int null = open("/dev/null", O_WRONLY);
+            if (null >= 0) dup2(null, STDOUT_FILENO);
+            execv(program, argv);
+            _exit(127);
+        }
+        int status;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) break;
+        latencies[done++] = server_now() - start;
+    }
+    free(argv);
+    return done;
+}
+
+/**
+ * Envoie plusieurs fois la même requête au serveur sur une connexion et affiche les latences
+ *
+ * @param socketPath Chemin du socket Unix du serveur
+ * @param requests Nombre de requêtes
+ * @param job Entrée, sortie puis filtres
+ * @param count Nombre d'éléments de job (au moins 2)
+ * @param program Chemin du programme pour la comparaison, ou NULL
+ * @return int: Code de retour du programme
+ */
+int server_client(const char *socketPath, int requests, char **job, int count, const char *program) {
+    struct sockaddr_un address;
+    if (count < 2 || requests < 1 || strlen(socketPath) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Requête invalide : <socket> <entrée> <sortie> [filtre...]\n");
+        return 1;
+    }
+
+    char request[SERVER_MAX_LINE];
+    size_t length = 0;
+    for (int i = 0; i < count; i++) {
+        int written = snprintf(request + length, sizeof(request) - length, i + 1 < count ? "%s " : "%s\n", job[i]);
+        if (written < 0 || (size_t) written >= sizeof(request) - length) {
+            fprintf(stderr, "Requête trop longue\n");
+            return 1;
+        }
+        length += (size_t) written;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0) {
+        fprintf(stderr, "Impossible de joindre le serveur %s : %s\n", socketPath, strerror(errno));
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+    FILE *replies = fdopen(fd, "r");
+    double *latencies = (double *) malloc((size_t) requests * sizeof(double));
+    if (replies == NULL || latencies == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        if (replies != NULL) fclose(replies);
+        else close(fd);
+        free(latencies);
+        return 1;
+    }
+
+    int done = 0, hits = 0;
+    double processing = 0;
+    char reply[256];
+    for (int i = 0; i < requests; i++) {
+        double start = server_now();
+        if (server_writeAll(fd, request, length) != 0 || fgets(reply, sizeof(reply), replies) == NULL) {
+            fprintf(stderr, "Connexion au serveur interrompue\n");
+            break;
+        }
+        latencies[done] = server_now() - start;
+
+        double elapsed;
+        int cached;
+        if (sscanf(reply, "OK %lf %d", &elapsed, &cached) != 2) {
+            fprintf(stderr, "Réponse du serveur : %s", reply);
+            break;
+        }
+        processing += elapsed;
+        hits += cached;
+        done++;
+    }
+    fclose(replies);
+
+    server_printLatencies("Serveur", latencies, done);
+    if (done > 0) {
+        printf("Traitement côté serveur : %.0f µs en moyenne, %d résultats du cache\n", processing / done, hits);
+    }
+
+    int status = done == requests ? 0 : 1;
+    if (program != NULL && status == 0) {
+        int launched = server_measureProcesses(program, requests, job, count, latencies);
+        server_printLatencies("Processus", latencies, launched);
+        if (launched != requests) {
+            fprintf(stderr, "Échec du lancement de %s --apply\n", program);
+            status = 1;
+        }
+    }
+    free(latencies);
+    return status;
+}
+
+#else
+
+int server_run(const char *socketPath, int workers, const char *cacheDirectory) {
+    (void) socketPath;
+    (void) workers;
+    (void) cacheDirectory;
+    fprintf(stderr, "Serveur de traitements non disponible sur cette plateforme (sockets Unix)\n");
+    return 1;
+}
+
+int server_client(const char *socketPath, int requests, char **job, int count, const char *program) {
+    (void) socketPath;
+    (void) requests;
+    (void) job;
+    (void) count;
+    (void) program;
+    fprintf(stderr, "Client du serveur non disponible sur cette plateforme (sockets Unix)\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+// Serveur de traitements sur socket Unix (Linux, macOS) : un processus démarré une seule fois
+// traite les images avec un groupe de threads, sans le coût d'un lancement de programme par image.
+// Protocole texte, une requête par ligne, plusieurs requêtes possibles par connexion :
+//   requête : <entrée> <sortie> [filtre...]   (fichiers dans ./images/..., filtres de job_applyFilter)
+//             une requête de plus de SERVER_MAX_LINE octets est refusée en entier
+//   réponse : OK <durée du traitement en µs> <1 si le résultat vient du cache, 0 sinon>
+//             ERREUR <cause>
+
+#define SERVER_MAX_LINE 4096 // Longueur maximale d'une requête
+#define SERVER_MAX_FILTERS 64 // Filtres maximaux par requête
+#define SERVER_CACHE_MEMORY_BYTES ((size_t) 64 << 20) // Cache mémoire de chaque thread
+#define SERVER_CACHE_DISK_BYTES ((size_t) 256 << 20) // Dossier du cache partagé
+
+/**
+ * Démarre le serveur et traite les requêtes jusqu'à SIGINT ou SIGTERM
+ *
+ * @param socketPath Chemin du socket Unix (remplacé s'il existe déjà)
+ * @param workers Nombre de threads de traitement (au moins 1)
+ * @param cacheDirectory Dossier du cache de résultats, ou NULL sans cache
+ * @return int: Code de retour du programme
+ */
+int server_run(const char *socketPath, int workers, const char *cacheDirectory);
+
+/**
+ * Envoie plusieurs fois la même requête au serveur sur une connexion et affiche les latences
+ * (minimum, médiane, 99e centile, moyenne). Avec program, mesure aussi le même traitement
+ * lancé comme un nouveau processus à chaque fois (program --apply ...), pour comparaison.
+ *
+ * @param socketPath Chemin du socket Unix du serveur
+ * @param requests Nombre de requêtes
+ * @param job Entrée, sortie puis filtres
+ * @param count Nombre d'éléments de job (au moins 2)
+ * @param program Chemin du programme pour la comparaison, ou NULL
+ * @return int: Code de retour du programme
+ */
+int server_client(const char *socketPath, int requests, char **job, int count, const char *program);
+
+#endif //SERVER_H
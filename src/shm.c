@@ -0,0 +1,365 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // memfd_create
+#endif
+
+#include "shm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Octets entre deux rangées d'une image partagée (mêmes rangées que les images en mémoire)
+ *
+ * @param depth 8 ou 24
+ * @param width Largeur en pixels
+ * @return uint32_t: La taille d'une rangée
+ */
+static uint32_t shm_stride(uint32_t depth, uint32_t width) {
+    return depth == 8 ? (width + 3) / 4 * 4 : width * (uint32_t) sizeof(t_pixel);
+}
+
+/**
+ * Construit l'image t_bmp8 ou t_bmp24 dont les pixels sont ceux du segment, après vérification de l'en-tête
+ *
+ * @param image L'image partagée (segment projeté)
+ * @return int: 0 en cas de succès, -1 si l'en-tête n'est pas valide
+ */
+static int shm_wrap(t_shm_image *image) {
+    const t_shm_header *header = image->header;
+    if (image->size < SHM_HEADER_SIZE || header->magic != SHM_MAGIC || header->version != SHM_VERSION ||
+        (header->depth != 8 && header->depth != 24) || header->width == 0 || header->height == 0 ||
+        header->width > 100000 || header->height > 100000 || header->dataOffset != SHM_HEADER_SIZE ||
+        header->stride != shm_stride(header->depth, header->width) ||
+        image->size < SHM_HEADER_SIZE + (size_t) header->stride * header->height) {
+        fprintf(stderr, "Segment partagé non valide (en-tête d'image incorrect)\n");
+        return -1;
+    }
+    unsigned char *pixels = (unsigned char *) image->header + header->dataOffset;
+
+    if (header->depth == 8) {
+        t_bmp8 *img = (t_bmp8 *) malloc(sizeof(t_bmp8));
+        if (img == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire\n");
+            return -1;
+        }
+        img->width = header->width;
+        img->height = header->height;
+        img->data = pixels;
+        bmp8_reset(img); // En-tête et palette de gris, pixels inchangés
+        img->colorDepth = header->colorDepth;
+        image->img8 = img;
+        return 0;
+    }
+
+    t_bmp24 *img = (t_bmp24 *) malloc(sizeof(t_bmp24));
+    t_pixel **rows = (t_pixel **) malloc(header->height * sizeof(t_pixel *));
+    if (img == NULL || rows == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        free(img);
+        free(rows);
+        return -1;
+    }
+    for (uint32_t y = 0; y < header->height; y++) {
+        rows[y] = (t_pixel *) (pixels + (size_t) y * header->stride);
+    }
+
+    memset(&img->header, 0, sizeof(img->header));
+    memset(&img->header_info, 0, sizeof(img->header_info));
+    img->width = (int) header->width;
+    img->height = (int) header->height;
+    img->colorDepth = (int) header->colorDepth;
+    img->masks[0] = 0x00FF0000u;
+    img->masks[1] = 0x0000FF00u;
+    img->masks[2] = 0x000000FFu;
+    img->masks[3] = 0xFF000000u;
+    img->topDown = 0;
+    img->data = rows;
+    image->img24 = img;
+    return 0;
+}
+
+/**
+ * Projette un segment ouvert et construit son image
+ *
+ * @param fd Le descripteur du segment (fermé en cas d'erreur)
+ * @param name Nom POSIX du segment ou NULL
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+static t_shm_image *shm_map(int fd, const char *name) {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < SHM_HEADER_SIZE) {
+        fprintf(stderr, "Segment partagé non valide ou vide\n");
+        close(fd);
+        return NULL;
+    }
+
+    t_shm_image *image = (t_shm_image *) calloc(1, sizeof(t_shm_image));
+    if (image == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire\n");
+        close(fd);
+        return NULL;
+    }
+    image->fd = fd;
+    image->size = (size_t) info.st_size;
+    if (name != NULL) snprintf(image->name, sizeof(image->name), "%s", name);
+
+    void *base = mmap(NULL, image->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Impossible de projeter le segment partagé : %s\n", strerror(errno));
+        close(fd);
+        free(image);
+        return NULL;
+    }
+    image->header = (t_shm_header *) base;
+
+    if (shm_wrap(image) != 0) {
+        munmap(base, image->size);
+        close(fd);
+        free(image);
+        return NULL;
+    }
+    return image;
+}
+
+/**
+ * Crée et dimensionne un segment, puis écrit son en-tête
+ *
+ * @param name Nom POSIX du segment, ou NULL pour un segment memfd
+ * @param depth 8 ou 24
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+static t_shm_image *shm_create(const char *name, uint32_t depth, uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0 || width > 100000 || height > 100000) {
+        fprintf(stderr, "Dimensions d'image invalides (%u x %u)\n", width, height);
+        return NULL;
+    }
+    if (name != NULL && strlen(name) >= SHM_NAME_MAX) {
+        fprintf(stderr, "Nom de segment trop long : %s\n", name);
+        return NULL;
+    }
+
+    int fd;
+    if (name == NULL) {
+#ifdef __linux__
+        fd = memfd_create("image_processing", 0);
+#else
+        fprintf(stderr, "Segments anonymes (memfd) disponibles seulement sous Linux\n");
+        return NULL;
+#endif
+    } else {
+        shm_unlink(name);
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+
+    uint32_t stride = shm_stride(depth, width);
+    size_t size = SHM_HEADER_SIZE + (size_t) stride * height;
+    if (fd < 0 || ftruncate(fd, (off_t) size) != 0) {
+        fprintf(stderr, "Impossible de créer le segment partagé : %s\n", strerror(errno));
+        if (fd >= 0) close(fd);
+        if (name != NULL) shm_unlink(name);
+        return NULL;
+    }
+
+    // ftruncate remplit le segment de zéros : seul l'en-tête est à écrire
+    void *base = mmap(NULL, SHM_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Impossible de projeter le segment partagé : %s\n", strerror(errno));
+        close(fd);
+        if (name != NULL) shm_unlink(name);
+        return NULL;
+    }
+    t_shm_header *header = (t_shm_header *) base;
+    header->magic = SHM_MAGIC;
+    header->version = SHM_VERSION;
+    header->depth = depth;
+    header->width = width;
+    header->height = height;
+    header->stride = stride;
+    header->dataOffset = SHM_HEADER_SIZE;
+    header->colorDepth = depth;
+    munmap(base, SHM_HEADER_SIZE);
+
+    t_shm_image *image = shm_map(fd, name);
+    if (image == NULL && name != NULL) shm_unlink(name);
+    return image;
+}
+
+/**
+ * Crée un segment partagé contenant une image 8 bits (pixels à 0, palette de gris)
+ *
+ * @param name Nom POSIX du segment ("/nom", remplacé s'il existe), ou NULL pour un segment anonyme memfd (Linux)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_createBmp8(const char *name, unsigned int width, unsigned int height) {
+    return shm_create(name, 8, width, height);
+}
+
+/**
+ * Crée un segment partagé contenant une image 24 bits (pixels à 0)
+ *
+ * @param name Nom POSIX du segment ("/nom", remplacé s'il existe), ou NULL pour un segment anonyme memfd (Linux)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_createBmp24(const char *name, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "Dimensions d'image invalides (%d x %d)\n", width, height);
+        return NULL;
+    }
+    return shm_create(name, 24, (uint32_t) width, (uint32_t) height);
+}
+
+/**
+ * S'attache à un segment partagé existant par son nom
+ *
+ * @param name Nom POSIX du segment ("/nom")
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_attach(const char *name) {
+    if (name == NULL || strlen(name) >= SHM_NAME_MAX) {
+        fprintf(stderr, "Nom de segment invalide\n");
+        return NULL;
+    }
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Segment partagé non trouvé : %s\n", name);
+        return NULL;
+    }
+    return shm_map(fd, name);
+}
+
+/**
+ * S'attache à un segment partagé par son descripteur
+ *
+ * @param fd Le descripteur (appartient ensuite à l'image, fermé par shm_detach)
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_attachFd(int fd) {
+    if (fd < 0) {
+        fprintf(stderr, "Descripteur de segment invalide\n");
+        return NULL;
+    }
+    return shm_map(fd, NULL);
+}
+
+/**
+ * Publie la trame courante
+ *
+ * @param image L'image partagée
+ * @return uint64_t: Le numéro de la trame publiée
+ */
+uint64_t shm_publish(t_shm_image *image) {
+    if (image == NULL) return 0;
+    if (image->img8 != NULL) bmp8_resolvePalette(image->img8);
+
+    // Libération : les écritures de pixels précèdent le nouveau numéro pour qui le lit en acquisition
+    return __atomic_add_fetch(&image->header->frame, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Numéro de la dernière trame publiée
+ *
+ * @param image L'image partagée
+ * @return uint64_t: Le numéro de trame (0 si aucune trame n'a été publiée)
+ */
+uint64_t shm_frame(const t_shm_image *image) {
+    if (image == NULL) return 0;
+    return __atomic_load_n(&image->header->frame, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Se détache d'un segment partagé (le segment reste disponible pour les autres processus)
+ *
+ * @param image L'image partagée
+ */
+void shm_detach(t_shm_image *image) {
+    if (image == NULL) return;
+
+    // Seules les structures locales sont libérées : les pixels appartiennent au segment
+    free(image->img8);
+    if (image->img24 != NULL) free(image->img24->data);
+    free(image->img24);
+    munmap(image->header, image->size);
+    close(image->fd);
+    free(image);
+}
+
+/**
+ * Supprime le nom d'un segment partagé
+ *
+ * @param name Nom POSIX du segment ("/nom")
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int shm_remove(const char *name) {
+    if (name == NULL || shm_unlink(name) != 0) {
+        fprintf(stderr, "Impossible de supprimer le segment partagé : %s\n", name != NULL ? name : "(null)");
+        return -1;
+    }
+    return 0;
+}
+
+#else
+
+t_shm_image *shm_createBmp8(const char *name, unsigned int width, unsigned int height) {
+    (void) name;
+    (void) width;
+    (void) height;
+    fprintf(stderr, "Mémoire partagée non disponible sur cette plateforme\n");
+    return NULL;
+}
+
+t_shm_image *shm_createBmp24(const char *name, int width, int height) {
+    (void) name;
+    (void) width;
+    (void) height;
+    fprintf(stderr, "Mémoire partagée non disponible sur cette plateforme\n");
+    return NULL;
+}
+
+t_shm_image *shm_attach(const char *name) {
+    (void) name;
+    fprintf(stderr, "Mémoire partagée non disponible sur cette plateforme\n");
+    return NULL;
+}
+
+t_shm_image *shm_attachFd(int fd) {
+    (void) fd;
+    fprintf(stderr, "Mémoire partagée non disponible sur cette plateforme\n");
+    return NULL;
+}
+
+uint64_t shm_publish(t_shm_image *image) {
+    (void) image;
+    return 0;
+}
+
+uint64_t shm_frame(const t_shm_image *image) {
+    (void) image;
+    return 0;
+}
+
+void shm_detach(t_shm_image *image) {
+    (void) image;
+}
+
+int shm_remove(const char *name) {
+    (void) name;
+    return -1;
+}
+
+#endif
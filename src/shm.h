@@ -0,0 +1,113 @@
+#ifndef SHM_H
+#define SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bmp8.h"
+#include "color.h"
+
+// Images dont les pixels sont en mémoire partagée (POSIX shm_open, ou memfd sous Linux) :
+// un processus producteur remplit l'image, un processus consommateur la filtre sur place,
+// sans fichier intermédiaire, sans sérialisation ni copie.
+// Le segment commence par un en-tête t_shm_header (64 octets) suivi des pixels, rangées dans
+// l'ordre de stockage des images : de bas en haut pour t_bmp8, de haut en bas pour t_bmp24.
+
+#define SHM_MAGIC 0x48535049u // "IPSH"
+#define SHM_VERSION 1
+#define SHM_HEADER_SIZE 64 // Pixels alignés sur une ligne de cache
+#define SHM_NAME_MAX 64
+
+// En-tête placé au début du segment partagé
+typedef struct {
+    uint32_t magic; // SHM_MAGIC
+    uint32_t version; // SHM_VERSION
+    uint32_t depth; // 8 (t_bmp8) ou 24 (t_bmp24, 4 octets par pixel)
+    uint32_t width; // Largeur en pixels
+    uint32_t height; // Hauteur en pixels
+    uint32_t stride; // Octets entre deux rangées
+    uint32_t dataOffset; // Position des pixels depuis le début du segment
+    uint32_t colorDepth; // Profondeur d'enregistrement (1, 4 ou 8 ; 24 ou 32)
+    uint64_t frame; // Nombre de trames publiées (shm_publish)
+} t_shm_header;
+
+// Image attachée à un segment partagé ; une seule des deux images est non NULL
+typedef struct {
+    t_shm_header *header; // Début du segment
+    size_t size; // Taille du segment en octets
+    int fd; // Descripteur du segment (transmissible par socket Unix pour un segment memfd)
+    char name[SHM_NAME_MAX]; // Nom POSIX ("/nom"), vide pour un segment memfd
+    t_bmp8 *img8; // Image 8 bits sur les pixels partagés
+    t_bmp24 *img24; // Image 24 bits sur les pixels partagés
+} t_shm_image;
+
+/**
+ * Crée un segment partagé contenant une image 8 bits (pixels à 0, palette de gris)
+ *
+ * @param name Nom POSIX du segment ("/nom", remplacé s'il existe), ou NULL pour un segment anonyme memfd (Linux)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_createBmp8(const char *name, unsigned int width, unsigned int height);
+
+/**
+ * Crée un segment partagé contenant une image 24 bits (pixels à 0)
+ *
+ * @param name Nom POSIX du segment ("/nom", remplacé s'il existe), ou NULL pour un segment anonyme memfd (Linux)
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_createBmp24(const char *name, int width, int height);
+
+/**
+ * S'attache à un segment partagé existant par son nom
+ *
+ * @param name Nom POSIX du segment ("/nom")
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_attach(const char *name);
+
+/**
+ * S'attache à un segment partagé par son descripteur (memfd reçu par socket Unix par exemple)
+ *
+ * @param fd Le descripteur (appartient ensuite à l'image, fermé par shm_detach)
+ * @return t_shm_image*: L'image partagée ou NULL en cas d'erreur
+ */
+t_shm_image *shm_attachFd(int fd);
+
+/**
+ * Publie la trame courante : les pixels modifiés sont visibles des autres processus
+ * avant le nouveau numéro de trame (palette éventuelle d'une image 8 bits appliquée aux pixels)
+ *
+ * @param image L'image partagée
+ * @return uint64_t: Le numéro de la trame publiée
+ */
+uint64_t shm_publish(t_shm_image *image);
+
+/**
+ * Numéro de la dernière trame publiée
+ *
+ * @param image L'image partagée
+ * @return uint64_t: Le numéro de trame (0 si aucune trame n'a été publiée)
+ */
+uint64_t shm_frame(const t_shm_image *image);
+
+/**
+ * Se détache d'un segment partagé (le segment reste disponible pour les autres processus)
+ * Les images img8 et img24 ne doivent pas être libérées avec bmp8_free ou bmp24_free
+ *
+ * @param image L'image partagée
+ */
+void shm_detach(t_shm_image *image);
+
+/**
+ * Supprime le nom d'un segment partagé (libéré quand le dernier processus s'en détache)
+ *
+ * @param name Nom POSIX du segment ("/nom")
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int shm_remove(const char *name);
+
+#endif //SHM_H
@@ -0,0 +1,332 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "trace.h"
+
+#if defined(_MSC_VER)
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#define TRACE_FETCH_ADD(counter) (InterlockedIncrement(counter) - 1)
+#else
+#define TRACE_THREAD_LOCAL __thread
+#define TRACE_FETCH_ADD(counter) __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED)
+#endif
+
+#define TRACE_MAX_OPERATIONS 128
+
+static t_trace_event *traceEvents = NULL;
+static long traceCapacity = 0;
+static volatile long traceCount = 0; // Événements réservés, y compris ceux perdus faute de place
+static volatile long traceThreads = 0;
+static volatile int traceEnabled = 0;
+static volatile int traceCounters = 0;
+static double traceOrigin = 0.0;
+
+static TRACE_THREAD_LOCAL int traceThread = 0; // 0 : numéro pas encore attribué
+static TRACE_THREAD_LOCAL int traceThreadCounters = 0; // 0 : pas encore ouverts, 1 : ouverts, -1 : indisponibles
+
+/**
+ * Renvoie un instant de l'horloge monotone
+ *
+ * @return double: Temps en microsecondes
+ */
+static double trace_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart * 1e6 / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec * 1e-3;
+#endif
+}
+
+/**
+ * Active le traçage et réserve la mémoire des événements
+ *
+ * @param capacity Nombre maximal d'événements conservés
+ * @return int: 0 en cas de succès, -1 si le traçage n'est pas compilé ou en cas d'erreur d'allocation
+ */
+int trace_start(size_t capacity) {
+#ifndef IMAGE_PROCESSING_TRACE
+    (void) capacity;
+    fprintf(stderr, "Traçage non disponible : recompiler avec l'option IMAGE_PROCESSING_TRACE\n");
+    return -1;
+#else
+    trace_free();
+    if (capacity == 0) capacity = 1;
+
+    traceEvents = (t_trace_event *) malloc(capacity * sizeof(t_trace_event));
+    if (traceEvents == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le traçage\n");
+        return -1;
+    }
+
+    traceCapacity = (long) capacity;
+    traceCount = 0;
+    traceOrigin = trace_now();
+    traceEnabled = 1;
+    return 0;
+#endif
+}
+
+/**
+ * Désactive le traçage
+ */
+void trace_stop(void) {
+    traceEnabled = 0;
+}
+
+/**
+ * Libère les événements enregistrés et désactive le traçage
+ */
+void trace_free(void) {
+    traceEnabled = 0;
+    free(traceEvents);
+    traceEvents = NULL;
+    traceCapacity = 0;
+    traceCount = 0;
+}
+
+/**
+ * Ouvre au besoin les compteurs matériels du thread appelant
+ *
+ * @return int: 1 si les compteurs du thread sont utilisables, 0 sinon
+ */
+static int trace_threadCounters(void) {
+    if (traceThreadCounters == 0) {
+        traceThreadCounters = perfcount_open() == 0 ? 1 : -1;
+    }
+    return traceThreadCounters == 1;
+}
+
+/**
+ * Active ou désactive le relevé des compteurs matériels pour chaque opération tracée
+ *
+ * @param enable 1 pour relever les compteurs, 0 sinon
+ * @return int: 0 en cas de succès, -1 si les compteurs ne sont pas disponibles
+ */
+int trace_enableCounters(int enable) {
+    if (!enable) {
+        traceCounters = 0;
+        return 0;
+    }
+    if (!trace_threadCounters()) {
+        fprintf(stderr, "Compteurs matériels indisponibles (%s), traçage sans compteurs\n", perfcount_error());
+        traceCounters = 0;
+        return -1;
+    }
+
+    traceCounters = 1;
+    return 0;
+}
+
+/**
+ * Indique si le traçage est actif
+ *
+ * @return int: 1 si les opérations sont enregistrées, 0 sinon
+ */
+int trace_isEnabled(void) {
+    return traceEnabled;
+}
+
+/**
+ * Début d'une opération tracée
+ *
+ * @param name Nom de l'opération (chaîne constante)
+ * @return t_trace_span: L'intervalle à terminer par trace_end
+ */
+t_trace_span trace_begin(const char *name) {
+    t_trace_span span;
+    span.name = NULL;
+    span.counted = 0;
+    if (!traceEnabled) return span;
+
+    span.name = name;
+    span.start = trace_now();
+    // Compteurs relevés en dernier pour ne pas compter le traçage lui-même
+    if (traceCounters && trace_threadCounters()) {
+        span.counted = perfcount_read(span.counters) == 0;
+    }
+    return span;
+}
+
+/**
+ * Fin d'une opération tracée : enregistre l'événement s'il reste de la place
+ *
+ * @param span L'intervalle renvoyé par trace_begin
+ * @param width Largeur de l'image traitée
+ * @param height Hauteur de l'image traitée
+ * @param bytes Octets de pixels lus et écrits
+ */
+void trace_end(const t_trace_span *span, int width, int height, size_t bytes) {
+    if (span->name == NULL || !traceEnabled) return;
+
+    uint64_t counters[PERFCOUNT_EVENTS];
+    int counted = span->counted && perfcount_read(counters) == 0;
+    double end = trace_now();
+    if (traceThread == 0) traceThread = (int) TRACE_FETCH_ADD(&traceThreads) + 1;
+
+    long index = TRACE_FETCH_ADD(&traceCount);
+    if (index >= traceCapacity) return;
+
+    t_trace_event *event = &traceEvents[index];
+    event->name = span->name;
+    event->start = span->start - traceOrigin;
+    event->duration = end - span->start;
+    event->thread = traceThread;
+    event->width = width;
+    event->height = height;
+    event->bytes = bytes;
+    event->counted = counted;
+    for (int i = 0; i < PERFCOUNT_EVENTS; i++) {
+        event->counters[i] = counted ? counters[i] - span->counters[i] : 0;
+    }
+}
+
+/**
+ * Renvoie les événements enregistrés
+ *
+ * @param count Reçoit le nombre d'événements
+ * @return const t_trace_event*: Les événements
+ */
+const t_trace_event *trace_events(size_t *count) {
+    *count = (size_t) (traceCount < traceCapacity ? traceCount : traceCapacity);
+    return traceEvents;
+}
+
+/**
+ * Écrit les événements au format Chrome Trace
+ *
+ * @param filename Chemin du fichier JSON à écrire
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int trace_writeChrome(const char *filename) {
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Impossible de créer le fichier : %s\n", filename);
+        return -1;
+    }
+
+    size_t count;
+    const t_trace_event *events = trace_events(&count);
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    for (size_t i = 0; i < count; i++) {
+        const t_trace_event *event = &events[i];
+        fprintf(file, "%s\n{\"name\": \"%s\", \"cat\": \"image\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, "
+                      "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"width\": %d, \"height\": %d, \"bytes\": %zu",
+                i == 0 ? "" : ",", event->name, event->thread, event->start, event->duration,
+                event->width, event->height, event->bytes);
+        if (event->counted) {
+            fprintf(file, ", \"cycles\": %llu, \"instructions\": %llu, \"cache_misses\": %llu, \"branch_misses\": %llu",
+                    (unsigned long long) event->counters[PERFCOUNT_CYCLES],
+                    (unsigned long long) event->counters[PERFCOUNT_INSTRUCTIONS],
+                    (unsigned long long) event->counters[PERFCOUNT_CACHE_MISSES],
+                    (unsigned long long) event->counters[PERFCOUNT_BRANCH_MISSES]);
+        }
+        fprintf(file, "}}");
+    }
+    fprintf(file, "\n]}\n");
+
+    if (fclose(file) == EOF) {
+        fprintf(stderr, "Impossible de fermer le fichier\n");
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct {
+    const char *name;
+    unsigned long calls;
+    double total; // Microsecondes
+    double max;
+    double bytes;
+    // Opérations dont les compteurs ont été relevés
+    unsigned long countedCalls;
+    double countedPixels;
+    double countedBytes;
+    double counters[PERFCOUNT_EVENTS];
+} t_trace_total;
+
+/**
+ * Ordre décroissant du temps total
+ */
+static int trace_compareTotals(const void *a, const void *b) {
+    double ta = ((const t_trace_total *) a)->total;
+    double tb = ((const t_trace_total *) b)->total;
+    return (ta < tb) - (ta > tb);
+}
+
+/**
+ * Affiche le temps passé par opération
+ */
+void trace_printSummary(void) {
+    size_t count;
+    const t_trace_event *events = trace_events(&count);
+
+    t_trace_total totals[TRACE_MAX_OPERATIONS];
+    int operations = 0;
+    for (size_t i = 0; i < count; i++) {
+        int k = 0;
+        while (k < operations && strcmp(totals[k].name, events[i].name) != 0) k++;
+        if (k == operations) {
+            if (operations == TRACE_MAX_OPERATIONS) continue;
+            memset(&totals[k], 0, sizeof(t_trace_total));
+            totals[k].name = events[i].name;
+            operations++;
+        }
+        totals[k].calls++;
+        totals[k].total += events[i].duration;
+        totals[k].bytes += (double) events[i].bytes;
+        if (events[i].duration > totals[k].max) totals[k].max = events[i].duration;
+        if (events[i].counted) {
+            totals[k].countedCalls++;
+            totals[k].countedPixels += (double) events[i].width * events[i].height;
+            totals[k].countedBytes += (double) events[i].bytes;
+            for (int c = 0; c < PERFCOUNT_EVENTS; c++) totals[k].counters[c] += (double) events[i].counters[c];
+        }
+    }
+    qsort(totals, (size_t) operations, sizeof(t_trace_total), trace_compareTotals);
+
+    printf("%-28s %8s %12s %12s %12s %10s\n", "Opération", "Appels", "Total (ms)", "Moyenne (ms)", "Max (ms)",
+           "Mo/s");
+    for (int k = 0; k < operations; k++) {
+        printf("%-28s %8lu %12.3f %12.3f %12.3f %10.1f\n", totals[k].name, totals[k].calls, totals[k].total / 1e3,
+               totals[k].total / 1e3 / totals[k].calls, totals[k].max / 1e3,
+               totals[k].total > 0.0 ? totals[k].bytes / totals[k].total : 0.0);
+    }
+
+    int counted = 0;
+    for (int k = 0; k < operations; k++) counted |= totals[k].countedCalls > 0;
+    if (counted) {
+        printf("\nCompteurs matériels (thread appelant, par pixel)\n");
+        printf("%-28s %8s %8s %10s %10s %12s %12s\n", "Opération", "Appels", "IPC", "Octets/px", "Cycles/px",
+               "Déf. cache/px", "Mauv. br./px");
+        for (int k = 0; k < operations; k++) {
+            if (totals[k].countedCalls == 0 || totals[k].countedPixels <= 0.0) continue;
+            double pixels = totals[k].countedPixels;
+            double cycles = totals[k].counters[PERFCOUNT_CYCLES];
+            printf("%-28s %8lu %8.2f %10.2f %10.2f %12.4f %12.4f\n", totals[k].name, totals[k].countedCalls,
+                   cycles > 0.0 ? totals[k].counters[PERFCOUNT_INSTRUCTIONS] / cycles : 0.0,
+                   totals[k].countedBytes / pixels, cycles / pixels,
+                   totals[k].counters[PERFCOUNT_CACHE_MISSES] / pixels,
+                   totals[k].counters[PERFCOUNT_BRANCH_MISSES] / pixels);
+        }
+    }
+    if (traceCount > traceCapacity) {
+        printf("⚠️ %ld événements perdus (capacité de %ld atteinte)\n", traceCount - traceCapacity, traceCapacity);
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+
+#include "perfcount.h"
+
+// Traçage des opérations de la bibliothèque : chaque opération publique enregistre sa durée,
+// le thread appelant, la taille de l'image et les octets lus et écrits.
+// Le traçage est compilé seulement avec IMAGE_PROCESSING_TRACE (option CMake du même nom) ;
+// sans cette option TRACE_BEGIN / TRACE_END ne coûtent rien. Une fois compilé, il reste
+// désactivé tant que trace_start n'a pas été appelé.
+// Les opérations imbriquées (un filtre prédéfini qui appelle la convolution, ...) donnent des
+// intervalles imbriqués : les durées du résumé sont inclusives.
+// Avec trace_enableCounters, chaque opération relève aussi les compteurs matériels du thread
+// appelant (voir perfcount.h) ; le travail des threads OpenMP auxiliaires n'y figure pas.
+
+typedef struct {
+    const char *name; // Nom de l'opération (chaîne constante), NULL si le traçage est désactivé
+    double start; // Début en microsecondes
+    int counted; // 1 si les compteurs matériels ont été relevés au début
+    uint64_t counters[PERFCOUNT_EVENTS];
+} t_trace_span;
+
+typedef struct {
+    const char *name;
+    double start; // Début en microsecondes depuis trace_start
+    double duration; // Durée en microsecondes
+    int thread; // Numéro du thread appelant (attribué au premier événement de chaque thread)
+    int width;
+    int height;
+    size_t bytes; // Octets de pixels lus et écrits
+    int counted; // 1 si counters est renseigné
+    uint64_t counters[PERFCOUNT_EVENTS]; // Cycles, instructions, défauts de cache, mauvaises prédictions
+} t_trace_event;
+
+#ifdef IMAGE_PROCESSING_TRACE
+#define TRACE_BEGIN(name) t_trace_span traceSpan = trace_begin(name)
+#define TRACE_END(width, height, bytes) trace_end(&traceSpan, (int) (width), (int) (height), (size_t) (bytes))
+#else
+#define TRACE_BEGIN(name) ((void) 0)
+#define TRACE_END(width, height, bytes) ((void) 0)
+#endif
+
+/**
+ * Active le traçage et réserve la mémoire des événements (les événements précédents sont effacés)
+ *
+ * @param capacity Nombre maximal d'événements conservés (les suivants sont comptés comme perdus)
+ * @return int: 0 en cas de succès, -1 si le traçage n'est pas compilé ou en cas d'erreur d'allocation
+ */
+int trace_start(size_t capacity);
+
+/**
+ * Désactive le traçage (les événements enregistrés restent disponibles pour l'export)
+ */
+void trace_stop(void);
+
+/**
+ * Libère les événements enregistrés et désactive le traçage
+ */
+void trace_free(void);
+
+/**
+ * Active ou désactive le relevé des compteurs matériels pour chaque opération tracée
+ *
+ * @param enable 1 pour relever les compteurs, 0 sinon
+ * @return int: 0 en cas de succès, -1 si les compteurs ne sont pas disponibles (le traçage continue sans eux)
+ */
+int trace_enableCounters(int enable);
+
+/**
+ * Indique si le traçage est actif
+ *
+ * @return int: 1 si les opérations sont enregistrées, 0 sinon
+ */
+int trace_isEnabled(void);
+
+/**
+ * Début d'une opération tracée (utiliser TRACE_BEGIN)
+ *
+ * @param name Nom de l'opération (chaîne constante)
+ * @return t_trace_span: L'intervalle à terminer par trace_end
+ */
+t_trace_span trace_begin(const char *name);
+
+/**
+ * Fin d'une opération tracée (utiliser TRACE_END) ; une opération interrompue par une erreur
+ * n'appelle pas trace_end et n'est pas enregistrée
+ *
+ * @param span L'intervalle renvoyé par trace_begin
+ * @param width Largeur de l'image traitée
+ * @param height Hauteur de l'image traitée
+ * @param bytes Octets de pixels lus et écrits
+ */
+void trace_end(const t_trace_span *span, int width, int height, size_t bytes);
+
+/**
+ * Renvoie les événements enregistrés (à lire après trace_stop)
+ *
+ * @param count Reçoit le nombre d'événements
+ * @return const t_trace_event*: Les événements, dans l'ordre de fin des opérations
+ */
+const t_trace_event *trace_events(size_t *count);
+
+/**
+ * Écrit les événements au format Chrome Trace (chrome://tracing, ui.perfetto.dev)
+ *
+ * @param filename Chemin du fichier JSON à écrire
+ * @return int: 0 en cas de succès, -1 en cas d'erreur
+ */
+int trace_writeChrome(const char *filename);
+
+/**
+ * Affiche le temps passé par opération (nombre d'appels, total, moyenne, maximum, débit),
+ * puis, si des compteurs ont été relevés, les IPC, octets, défauts de cache et mauvaises
+ * prédictions de branchement par pixel
+ */
+void trace_printSummary(void);
+
+#endif //TRACE_H
@@ -4,7 +4,7 @@
 #include <string.h>
 
 /**
- * Détermine le type d'un fichier BMP (8 ou 24 bits par pixel)
+ * Détermine le type d'un fichier BMP (1, 4, 8, 24 ou 32 bits par pixel)
  *
  * @param filename Le chemin vers le fichier BMP à analyser
  * @return BMP_Type: Le type de BMP identifié ou une valeur d'erreur
@@ -41,9 +41,43 @@ BMP_Type bmp_getFileType(const char *filename) {
     fclose(file);
 
     // Retourner le type selon la profondeur de bits
-    if (colorDepth == 8) return BMP_8BIT;
-    if (colorDepth == 24) return BMP_24BIT;
+    // Les images 1 et 4 bits sont décompactées dans un t_bmp8
+    if (colorDepth == 1 || colorDepth == 4 || colorDepth == 8) return BMP_8BIT;
+    // Les images 32 bits sont chargées dans un t_bmp24 comme les images 24 bits
+    if (colorDepth == 24 || colorDepth == 32) return BMP_24BIT;
 
     fprintf(stderr, "⚠️ Profondeur de couleur non supportée (%d bits)\n", colorDepth);
     return BMP_UNKNOWN;
 }
+
+/**
+ * Ramène une coordonnée éventuellement hors de l'image dans l'intervalle [0, size - 1]
+ * selon la politique de bord choisie
+ *
+ * @param pos La coordonnée à ramener (peut être négative ou >= size)
+ * @param size La taille de la dimension (largeur ou hauteur)
+ * @param mode La politique de bord
+ * @return int: La coordonnée dans l'image, ou -1 si le voisin n'existe pas (BORDER_CONSTANT, BORDER_SKIP)
+ */
+int bmp_borderIndex(int pos, int size, t_border_mode mode) {
+    if (pos >= 0 && pos < size) return pos;
+    if (size <= 0) return -1;
+
+    switch (mode) {
+        case BORDER_CLAMP:
+            return pos < 0 ? 0 : size - 1;
+        case BORDER_MIRROR: {
+            if (size == 1) return 0;
+            // Période de la réflexion : 2 * (size - 1)
+            int period = 2 * (size - 1);
+            pos %= period;
+            if (pos < 0) pos += period;
+            return pos < size ? pos : period - pos;
+        }
+        case BORDER_WRAP:
+            pos %= size;
+            return pos < 0 ? pos + size : pos;
+        default:
+            return -1;
+    }
+}
@@ -8,12 +8,32 @@ typedef enum {
     BMP_ERROR = -1
 } BMP_Type;
 
+// Politique de gestion des bords pour les filtres de convolution
+typedef enum {
+    BORDER_CLAMP = 0, // Répète le pixel du bord (aaa|abcd|ddd)
+    BORDER_MIRROR, // Réflexion sans répéter le bord (cb|abcd|cb)
+    BORDER_WRAP, // Image considérée comme périodique (cd|abcd|ab)
+    BORDER_CONSTANT, // Valeur constante en dehors de l'image
+    BORDER_SKIP // Les pixels du bord ne sont pas modifiés
+} t_border_mode;
+
 /**
  * Détermine si un fichier BMP est au format 8 bits ou 24 bits
  *
  * @param filename Le chemin vers le fichier BMP
- * @return BMP_Type: BMP_8BIT (8), BMP_24BIT (24), BMP_UNKNOWN (0) ou BMP_ERROR (-1) en cas d'erreur
+ * @return BMP_Type: BMP_8BIT (1, 4 ou 8 bits), BMP_24BIT (24 ou 32 bits), BMP_UNKNOWN (0) ou BMP_ERROR (-1) en cas d'erreur
  */
 BMP_Type bmp_getFileType(const char *filename);
 
+/**
+ * Ramène une coordonnée éventuellement hors de l'image dans l'intervalle [0, size - 1]
+ * selon la politique de bord choisie
+ *
+ * @param pos La coordonnée à ramener (peut être négative ou >= size)
+ * @param size La taille de la dimension (largeur ou hauteur)
+ * @param mode La politique de bord
+ * @return int: La coordonnée dans l'image, ou -1 si le voisin n'existe pas (BORDER_CONSTANT, BORDER_SKIP)
+ */
+int bmp_borderIndex(int pos, int size, t_border_mode mode);
+
 #endif
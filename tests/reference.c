@@ -0,0 +1,554 @@
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "reference.h"
+
+// Coefficients BT.601 en virgule fixe, recopiés de colorspace.c au moment du gel
+#define REF_Q14_SHIFT 14
+#define REF_Q12_SHIFT 12
+#define REF_LUMA_R 4899
+#define REF_LUMA_G 9617
+#define REF_LUMA_B 1868
+#define REF_CB_R (-2765)
+#define REF_CB_G (-5427)
+#define REF_CB_B 8192
+#define REF_CR_R 8192
+#define REF_CR_G (-6860)
+#define REF_CR_B (-1332)
+#define REF_U_R (-2411)
+#define REF_U_G (-4733)
+#define REF_U_B 7143
+#define REF_V_R 10076
+#define REF_V_G (-8438)
+#define REF_V_B (-1639)
+#define REF_YCC_R_CR 5743
+#define REF_YCC_G_CB (-1410)
+#define REF_YCC_G_CR (-2925)
+#define REF_YCC_B_CB 7258
+#define REF_YUV_R_V 4669
+#define REF_YUV_G_U (-1616)
+#define REF_YUV_G_V (-2378)
+#define REF_YUV_B_U 8324
+
+/**
+ * Limite une valeur entière à l'intervalle [0, 255]
+ *
+ * @param value La valeur
+ * @return uint8_t: La valeur limitée
+ */
+static uint8_t ref_clamp(int32_t value) {
+    return (uint8_t) (value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/**
+ * Arrondi au plus proche d'une valeur en virgule fixe
+ *
+ * @param sum La valeur en virgule fixe
+ * @param shift Nombre de bits de la partie fractionnaire
+ * @return int32_t: La valeur arrondie
+ */
+static int32_t ref_round(int32_t sum, int shift) {
+    return (sum + (1 << (shift - 1))) >> shift;
+}
+
+/**
+ * Ramène une coordonnée hors de l'image dans l'intervalle [0, size - 1] selon la politique de bord
+ *
+ * @param pos La coordonnée
+ * @param size La taille de la dimension
+ * @param mode La politique de bord
+ * @return int: La coordonnée dans l'image, ou -1 si le voisin n'existe pas
+ */
+int ref_borderIndex(int pos, int size, t_border_mode mode) {
+    if (pos >= 0 && pos < size) return pos;
+    if (size <= 0) return -1;
+
+    switch (mode) {
+        case BORDER_CLAMP:
+            return pos < 0 ? 0 : size - 1;
+        case BORDER_MIRROR: {
+            if (size == 1) return 0;
+            // Réflexion pas à pas, sans arithmétique modulaire
+            while (pos < 0 || pos >= size) {
+                if (pos < 0) pos = -pos;
+                if (pos >= size) pos = 2 * (size - 1) - pos;
+            }
+            return pos;
+        }
+        case BORDER_WRAP:
+            while (pos < 0) pos += size;
+            while (pos >= size) pos -= size;
+            return pos;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Indique si le voisinage complet d'un pixel est dans l'image
+ */
+static int ref_isInterior(int x, int y, int width, int height, int n) {
+    return x >= n && x < width - n && y >= n && y < height - n;
+}
+
+/**
+ * Convolution 8 bits pixel par pixel (somme en float dans l'ordre des lignes puis des colonnes du noyau)
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param kernel Le noyau (kernelSize x kernelSize)
+ * @param kernelSize Taille du noyau (impaire)
+ * @param border La politique de bord
+ * @param constant Valeur hors de l'image pour BORDER_CONSTANT
+ */
+void ref_filter8(unsigned char *data, int width, int height, int stride,
+                 float **kernel, int kernelSize, t_border_mode border, unsigned char constant) {
+    int n = kernelSize / 2;
+    unsigned char *copy = (unsigned char *) malloc((size_t) width * height);
+    if (copy == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la référence\n");
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(copy + (size_t) y * width, data + (ptrdiff_t) y * stride, width);
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (border == BORDER_SKIP && !ref_isInterior(x, y, width, height, n)) continue;
+
+            float sum = 0.0f;
+            for (int i = -n; i <= n; i++) {
+                for (int j = -n; j <= n; j++) {
+                    int sy = ref_borderIndex(y + i, height, border);
+                    int sx = ref_borderIndex(x + j, width, border);
+                    unsigned char value = (sy < 0 || sx < 0) ? constant : copy[(size_t) sy * width + sx];
+                    sum += value * kernel[i + n][j + n];
+                }
+            }
+
+            int newValue = (int) sum;
+            if (newValue > 255) newValue = 255;
+            if (newValue < 0) newValue = 0;
+            data[(ptrdiff_t) y * stride + x] = (unsigned char) newValue;
+        }
+    }
+
+    free(copy);
+}
+
+/**
+ * Convolution 24 bits pixel par pixel, canal par canal
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ * @param kernel Le noyau (kernelSize x kernelSize)
+ * @param kernelSize Taille du noyau (impaire)
+ * @param border La politique de bord
+ * @param constant Couleur hors de l'image pour BORDER_CONSTANT
+ */
+void ref_filter24(t_pixel *data, int width, int height, int stride,
+                  float **kernel, int kernelSize, t_border_mode border, t_pixel constant) {
+    int n = kernelSize / 2;
+    t_pixel *copy = (t_pixel *) malloc((size_t) stride * height * sizeof(t_pixel));
+    if (copy == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la référence\n");
+        return;
+    }
+    memcpy(copy, data, (size_t) stride * height * sizeof(t_pixel));
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (border == BORDER_SKIP && !ref_isInterior(x, y, width, height, n)) continue;
+
+            float sumRed = 0.0f, sumGreen = 0.0f, sumBlue = 0.0f;
+            for (int i = -n; i <= n; i++) {
+                for (int j = -n; j <= n; j++) {
+                    int sy = ref_borderIndex(y + i, height, border);
+                    int sx = ref_borderIndex(x + j, width, border);
+                    const t_pixel *p = (sy < 0 || sx < 0) ? &constant : &copy[(size_t) sy * stride + sx];
+                    sumRed += p->red * kernel[i + n][j + n];
+                    sumGreen += p->green * kernel[i + n][j + n];
+                    sumBlue += p->blue * kernel[i + n][j + n];
+                }
+            }
+
+            t_pixel *dst = &data[(size_t) y * stride + x];
+            dst->red = (sumRed > 255) ? 255 : ((sumRed < 0) ? 0 : (uint8_t) sumRed);
+            dst->green = (sumGreen > 255) ? 255 : ((sumGreen < 0) ? 0 : (uint8_t) sumGreen);
+            dst->blue = (sumBlue > 255) ? 255 : ((sumBlue < 0) ? 0 : (uint8_t) sumBlue);
+        }
+    }
+
+    free(copy);
+}
+
+/**
+ * Table d'égalisation d'histogramme (CDF normalisée, arrondie au plus proche)
+ *
+ * @param hist L'histogramme
+ * @param lut Reçoit la nouvelle valeur de chaque niveau
+ */
+void ref_equalizationLut(const unsigned int hist[256], unsigned char lut[256]) {
+    unsigned int cdf[256];
+    cdf[0] = hist[0];
+    for (int i = 1; i < 256; i++) {
+        cdf[i] = cdf[i - 1] + hist[i];
+    }
+
+    unsigned int cdf_min = 0;
+    for (int i = 0; i < 256; i++) {
+        if (cdf[i] > 0) {
+            cdf_min = cdf[i];
+            break;
+        }
+    }
+
+    unsigned int N = cdf[255];
+    for (int i = 0; i < 256; i++) {
+        if (cdf[i] < cdf_min) {
+            lut[i] = 0;
+        } else if (N == cdf_min) {
+            lut[i] = (unsigned char) i;
+        } else {
+            lut[i] = (unsigned char) round(((double) (cdf[i] - cdf_min) / (double) (N - cdf_min)) * 255.0);
+        }
+    }
+}
+
+/**
+ * Égalisation d'histogramme d'une image 8 bits
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ */
+void ref_equalize8(unsigned char *data, int width, int height, int stride) {
+    unsigned int hist[256] = {0};
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            hist[data[(ptrdiff_t) y * stride + x]]++;
+        }
+    }
+
+    unsigned char lut[256];
+    ref_equalizationLut(hist, lut);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            data[(ptrdiff_t) y * stride + x] = lut[data[(ptrdiff_t) y * stride + x]];
+        }
+    }
+}
+
+/**
+ * Égalisation de la luminance d'une image 24 bits par conversion YUV en virgule flottante,
+ * recopiée de la version d'origine de bmp24_equalize (avant le passage en virgule fixe)
+ * Seul le cas d'une image d'une seule luminance, où l'original divisait 0 par 0, garde les niveaux
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ */
+void ref_equalize24(t_pixel *data, int width, int height, int stride) {
+    // Nombre de pixels dans l'image
+    unsigned int pixelCount = width * height;
+
+    // 1. Conversion RGB vers YUV (Y: luminance, U,V: chrominance)
+    float *Y = (float *) malloc(pixelCount * sizeof(float));
+    float *U = (float *) malloc(pixelCount * sizeof(float));
+    float *V = (float *) malloc(pixelCount * sizeof(float));
+
+    if (Y == NULL || U == NULL || V == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la référence\n");
+        if (Y) free(Y);
+        if (U) free(U);
+        if (V) free(V);
+        return;
+    }
+
+    // RGB -> YUV (formule standard de conversion)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            unsigned int idx = y * width + x;
+            unsigned char R = data[(size_t) y * stride + x].red;
+            unsigned char G = data[(size_t) y * stride + x].green;
+            unsigned char B = data[(size_t) y * stride + x].blue;
+
+            Y[idx] = 0.299 * R + 0.587 * G + 0.114 * B;          // Luminance
+            U[idx] = -0.14713 * R - 0.28886 * G + 0.436 * B;     // Chrominance bleue
+            V[idx] = 0.615 * R - 0.51499 * G - 0.10001 * B;      // Chrominance rouge
+        }
+    }
+
+    // 2. Calcul de l'histogramme de la composante Y (luminance)
+    unsigned int hist[256] = {0};
+    for (unsigned int i = 0; i < pixelCount; i++) {
+        unsigned char y = (unsigned char) (Y[i] < 0 ? 0 : (Y[i] > 255 ? 255 : Y[i]));
+        hist[y]++;
+    }
+
+    // 3. Calcul de la CDF (Fonction de Distribution Cumulative)
+    unsigned int cdf[256];
+    cdf[0] = hist[0];
+    for (int i = 1; i < 256; i++) {
+        cdf[i] = cdf[i - 1] + hist[i];
+    }
+
+    // Trouver cdf_min (la première valeur non nulle dans la CDF)
+    unsigned int cdf_min = 0;
+    for (int i = 0; i < 256; i++) {
+        if (cdf[i] > 0) {
+            cdf_min = cdf[i];
+            break;
+        }
+    }
+
+    // 3. Normalisation de la CDF pour obtenir l'histogramme égalisé
+    unsigned int hist_eq[256];
+    for (int i = 0; i < 256; i++) {
+        if (cdf[i] < cdf_min) {
+            hist_eq[i] = 0;
+        } else if (pixelCount == cdf_min) {
+            hist_eq[i] = (unsigned int) i;
+        } else {
+            hist_eq[i] = (unsigned int) round(((double) (cdf[i] - cdf_min) / (double) (pixelCount - cdf_min)) * 255.0);
+        }
+    }
+
+    // 4. Application de l'égalisation à la composante Y uniquement
+    for (unsigned int i = 0; i < pixelCount; i++) {
+        unsigned char y = (unsigned char) (Y[i] < 0 ? 0 : (Y[i] > 255 ? 255 : Y[i]));
+        Y[i] = hist_eq[y];
+    }
+
+    // 5. Reconversion YUV vers RGB
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            unsigned int idx = y * width + x;
+            float y_val = Y[idx];
+            float u = U[idx];
+            float v = V[idx];
+
+            // Formules de conversion YUV vers RGB
+            int r = (int) (y_val + 1.13983 * v);
+            int g = (int) (y_val - 0.39465 * u - 0.58060 * v);
+            int b = (int) (y_val + 2.03211 * u);
+
+            // Limiter les valeurs à l'intervalle [0, 255]
+            r = (r < 0) ? 0 : ((r > 255) ? 255 : r);
+            g = (g < 0) ? 0 : ((g > 255) ? 255 : g);
+            b = (b < 0) ? 0 : ((b > 255) ? 255 : b);
+
+            // Mise à jour des valeurs des pixels
+            data[(size_t) y * stride + x].red = (unsigned char) r;
+            data[(size_t) y * stride + x].green = (unsigned char) g;
+            data[(size_t) y * stride + x].blue = (unsigned char) b;
+        }
+    }
+
+    // Libération de la mémoire
+    free(Y);
+    free(U);
+    free(V);
+}
+
+/**
+ * Égalisation de la luminance d'une image 24 bits par ajout de la variation de luminance
+ * aux trois canaux (variante en un passage)
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ */
+void ref_equalizeLuma24(t_pixel *data, int width, int height, int stride) {
+    unsigned int hist[256] = {0};
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            hist[ref_lumaFloor(&data[(size_t) y * stride + x])]++;
+        }
+    }
+
+    unsigned char lut[256];
+    ref_equalizationLut(hist, lut);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            t_pixel *p = &data[(size_t) y * stride + x];
+            int delta = (int) lut[ref_lumaFloor(p)] - (int) ref_lumaFloor(p);
+            p->red = ref_clamp(p->red + delta);
+            p->green = ref_clamp(p->green + delta);
+            p->blue = ref_clamp(p->blue + delta);
+        }
+    }
+}
+
+/**
+ * Luminance BT.601 en virgule fixe Q14
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance
+ */
+uint8_t ref_luma(const t_pixel *p) {
+    return (uint8_t) ref_round(REF_LUMA_R * p->red + REF_LUMA_G * p->green + REF_LUMA_B * p->blue, REF_Q14_SHIFT);
+}
+
+/**
+ * Luminance BT.601 tronquée, calculée en flottant comme l'égalisation YUV d'origine
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance
+ */
+uint8_t ref_lumaFloor(const t_pixel *p) {
+    float y = 0.299 * p->red + 0.587 * p->green + 0.114 * p->blue;
+    return (unsigned char) (y < 0 ? 0 : (y > 255 ? 255 : y));
+}
+
+/**
+ * Conversion d'un pixel RGB en YCbCr pleine échelle
+ *
+ * @param p Le pixel
+ * @param y Reçoit la luminance
+ * @param cb Reçoit la chrominance bleue
+ * @param cr Reçoit la chrominance rouge
+ */
+void ref_rgbToYCbCr(const t_pixel *p, uint8_t *y, uint8_t *cb, uint8_t *cr) {
+    int32_t r = p->red, g = p->green, b = p->blue;
+    *y = ref_luma(p);
+    *cb = ref_clamp(128 + ref_round(REF_CB_R * r + REF_CB_G * g + REF_CB_B * b, REF_Q14_SHIFT));
+    *cr = ref_clamp(128 + ref_round(REF_CR_R * r + REF_CR_G * g + REF_CR_B * b, REF_Q14_SHIFT));
+}
+
+/**
+ * Conversion d'un pixel YCbCr pleine échelle en RGB
+ *
+ * @param y La luminance
+ * @param cb La chrominance bleue
+ * @param cr La chrominance rouge
+ * @return t_pixel: Le pixel RGB
+ */
+t_pixel ref_yCbCrToRgb(uint8_t y, uint8_t cb, uint8_t cr) {
+    int32_t yy = (int32_t) y << REF_Q12_SHIFT;
+    int32_t u = cb - 128;
+    int32_t v = cr - 128;
+
+    t_pixel p;
+    p.red = ref_clamp(ref_round(yy + REF_YCC_R_CR * v, REF_Q12_SHIFT));
+    p.green = ref_clamp(ref_round(yy + REF_YCC_G_CB * u + REF_YCC_G_CR * v, REF_Q12_SHIFT));
+    p.blue = ref_clamp(ref_round(yy + REF_YCC_B_CB * u, REF_Q12_SHIFT));
+    p.alpha = 0;
+    return p;
+}
+
+/**
+ * Conversion d'un pixel RGB en YUV (BT.601 analogique)
+ *
+ * @param p Le pixel
+ * @param y Reçoit la luminance
+ * @param u Reçoit la chrominance U
+ * @param v Reçoit la chrominance V
+ */
+void ref_rgbToYuv(const t_pixel *p, uint8_t *y, int16_t *u, int16_t *v) {
+    int32_t r = p->red, g = p->green, b = p->blue;
+    *y = ref_luma(p);
+    *u = (int16_t) ref_round(REF_U_R * r + REF_U_G * g + REF_U_B * b, REF_Q14_SHIFT);
+    *v = (int16_t) ref_round(REF_V_R * r + REF_V_G * g + REF_V_B * b, REF_Q14_SHIFT);
+}
+
+/**
+ * Conversion d'un pixel YUV en RGB
+ *
+ * @param y La luminance
+ * @param u La chrominance U
+ * @param v La chrominance V
+ * @return t_pixel: Le pixel RGB
+ */
+t_pixel ref_yuvToRgb(uint8_t y, int16_t u, int16_t v) {
+    int32_t yy = (int32_t) y << REF_Q12_SHIFT;
+
+    t_pixel p;
+    p.red = ref_clamp(ref_round(yy + REF_YUV_R_V * v, REF_Q12_SHIFT));
+    p.green = ref_clamp(ref_round(yy + REF_YUV_G_U * u + REF_YUV_G_V * v, REF_Q12_SHIFT));
+    p.blue = ref_clamp(ref_round(yy + REF_YUV_B_U * u, REF_Q12_SHIFT));
+    p.alpha = 0;
+    return p;
+}
+
+/**
+ * Érosion (minimum) ou dilatation (maximum) par un rectangle seWidth x seHeight ancré
+ * en (anchorX, anchorY), voisins hors de l'image ignorés
+ */
+static void ref_morphAnchored(unsigned char *data, int width, int height, int stride,
+                              int seWidth, int seHeight, int anchorX, int anchorY, int isMax) {
+    unsigned char *copy = (unsigned char *) malloc((size_t) width * height);
+    if (copy == NULL) {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la référence\n");
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(copy + (size_t) y * width, data + (ptrdiff_t) y * stride, width);
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            unsigned char value = isMax ? 0 : 255;
+            for (int sy = y - anchorY; sy < y - anchorY + seHeight; sy++) {
+                if (sy < 0 || sy >= height) continue;
+                for (int sx = x - anchorX; sx < x - anchorX + seWidth; sx++) {
+                    if (sx < 0 || sx >= width) continue;
+                    unsigned char neighbor = copy[(size_t) sy * width + sx];
+                    if (isMax ? neighbor > value : neighbor < value) value = neighbor;
+                }
+            }
+            data[(ptrdiff_t) y * stride + x] = value;
+        }
+    }
+
+    free(copy);
+}
+
+/**
+ * Érosion (minimum) ou dilatation (maximum) par un rectangle seWidth x seHeight ancré
+ * en (seWidth / 2, seHeight / 2), voisins hors de l'image ignorés
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ */
+void ref_morph8(unsigned char *data, int width, int height, int stride,
+                int seWidth, int seHeight, int isMax) {
+    ref_morphAnchored(data, width, height, stride, seWidth, seHeight, seWidth / 2, seHeight / 2, isMax);
+}
+
+/**
+ * Ouverture (isClose = 0) ou fermeture (isClose = 1) : seconde étape avec l'élément réfléchi,
+ * ancré en ((seWidth - 1) / 2, (seHeight - 1) / 2)
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isClose 1 pour la fermeture, 0 pour l'ouverture
+ */
+void ref_openClose8(unsigned char *data, int width, int height, int stride,
+                    int seWidth, int seHeight, int isClose) {
+    ref_morph8(data, width, height, stride, seWidth, seHeight, isClose);
+    ref_morphAnchored(data, width, height, stride, seWidth, seHeight, (seWidth - 1) / 2, (seHeight - 1) / 2,
+                      !isClose);
+}
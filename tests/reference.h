@@ -0,0 +1,182 @@
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+#include <stdint.h>
+
+#include "../src/color.h"
+#include "../src/utils/utils.h"
+
+// Implémentations scalaires de référence, figées : chaque fonction reproduit pixel par pixel,
+// sans table, sans copie compacte, sans SIMD ni OpenMP, le calcul que la bibliothèque doit donner.
+// Ces fonctions ne doivent pas être optimisées : toute variante rapide de la bibliothèque est
+// comparée à elles par le programme tests.
+// Les images 8 bits sont décrites comme une t_view8 (pas signé : ordre de stockage ou vue de haut en bas),
+// les images 24 bits comme une t_view24 (rangées de haut en bas) ; l'alpha des pixels n'est jamais modifié.
+
+/**
+ * Ramène une coordonnée hors de l'image dans l'intervalle [0, size - 1] selon la politique de bord
+ *
+ * @param pos La coordonnée
+ * @param size La taille de la dimension
+ * @param mode La politique de bord
+ * @return int: La coordonnée dans l'image, ou -1 si le voisin n'existe pas
+ */
+int ref_borderIndex(int pos, int size, t_border_mode mode);
+
+/**
+ * Convolution 8 bits pixel par pixel (somme en float dans l'ordre des lignes puis des colonnes du noyau)
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param kernel Le noyau (kernelSize x kernelSize)
+ * @param kernelSize Taille du noyau (impaire)
+ * @param border La politique de bord
+ * @param constant Valeur hors de l'image pour BORDER_CONSTANT
+ */
+void ref_filter8(unsigned char *data, int width, int height, int stride,
+                 float **kernel, int kernelSize, t_border_mode border, unsigned char constant);
+
+/**
+ * Convolution 24 bits pixel par pixel, canal par canal
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ * @param kernel Le noyau (kernelSize x kernelSize)
+ * @param kernelSize Taille du noyau (impaire)
+ * @param border La politique de bord
+ * @param constant Couleur hors de l'image pour BORDER_CONSTANT
+ */
+void ref_filter24(t_pixel *data, int width, int height, int stride,
+                  float **kernel, int kernelSize, t_border_mode border, t_pixel constant);
+
+/**
+ * Table d'égalisation d'histogramme (CDF normalisée, arrondie au plus proche)
+ *
+ * @param hist L'histogramme
+ * @param lut Reçoit la nouvelle valeur de chaque niveau
+ */
+void ref_equalizationLut(const unsigned int hist[256], unsigned char lut[256]);
+
+/**
+ * Égalisation d'histogramme d'une image 8 bits
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ */
+void ref_equalize8(unsigned char *data, int width, int height, int stride);
+
+/**
+ * Égalisation de la luminance d'une image 24 bits par conversion YUV en virgule flottante
+ * (version d'origine de bmp24_equalize)
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ */
+void ref_equalize24(t_pixel *data, int width, int height, int stride);
+
+/**
+ * Égalisation de la luminance d'une image 24 bits par ajout de la variation de luminance
+ * aux trois canaux (variante en un passage)
+ *
+ * @param data Premier pixel de la rangée du haut
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Pixels entre deux rangées
+ */
+void ref_equalizeLuma24(t_pixel *data, int width, int height, int stride);
+
+/**
+ * Luminance BT.601 en virgule fixe Q14
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance
+ */
+uint8_t ref_luma(const t_pixel *p);
+
+/**
+ * Luminance BT.601 tronquée, calculée en flottant comme l'égalisation YUV d'origine
+ *
+ * @param p Le pixel
+ * @return uint8_t: La luminance
+ */
+uint8_t ref_lumaFloor(const t_pixel *p);
+
+/**
+ * Conversion d'un pixel RGB en YCbCr pleine échelle
+ *
+ * @param p Le pixel
+ * @param y Reçoit la luminance
+ * @param cb Reçoit la chrominance bleue
+ * @param cr Reçoit la chrominance rouge
+ */
+void ref_rgbToYCbCr(const t_pixel *p, uint8_t *y, uint8_t *cb, uint8_t *cr);
+
+/**
+ * Conversion d'un pixel YCbCr pleine échelle en RGB
+ *
+ * @param y La luminance
+ * @param cb La chrominance bleue
+ * @param cr La chrominance rouge
+ * @return t_pixel: Le pixel RGB (alpha nul)
+ */
+t_pixel ref_yCbCrToRgb(uint8_t y, uint8_t cb, uint8_t cr);
+
+/**
+ * Conversion d'un pixel RGB en YUV (BT.601 analogique)
+ *
+ * @param p Le pixel
+ * @param y Reçoit la luminance
+ * @param u Reçoit la chrominance U
+ * @param v Reçoit la chrominance V
+ */
+void ref_rgbToYuv(const t_pixel *p, uint8_t *y, int16_t *u, int16_t *v);
+
+/**
+ * Conversion d'un pixel YUV en RGB
+ *
+ * @param y La luminance
+ * @param u La chrominance U
+ * @param v La chrominance V
+ * @return t_pixel: Le pixel RGB (alpha nul)
+ */
+t_pixel ref_yuvToRgb(uint8_t y, int16_t u, int16_t v);
+
+/**
+ * Érosion (minimum) ou dilatation (maximum) par un rectangle seWidth x seHeight ancré
+ * en (seWidth / 2, seHeight / 2), voisins hors de l'image ignorés
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isMax 1 pour la dilatation, 0 pour l'érosion
+ */
+void ref_morph8(unsigned char *data, int width, int height, int stride,
+                int seWidth, int seHeight, int isMax);
+
+/**
+ * Ouverture (isClose = 0) ou fermeture (isClose = 1) : seconde étape avec l'élément réfléchi,
+ * ancré en ((seWidth - 1) / 2, (seHeight - 1) / 2)
+ *
+ * @param data Premier pixel de la première rangée
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param stride Octets entre une rangée et la suivante (négatif pour une vue de haut en bas)
+ * @param seWidth Largeur de l'élément structurant
+ * @param seHeight Hauteur de l'élément structurant
+ * @param isClose 1 pour la fermeture, 0 pour l'ouverture
+ */
+void ref_openClose8(unsigned char *data, int width, int height, int stride,
+                    int seWidth, int seHeight, int isClose);
+
+#endif //REFERENCE_H
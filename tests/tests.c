@@ -0,0 +1,1168 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/bitmap.h"
+#include "../src/bmp8.h"
+#include "../src/color.h"
+#include "../src/colorspace.h"
+#include "../src/histogram.h"
+#include "../src/history.h"
+#include "../src/morphology.h"
+#include "reference.h"
+
+// Comparaison des fonctions de la bibliothèque avec les implémentations de référence figées
+// (reference.c) sur des images aléatoires de nombreuses tailles, dont des largeurs impaires
+// (octets de bourrage en fin de rangée 8 bits) et une image assez grande pour les chemins OpenMP.
+// Code de retour non nul si une fonction promise identique à sa référence en diffère d'un seul octet.
+
+#define TEST_MAX_CHECKS 48
+#define TEST_MAX_KERNEL 7
+
+typedef enum {
+    FILL_NOISE = 0, // Octets uniformes
+    FILL_BINARY, // Seulement 0 et 255
+    FILL_NARROW, // Quelques niveaux proches (histogramme étroit)
+    FILL_CONSTANT, // Une seule valeur
+    FILL_COUNT
+} t_test_fill;
+
+typedef struct {
+    const char *name;
+    int tolerance; // Plus grand écart accepté (0 : promise identique à la référence)
+    long cases;
+    long mismatches; // Octets différents
+    int maxDiff; // Plus grand écart absolu
+} t_test_check;
+
+typedef struct {
+    int width;
+    int height;
+} t_test_size;
+
+static const t_test_size testSizes[] = {
+    {1, 1}, {2, 3}, {3, 5}, {5, 2}, {7, 7}, {13, 17}, {17, 13}, {31, 1}, {1, 31}, {33, 65},
+    {64, 64}, {101, 77}, {255, 3}, {257, 129}, {513, 257}, {641, 479}
+};
+#define TEST_SIZE_COUNT ((int) (sizeof(testSizes) / sizeof(testSizes[0])))
+
+static const t_border_mode testBorders[] = {BORDER_CLAMP, BORDER_MIRROR, BORDER_WRAP, BORDER_CONSTANT, BORDER_SKIP};
+#define TEST_BORDER_COUNT ((int) (sizeof(testBorders) / sizeof(testBorders[0])))
+
+static t_test_check testChecks[TEST_MAX_CHECKS];
+static int testCheckCount = 0;
+static uint32_t testState = 2463534242u;
+
+/**
+ * Générateur pseudo-aléatoire xorshift32 (reproductible d'une plateforme à l'autre)
+ *
+ * @return uint32_t: Le nombre suivant
+ */
+static uint32_t test_random(void) {
+    testState ^= testState << 13;
+    testState ^= testState >> 17;
+    testState ^= testState << 5;
+    return testState;
+}
+
+/**
+ * Tire un entier dans [low, high]
+ */
+static int test_randomInt(int low, int high) {
+    return low + (int) (test_random() % (uint32_t) (high - low + 1));
+}
+
+/**
+ * Déclare une vérification
+ *
+ * @param name Nom affiché dans le rapport
+ * @param tolerance Plus grand écart accepté par octet (0 : un seul octet différent est un échec)
+ * @return t_test_check*: La vérification à mettre à jour
+ */
+static t_test_check *test_check(const char *name, int tolerance) {
+    if (testCheckCount == TEST_MAX_CHECKS) {
+        fprintf(stderr, "Trop de vérifications (TEST_MAX_CHECKS)\n");
+        exit(1);
+    }
+    t_test_check *check = &testChecks[testCheckCount++];
+    check->name = name;
+    check->tolerance = tolerance;
+    check->cases = 0;
+    check->mismatches = 0;
+    check->maxDiff = 0;
+    return check;
+}
+
+/**
+ * Compare deux suites d'octets et reporte les écarts dans la vérification
+ *
+ * @param check La vérification
+ * @param actual Résultat de la bibliothèque
+ * @param expected Résultat de la référence
+ * @param size Nombre d'octets
+ */
+static void test_compare(t_test_check *check, const unsigned char *actual, const unsigned char *expected, size_t size) {
+    check->cases++;
+    for (size_t i = 0; i < size; i++) {
+        int diff = abs((int) actual[i] - (int) expected[i]);
+        if (diff == 0) continue;
+        check->mismatches++;
+        if (diff > check->maxDiff) check->maxDiff = diff;
+    }
+}
+
+/**
+ * Tire un octet selon le motif de remplissage
+ */
+static unsigned char test_randomByte(t_test_fill fill, unsigned char base) {
+    switch (fill) {
+        case FILL_BINARY:
+            return (test_random() & 1) ? 255 : 0;
+        case FILL_NARROW:
+            return (unsigned char) (base + test_randomInt(0, 5));
+        case FILL_CONSTANT:
+            return base;
+        default:
+            return (unsigned char) test_random();
+    }
+}
+
+/**
+ * Crée une image 8 bits aléatoire (octets de bourrage compris)
+ *
+ * @param width Largeur en pixels
+ * @param height Hauteur en pixels
+ * @param fill Le motif
+ * @return t_bmp8*: L'image, ou NULL en cas d'erreur
+ */
+static t_bmp8 *test_makeBmp8(int width, int height, t_test_fill fill) {
+    t_bmp8 *img = bmp8_allocate((unsigned int) width, (unsigned int) height);
+    if (img == NULL) return NULL;
+
+    unsigned char base = (unsigned char) test_randomInt(0, 250);
+    for (unsigned int i = 0; i < img->dataSize; i++) {
+        img->data[i] = test_randomByte(fill, base);
+    }
+    return img;
+}
+
+/**
+ * Crée une copie exacte des pixels d'une image 8 bits
+ */
+static t_bmp8 *test_cloneBmp8(const t_bmp8 *src) {
+    t_bmp8 *img = bmp8_allocate(src->width, src->height);
+    if (img == NULL) return NULL;
+    memcpy(img->data, src->data, src->dataSize);
+    return img;
+}
+
+/**
+ * Crée une image 24 bits aléatoire (le motif s'applique à chaque canal)
+ */
+static t_bmp24 *test_makeBmp24(int width, int height, t_test_fill fill) {
+    t_bmp24 *img = bmp24_allocate(width, height, 24);
+    if (img == NULL) return NULL;
+
+    unsigned char base = (unsigned char) test_randomInt(0, 250);
+    unsigned char *bytes = (unsigned char *) img->data[0];
+    for (size_t i = 0; i < (size_t) width * height * sizeof(t_pixel); i++) {
+        bytes[i] = test_randomByte(fill, base);
+    }
+    return img;
+}
+
+/**
+ * Crée une copie exacte des pixels d'une image 24 bits
+ */
+static t_bmp24 *test_cloneBmp24(const t_bmp24 *src) {
+    t_bmp24 *img = bmp24_allocate(src->width, src->height, 24);
+    if (img == NULL) return NULL;
+    memcpy(img->data[0], src->data[0], (size_t) src->width * src->height * sizeof(t_pixel));
+    return img;
+}
+
+/**
+ * Compare deux images 8 bits, octets de bourrage compris
+ */
+static void test_compareBmp8(t_test_check *check, const t_bmp8 *actual, const t_bmp8 *expected) {
+    test_compare(check, actual->data, expected->data, expected->dataSize);
+}
+
+/**
+ * Compare deux images 24 bits
+ */
+static void test_compareBmp24(t_test_check *check, const t_bmp24 *actual, const t_bmp24 *expected) {
+    test_compare(check, (const unsigned char *) actual->data[0], (const unsigned char *) expected->data[0],
+                 (size_t) expected->width * expected->height * sizeof(t_pixel));
+}
+
+/**
+ * Tire un rectangle au hasard dans une image
+ */
+static void test_randomRect(int width, int height, int *x, int *y, int *w, int *h) {
+    *w = test_randomInt(1, width);
+    *h = test_randomInt(1, height);
+    *x = test_randomInt(0, width - *w);
+    *y = test_randomInt(0, height - *h);
+}
+
+/**
+ * Remplit un noyau aléatoire dont les poids somment à peu près à 1, avec des poids négatifs
+ * pour atteindre les deux bornes de la saturation
+ */
+static void test_randomKernel(float **kernel, int kernelSize) {
+    for (int i = 0; i < kernelSize; i++) {
+        for (int j = 0; j < kernelSize; j++) {
+            kernel[i][j] = ((float) test_randomInt(-1000, 3000) / 1000.0f) / (float) (kernelSize * kernelSize);
+        }
+    }
+}
+
+// Noyaux des filtres prédéfinis, recopiés de bmp8.c et color.c
+static const float presetBox[9] = {1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f, 1 / 9.0f};
+static const float presetGaussian3[9] = {1 / 16.0f, 2 / 16.0f, 1 / 16.0f, 2 / 16.0f, 4 / 16.0f, 2 / 16.0f,
+                                         1 / 16.0f, 2 / 16.0f, 1 / 16.0f};
+static const float presetGaussian5[25] = {1 / 256.0f, 4 / 256.0f, 6 / 256.0f, 4 / 256.0f, 1 / 256.0f,
+                                          4 / 256.0f, 16 / 256.0f, 24 / 256.0f, 16 / 256.0f, 4 / 256.0f,
+                                          6 / 256.0f, 24 / 256.0f, 36 / 256.0f, 24 / 256.0f, 6 / 256.0f,
+                                          4 / 256.0f, 16 / 256.0f, 24 / 256.0f, 16 / 256.0f, 4 / 256.0f,
+                                          1 / 256.0f, 4 / 256.0f, 6 / 256.0f, 4 / 256.0f, 1 / 256.0f};
+static const float presetOutline[9] = {-1, -1, -1, -1, 8, -1, -1, -1, -1};
+static const float presetEmboss[9] = {-2, -1, 0, -1, 1, 1, 0, 1, 2};
+static const float presetSharpen[9] = {0, -1, 0, -1, 5, -1, 0, -1, 0};
+
+typedef struct {
+    const char *name;
+    void (*apply8)(t_bmp8 *);
+    void (*apply24)(t_bmp24 *);
+    const float *kernel8;
+    int kernelSize8;
+    const float *kernel24;
+    int kernelSize24;
+} t_test_preset;
+
+static const t_test_preset testPresets[] = {
+    {"flou", bmp8_box_blur, bmp24_boxBlur, presetBox, 3, presetBox, 3},
+    {"gaussien", bmp8_gaussian_blur, bmp24_gaussianBlur, presetGaussian3, 3, presetGaussian5, 5},
+    {"contours", bmp8_outline, bmp24_outline, presetOutline, 3, presetOutline, 3},
+    {"relief", bmp8_emboss, bmp24_emboss, presetEmboss, 3, presetEmboss, 3},
+    {"netteté", bmp8_sharpen, bmp24_sharpen, presetSharpen, 3, presetSharpen, 3},
+};
+#define TEST_PRESET_COUNT ((int) (sizeof(testPresets) / sizeof(testPresets[0])))
+
+/**
+ * Convolutions 8 bits : toutes les politiques de bord, image entière et zones, filtres prédéfinis
+ */
+static void test_filters8(void) {
+    t_test_check *whole = test_check("bmp8_applyFilterBorder", 0);
+    t_test_check *skip = test_check("bmp8_applyFilter", 0);
+    t_test_check *zone = test_check("view8_applyFilter (zone)", 0);
+    t_test_check *presets = test_check("bmp8 filtres prédéfinis", 0);
+
+    float rows[TEST_MAX_KERNEL][TEST_MAX_KERNEL];
+    float *kernel[TEST_MAX_KERNEL];
+    for (int i = 0; i < TEST_MAX_KERNEL; i++) kernel[i] = rows[i];
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int kernelSize = 1; kernelSize <= TEST_MAX_KERNEL; kernelSize += 2) {
+            test_randomKernel(kernel, kernelSize);
+
+            for (int b = 0; b < TEST_BORDER_COUNT; b++) {
+                unsigned char constant = (unsigned char) test_random();
+                t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+                t_bmp8 *expected = test_cloneBmp8(img);
+                bmp8_applyFilterBorder(img, kernel, kernelSize, testBorders[b], constant);
+                ref_filter8(expected->data, width, height, bmp8_rowSize(expected), kernel, kernelSize,
+                            testBorders[b], constant);
+                test_compareBmp8(whole, img, expected);
+                bmp8_free(img);
+                bmp8_free(expected);
+            }
+
+            t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+            t_bmp8 *expected = test_cloneBmp8(img);
+            bmp8_applyFilter(img, kernel, kernelSize);
+            ref_filter8(expected->data, width, height, bmp8_rowSize(expected), kernel, kernelSize, BORDER_SKIP, 0);
+            test_compareBmp8(skip, img, expected);
+
+            // Zone : seuls les pixels du rectangle changent, le voisinage s'arrête à ses bords
+            int x, y, w, h;
+            test_randomRect(width, height, &x, &y, &w, &h);
+            t_border_mode border = testBorders[test_randomInt(0, TEST_BORDER_COUNT - 1)];
+            t_view8 view = bmp8_view(img, x, y, w, h);
+            t_view8 expectedView = bmp8_view(expected, x, y, w, h);
+            view8_applyFilter(view, kernel, kernelSize, border, 128);
+            ref_filter8(expectedView.data, w, h, expectedView.stride, kernel, kernelSize, border, 128);
+            test_compareBmp8(zone, img, expected);
+            bmp8_free(img);
+            bmp8_free(expected);
+        }
+
+        for (int p = 0; p < TEST_PRESET_COUNT; p++) {
+            const t_test_preset *preset = &testPresets[p];
+            for (int i = 0; i < preset->kernelSize8; i++) {
+                memcpy(kernel[i], preset->kernel8 + i * preset->kernelSize8, preset->kernelSize8 * sizeof(float));
+            }
+            t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+            t_bmp8 *expected = test_cloneBmp8(img);
+            preset->apply8(img);
+            ref_filter8(expected->data, width, height, bmp8_rowSize(expected), kernel, preset->kernelSize8,
+                        BORDER_SKIP, 0);
+            test_compareBmp8(presets, img, expected);
+            bmp8_free(img);
+            bmp8_free(expected);
+        }
+    }
+}
+
+/**
+ * Convolutions 24 bits : toutes les politiques de bord, convolution d'un pixel, zones, filtres prédéfinis
+ */
+static void test_filters24(void) {
+    t_test_check *whole = test_check("bmp24_applyFilter", 0);
+    t_test_check *single = test_check("bmp24_convolution", 0);
+    t_test_check *zone = test_check("view24_applyFilter (zone)", 0);
+    t_test_check *presets = test_check("bmp24 filtres prédéfinis", 0);
+
+    float rows[TEST_MAX_KERNEL][TEST_MAX_KERNEL];
+    float *kernel[TEST_MAX_KERNEL];
+    for (int i = 0; i < TEST_MAX_KERNEL; i++) kernel[i] = rows[i];
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int kernelSize = 1; kernelSize <= TEST_MAX_KERNEL; kernelSize += 2) {
+            test_randomKernel(kernel, kernelSize);
+
+            for (int b = 0; b < TEST_BORDER_COUNT; b++) {
+                t_pixel constant = {(uint8_t) test_random(), (uint8_t) test_random(), (uint8_t) test_random(), 255};
+                t_bmp24 *img = test_makeBmp24(width, height, FILL_NOISE);
+                t_bmp24 *expected = test_cloneBmp24(img);
+                bmp24_applyFilter(img, kernel, kernelSize, testBorders[b], constant);
+                ref_filter24(expected->data[0], width, height, width, kernel, kernelSize, testBorders[b], constant);
+                test_compareBmp24(whole, img, expected);
+                bmp24_free(img);
+                bmp24_free(expected);
+            }
+
+            // Convolution d'un pixel (bords répétés), calculée sur l'image d'origine
+            t_bmp24 *img = test_makeBmp24(width, height, FILL_NOISE);
+            t_bmp24 *expected = test_cloneBmp24(img);
+            t_bmp24 *actual = test_cloneBmp24(img);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    actual->data[y][x] = bmp24_convolution(img, x, y, kernel, kernelSize);
+                }
+            }
+            t_pixel black = {0, 0, 0, 255};
+            ref_filter24(expected->data[0], width, height, width, kernel, kernelSize, BORDER_CLAMP, black);
+            test_compareBmp24(single, actual, expected);
+            bmp24_free(actual);
+
+            int x, y, w, h;
+            test_randomRect(width, height, &x, &y, &w, &h);
+            t_border_mode border = testBorders[test_randomInt(0, TEST_BORDER_COUNT - 1)];
+            t_pixel gray = {128, 128, 128, 255};
+            memcpy(expected->data[0], img->data[0], (size_t) width * height * sizeof(t_pixel));
+            t_view24 view = bmp24_view(img, x, y, w, h);
+            t_view24 expectedView = bmp24_view(expected, x, y, w, h);
+            view24_applyFilter(view, kernel, kernelSize, border, gray);
+            ref_filter24(expectedView.data, w, h, expectedView.stride, kernel, kernelSize, border, gray);
+            test_compareBmp24(zone, img, expected);
+            bmp24_free(img);
+            bmp24_free(expected);
+        }
+
+        for (int p = 0; p < TEST_PRESET_COUNT; p++) {
+            const t_test_preset *preset = &testPresets[p];
+            for (int i = 0; i < preset->kernelSize24; i++) {
+                memcpy(kernel[i], preset->kernel24 + i * preset->kernelSize24, preset->kernelSize24 * sizeof(float));
+            }
+            t_pixel black = {0, 0, 0, 255};
+            t_bmp24 *img = test_makeBmp24(width, height, FILL_NOISE);
+            t_bmp24 *expected = test_cloneBmp24(img);
+            preset->apply24(img);
+            ref_filter24(expected->data[0], width, height, width, kernel, preset->kernelSize24, BORDER_CLAMP, black);
+            test_compareBmp24(presets, img, expected);
+            bmp24_free(img);
+            bmp24_free(expected);
+        }
+    }
+}
+
+/**
+ * Égalisation 8 bits : directe, en mode palette, avec le cache d'histogramme, sur une zone
+ */
+static void test_equalize8(void) {
+    t_test_check *direct = test_check("bmp8_equalize", 0);
+    t_test_check *palette = test_check("bmp8_equalize (palette)", 0);
+    t_test_check *cached = test_check("bmp8_equalize (cache)", 0);
+    t_test_check *zone = test_check("view8_equalize (zone)", 0);
+    t_test_check *histogram = test_check("bmp8_computeHistogram", 0);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int f = 0; f < FILL_COUNT; f++) {
+            t_bmp8 *img = test_makeBmp8(width, height, (t_test_fill) f);
+            t_bmp8 *expected = test_cloneBmp8(img);
+            unsigned int stride = bmp8_rowSize(expected);
+
+            // Histogramme : comparé comme une suite d'octets, écart exprimé en nombre de pixels
+            unsigned int hist[256], expectedHist[256] = {0};
+            bmp8_computeHistogramInto(img, hist);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) expectedHist[expected->data[(size_t) y * stride + x]]++;
+            }
+            histogram->cases++;
+            for (int i = 0; i < 256; i++) {
+                int diff = abs((int) hist[i] - (int) expectedHist[i]);
+                if (diff == 0) continue;
+                histogram->mismatches++;
+                if (diff > histogram->maxDiff) histogram->maxDiff = diff;
+            }
+
+            t_bmp8 *work = test_cloneBmp8(img);
+            bmp8_equalize(work);
+            ref_equalize8(expected->data, width, height, stride);
+            test_compareBmp8(direct, work, expected);
+            bmp8_free(work);
+
+            // Mode palette : seule la palette change, les pixels sont réécrits à la sortie du mode
+            work = test_cloneBmp8(img);
+            bmp8_setPaletteMode(work, 1);
+            bmp8_equalize(work);
+            bmp8_setPaletteMode(work, 0);
+            test_compareBmp8(palette, work, expected);
+            bmp8_free(work);
+
+            // Cache : l'histogramme mis à jour par le négatif doit donner la même égalisation
+            work = test_cloneBmp8(img);
+            memcpy(expected->data, img->data, img->dataSize);
+            bmp8_enableHistogramCache(work, 1);
+            bmp8_computeHistogramInto(work, hist);
+            bmp8_negative(work);
+            bmp8_equalize(work);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    expected->data[(size_t) y * stride + x] = 255 - expected->data[(size_t) y * stride + x];
+                }
+            }
+            ref_equalize8(expected->data, width, height, stride);
+            test_compareBmp8(cached, work, expected);
+            bmp8_free(work);
+
+            int x, y, w, h;
+            test_randomRect(width, height, &x, &y, &w, &h);
+            memcpy(expected->data, img->data, img->dataSize);
+            t_view8 view = bmp8_view(img, x, y, w, h);
+            t_view8 expectedView = bmp8_view(expected, x, y, w, h);
+            view8_equalize(view);
+            ref_equalize8(expectedView.data, w, h, expectedView.stride);
+            test_compareBmp8(zone, img, expected);
+
+            bmp8_free(img);
+            bmp8_free(expected);
+        }
+    }
+}
+
+/**
+ * Égalisation 24 bits : YUV (bmp24_equalize), variation de luminance (en un passage, zone)
+ */
+static void test_equalize24(void) {
+    t_test_check *streaming = test_check("bmp24_equalizeStreaming", 0);
+    t_test_check *zone = test_check("view24_equalize (zone)", 0);
+    // Même table que la conversion YUV flottante d'origine (luminance tronquée) ; seule la reconversion
+    // diffère : arrondie en virgule fixe, ou variation de luminance ajoutée aux canaux
+    t_test_check *yuv = test_check("bmp24_equalize vs YUV flottant", 2);
+    t_test_check *approx = test_check("equalizeStreaming vs YUV", 2);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int f = 0; f < FILL_COUNT; f++) {
+            t_bmp24 *img = test_makeBmp24(width, height, (t_test_fill) f);
+            t_bmp24 *expected = test_cloneBmp24(img);
+            t_bmp24 *work = test_cloneBmp24(img);
+
+            bmp24_equalize(work);
+            ref_equalize24(expected->data[0], width, height, width);
+            test_compareBmp24(yuv, work, expected);
+
+            memcpy(work->data[0], img->data[0], (size_t) width * height * sizeof(t_pixel));
+            bmp24_equalizeStreaming(work);
+            test_compareBmp24(approx, work, expected);
+            memcpy(expected->data[0], img->data[0], (size_t) width * height * sizeof(t_pixel));
+            ref_equalizeLuma24(expected->data[0], width, height, width);
+            test_compareBmp24(streaming, work, expected);
+
+            int x, y, w, h;
+            test_randomRect(width, height, &x, &y, &w, &h);
+            memcpy(expected->data[0], img->data[0], (size_t) width * height * sizeof(t_pixel));
+            t_view24 view = bmp24_view(img, x, y, w, h);
+            t_view24 expectedView = bmp24_view(expected, x, y, w, h);
+            view24_equalize(view);
+            ref_equalizeLuma24(expectedView.data, w, h, expectedView.stride);
+            test_compareBmp24(zone, img, expected);
+
+            bmp24_free(img);
+            bmp24_free(expected);
+            bmp24_free(work);
+        }
+    }
+}
+
+/**
+ * Conversions colorimétriques (chemins SIMD et fin de suite scalaire)
+ */
+static void test_colorspace(void) {
+    t_test_check *luma = test_check("color_rgbToLuma", 0);
+    t_test_check *lumaFloor = test_check("color_rgbToLumaFloor", 0);
+    t_test_check *toYCbCr = test_check("color_rgbToYCbCr", 0);
+    t_test_check *fromYCbCr = test_check("color_yCbCrToRgb", 0);
+    t_test_check *toYuv = test_check("color_rgbToYuv", 0);
+    t_test_check *fromYuv = test_check("color_yuvToRgb", 0);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int count = testSizes[s].width * testSizes[s].height;
+        t_pixel *src = malloc((size_t) count * sizeof(t_pixel));
+        t_pixel *dst = malloc((size_t) count * sizeof(t_pixel));
+        t_pixel *expected = malloc((size_t) count * sizeof(t_pixel));
+        uint8_t *planes = malloc((size_t) 6 * count);
+        int16_t *chroma = malloc((size_t) 4 * count * sizeof(int16_t));
+        if (src == NULL || dst == NULL || expected == NULL || planes == NULL || chroma == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire\n");
+            exit(1);
+        }
+        uint8_t *y = planes, *cb = planes + count, *cr = planes + 2 * count;
+        uint8_t *ey = planes + 3 * count, *ecb = planes + 4 * count, *ecr = planes + 5 * count;
+        int16_t *u = chroma, *v = chroma + count, *eu = chroma + 2 * count, *ev = chroma + 3 * count;
+
+        unsigned char *bytes = (unsigned char *) src;
+        for (size_t i = 0; i < (size_t) count * sizeof(t_pixel); i++) bytes[i] = (unsigned char) test_random();
+
+        color_rgbToLuma(src, y, count);
+        for (int i = 0; i < count; i++) ey[i] = ref_luma(&src[i]);
+        test_compare(luma, y, ey, count);
+
+        color_rgbToLumaFloor(src, y, count);
+        for (int i = 0; i < count; i++) ey[i] = ref_lumaFloor(&src[i]);
+        test_compare(lumaFloor, y, ey, count);
+
+        color_rgbToYCbCr(src, y, cb, cr, count);
+        for (int i = 0; i < count; i++) ref_rgbToYCbCr(&src[i], &ey[i], &ecb[i], &ecr[i]);
+        test_compare(toYCbCr, planes, planes + 3 * count, (size_t) 3 * count);
+
+        // Plans quelconques : toutes les combinaisons, y compris hors de la gamme RGB
+        for (int i = 0; i < 3 * count; i++) planes[i] = (uint8_t) test_random();
+        // L'alpha de la destination doit être conservé
+        bytes = (unsigned char *) dst;
+        for (size_t i = 0; i < (size_t) count * sizeof(t_pixel); i++) bytes[i] = (unsigned char) test_random();
+        memcpy(expected, dst, (size_t) count * sizeof(t_pixel));
+        color_yCbCrToRgb(y, cb, cr, dst, count);
+        for (int i = 0; i < count; i++) {
+            t_pixel p = ref_yCbCrToRgb(y[i], cb[i], cr[i]);
+            p.alpha = expected[i].alpha;
+            expected[i] = p;
+        }
+        test_compare(fromYCbCr, (unsigned char *) dst, (unsigned char *) expected, (size_t) count * sizeof(t_pixel));
+
+        color_rgbToYuv(src, y, u, v, count);
+        for (int i = 0; i < count; i++) ref_rgbToYuv(&src[i], &ey[i], &eu[i], &ev[i]);
+        test_compare(toYuv, y, ey, count);
+        test_compare(toYuv, (unsigned char *) u, (unsigned char *) eu, (size_t) 2 * count * sizeof(int16_t));
+
+        // Luminance égalisée quelconque, chrominance issue d'un vrai pixel
+        for (int i = 0; i < count; i++) y[i] = (uint8_t) test_random();
+        color_yuvToRgb(y, u, v, dst, count);
+        for (int i = 0; i < count; i++) {
+            t_pixel p = ref_yuvToRgb(y[i], u[i], v[i]);
+            p.alpha = expected[i].alpha;
+            expected[i] = p;
+        }
+        test_compare(fromYuv, (unsigned char *) dst, (unsigned char *) expected, (size_t) count * sizeof(t_pixel));
+
+        free(src);
+        free(dst);
+        free(expected);
+        free(planes);
+        free(chroma);
+    }
+}
+
+/**
+ * Morphologie : éléments structurants pairs et impairs, images quelconques et binaires
+ */
+static void test_morphology(void) {
+    static const int elements[][2] = {{1, 1}, {3, 3}, {2, 5}, {5, 2}, {4, 4}, {7, 3}, {1, 9}, {15, 1}};
+    const int elementCount = (int) (sizeof(elements) / sizeof(elements[0]));
+    t_test_check *erode = test_check("bmp8_erode", 0);
+    t_test_check *dilate = test_check("bmp8_dilate", 0);
+    t_test_check *open = test_check("bmp8_open / bmp8_close", 0);
+    t_test_check *bounds = test_check("bmp8_open / bmp8_close (bornes)", 0);
+    t_test_check *gradient = test_check("bmp8_morphGradient", 0);
+    t_test_check *zone = test_check("view8_erode (zone)", 0);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int e = 0; e < elementCount; e++) {
+            int seWidth = elements[e][0], seHeight = elements[e][1];
+
+            for (int f = 0; f < 2; f++) {
+                t_test_fill fill = f == 0 ? FILL_NOISE : FILL_BINARY;
+                t_bmp8 *img = test_makeBmp8(width, height, fill);
+                unsigned int stride = bmp8_rowSize(img);
+
+                t_bmp8 *work = test_cloneBmp8(img);
+                t_bmp8 *expected = test_cloneBmp8(img);
+                bmp8_erode(work, seWidth, seHeight);
+                ref_morph8(expected->data, width, height, stride, seWidth, seHeight, 0);
+                test_compareBmp8(erode, work, expected);
+
+                // Gradient = dilatation - érosion, l'érosion de référence est déjà dans expected
+                t_bmp8 *dilated = test_cloneBmp8(img);
+                ref_morph8(dilated->data, width, height, stride, seWidth, seHeight, 1);
+                memcpy(work->data, img->data, img->dataSize);
+                bmp8_morphGradient(work, seWidth, seHeight);
+                for (int y = 0; y < height; y++) {
+                    for (int x = 0; x < width; x++) {
+                        size_t i = (size_t) y * stride + x;
+                        expected->data[i] = (unsigned char) (dilated->data[i] - expected->data[i]);
+                    }
+                }
+                test_compareBmp8(gradient, work, expected);
+
+                memcpy(work->data, img->data, img->dataSize);
+                bmp8_dilate(work, seWidth, seHeight);
+                test_compareBmp8(dilate, work, dilated);
+
+                // Ouverture : érosion puis dilatation par l'élément réfléchi ; fermeture : l'inverse.
+                // L'ouverture ne dépasse jamais l'image et la fermeture n'est jamais en dessous
+                memcpy(work->data, img->data, img->dataSize);
+                memcpy(expected->data, img->data, img->dataSize);
+                bmp8_open(work, seWidth, seHeight);
+                ref_openClose8(expected->data, width, height, stride, seWidth, seHeight, 0);
+                test_compareBmp8(open, work, expected);
+                for (unsigned int i = 0; i < img->dataSize; i++) {
+                    expected->data[i] = work->data[i] < img->data[i] ? work->data[i] : img->data[i];
+                }
+                test_compareBmp8(bounds, work, expected);
+
+                memcpy(work->data, img->data, img->dataSize);
+                memcpy(expected->data, img->data, img->dataSize);
+                bmp8_close(work, seWidth, seHeight);
+                ref_openClose8(expected->data, width, height, stride, seWidth, seHeight, 1);
+                test_compareBmp8(open, work, expected);
+                for (unsigned int i = 0; i < img->dataSize; i++) {
+                    expected->data[i] = work->data[i] > img->data[i] ? work->data[i] : img->data[i];
+                }
+                test_compareBmp8(bounds, work, expected);
+
+                int x, y, w, h;
+                test_randomRect(width, height, &x, &y, &w, &h);
+                memcpy(work->data, img->data, img->dataSize);
+                memcpy(expected->data, img->data, img->dataSize);
+                t_view8 view = bmp8_view(work, x, y, w, h);
+                t_view8 expectedView = bmp8_view(expected, x, y, w, h);
+                view8_erode(view, seWidth, seHeight);
+                ref_morph8(expectedView.data, w, h, expectedView.stride, seWidth, seHeight, 0);
+                test_compareBmp8(zone, work, expected);
+
+                bmp8_free(img);
+                bmp8_free(work);
+                bmp8_free(expected);
+                bmp8_free(dilated);
+            }
+        }
+    }
+}
+
+/**
+ * Images binaires compactées : seuillage, décompactage et morphologie sans décompactage
+ */
+static void test_bitmap(void) {
+    static const int elements[][2] = {{1, 1}, {3, 3}, {2, 5}, {5, 2}, {7, 3}, {1, 9}, {15, 1}, {70, 3}};
+    const int elementCount = (int) (sizeof(elements) / sizeof(elements[0]));
+    t_test_check *threshold = test_check("bmp8_toBitmap / bitmap_count", 0);
+    t_test_check *erode = test_check("bitmap_erode", 0);
+    t_test_check *dilate = test_check("bitmap_dilate", 0);
+    t_test_check *open = test_check("bitmap_open / bitmap_close", 0);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        for (int e = 0; e < elementCount; e++) {
+            int seWidth = elements[e][0], seHeight = elements[e][1];
+            t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+            unsigned int stride = bmp8_rowSize(img);
+            int level = test_randomInt(0, 256);
+
+            // Seuillage de référence (même règle que bmp8_threshold), octets de bourrage à 0
+            t_bmp8 *expected = bmp8_allocate((unsigned int) width, (unsigned int) height);
+            long white = 0;
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    size_t i = (size_t) y * stride + x;
+                    expected->data[i] = img->data[i] >= level ? 255 : 0;
+                    white += expected->data[i] != 0;
+                }
+            }
+
+            t_bitmap *bitmap = bmp8_toBitmap(img, level);
+            t_bmp8 *work = bitmap_toBmp8(bitmap);
+            long count = bitmap_count(bitmap);
+            test_compareBmp8(threshold, work, expected);
+            test_compare(threshold, (const unsigned char *) &count, (const unsigned char *) &white, sizeof(long));
+            bmp8_free(work);
+
+            t_bitmap *eroded = bmp8_toBitmap(img, level);
+            t_bmp8 *erodedExpected = test_cloneBmp8(expected);
+            bitmap_erode(eroded, seWidth, seHeight);
+            ref_morph8(erodedExpected->data, width, height, stride, seWidth, seHeight, 0);
+            work = bitmap_toBmp8(eroded);
+            test_compareBmp8(erode, work, erodedExpected);
+            bmp8_free(work);
+
+            for (int c = 0; c < 2; c++) {
+                t_bitmap *opened = bmp8_toBitmap(img, level);
+                t_bmp8 *openedExpected = test_cloneBmp8(expected);
+                if (c == 0) bitmap_open(opened, seWidth, seHeight);
+                else bitmap_close(opened, seWidth, seHeight);
+                ref_openClose8(openedExpected->data, width, height, stride, seWidth, seHeight, c);
+                work = bitmap_toBmp8(opened);
+                test_compareBmp8(open, work, openedExpected);
+                bmp8_free(work);
+                bmp8_free(openedExpected);
+                bitmap_free(opened);
+            }
+
+            bitmap_dilate(bitmap, seWidth, seHeight);
+            ref_morph8(expected->data, width, height, stride, seWidth, seHeight, 1);
+            work = bitmap_toBmp8(bitmap);
+            test_compareBmp8(dilate, work, expected);
+            bmp8_free(work);
+
+            bitmap_free(bitmap);
+            bitmap_free(eroded);
+            bmp8_free(erodedExpected);
+            bmp8_free(expected);
+            bmp8_free(img);
+        }
+    }
+}
+
+/**
+ * Écrit dans ../images un fichier BMP réduit à son en-tête et à une palette de 256 entrées nulles
+ *
+ * @param name Nom du fichier dans ../images
+ * @param width Largeur écrite dans l'en-tête
+ * @param height Hauteur écrite dans l'en-tête (négative : de haut en bas)
+ * @param depth Profondeur de couleur
+ * @return int: 0 en cas de succès, -1 si le fichier ne peut pas être créé
+ */
+static int test_writeHeader(const char *name, int32_t width, int32_t height, uint16_t depth) {
+    unsigned char header[54 + 1024] = {'B', 'M'};
+    uint32_t offset = sizeof(header), infoSize = 40;
+    uint16_t planes = 1;
+    memcpy(header + 10, &offset, 4);
+    memcpy(header + 14, &infoSize, 4);
+    memcpy(header + 18, &width, 4);
+    memcpy(header + 22, &height, 4);
+    memcpy(header + 26, &planes, 2);
+    memcpy(header + 28, &depth, 2);
+
+    char path[512];
+    snprintf(path, sizeof(path), "../images/%s", name);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return -1;
+    size_t written = fwrite(header, 1, sizeof(header), file);
+    fclose(file);
+    return written == sizeof(header) ? 0 : -1;
+}
+
+/**
+ * Lit entièrement un fichier de ../images
+ *
+ * @param name Nom du fichier dans ../images
+ * @param size Reçoit la taille du fichier
+ * @return unsigned char*: Le contenu (à libérer avec free), ou NULL en cas d'erreur
+ */
+static unsigned char *test_readFile(const char *name, size_t *size) {
+    char path[512];
+    snprintf(path, sizeof(path), "../images/%s", name);
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    unsigned char *bytes = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    if (length >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+        bytes = (unsigned char *) malloc((size_t) length + 1);
+        if (bytes != NULL && fread(bytes, 1, (size_t) length, file) != (size_t) length) {
+            free(bytes);
+            bytes = NULL;
+        }
+    }
+    fclose(file);
+    *size = (size_t) length;
+    return bytes;
+}
+
+/**
+ * Chargement : les en-têtes aux dimensions invalides ou compressés sont refusés avant toute allocation,
+ * une image de haut en bas est relue et réécrite à l'identique, l'alpha 32 bits suit la compression
+ */
+static void test_loaders(void) {
+    t_test_check *invalid = test_check("chargement (en-têtes invalides)", 0);
+    t_test_check *topDown = test_check("bmp8 de haut en bas (fichier)", 0);
+    t_test_check *alpha = test_check("bmp24 32 bits (alpha)", 0);
+
+    static const struct {
+        int32_t width;
+        int32_t height;
+        uint16_t depth;
+    } cases[] = {
+        {INT32_MAX, 1000, 4}, // Taille des données hors de dataSize, chemin décompacté
+        {65536, 65536, 1}, // Taille des données multiple de 2^32
+        {1, INT32_MIN, 1},
+        {8, 0, 8}, // Hauteur nulle
+        {70000, -70000, 8}, // De haut en bas, taille des données hors de dataSize
+    };
+    const char *name = "tests_header.bmp";
+    for (int c = 0; c < (int) (sizeof(cases) / sizeof(cases[0])); c++) {
+        if (test_writeHeader(name, cases[c].width, cases[c].height, cases[c].depth) != 0) {
+            printf("Dossier ../images inaccessible : chargements non vérifiés\n");
+            return;
+        }
+        invalid->cases++;
+        t_bmp8 *img = bmp8_loadImage(name);
+        if (img != NULL) invalid->mismatches++;
+        bmp8_free(img);
+        // Chargement direct en image binaire : hauteur sans opposé représentable
+        if (cases[c].height == INT32_MIN) {
+            invalid->cases++;
+            t_bitmap *bitmap = bitmap_loadImage(name);
+            if (bitmap != NULL) invalid->mismatches++;
+            if (bitmap != NULL) bitmap_free(bitmap);
+        }
+    }
+    remove("../images/tests_header.bmp");
+
+    // Fichier 8 bits complet et lisible, mais déclaré compressé (BI_RLE8) : refusé
+    t_bmp8 *valid = test_makeBmp8(8, 8, FILL_NOISE);
+    bmp8_saveImage(valid, name);
+    bmp8_free(valid);
+    char path[512];
+    snprintf(path, sizeof(path), "../images/%s", name);
+    FILE *file = fopen(path, "r+b");
+    if (file != NULL) {
+        uint32_t compression = 1;
+        int written = fseek(file, 30, SEEK_SET) == 0 && fwrite(&compression, 4, 1, file) == 1;
+        fclose(file);
+        invalid->cases++;
+        t_bmp8 *img = written ? bmp8_loadImage(name) : NULL;
+        if (!written || img != NULL) invalid->mismatches++;
+        bmp8_free(img);
+    }
+    remove(path);
+
+    // Aller-retour : hauteur négative dans le fichier, rangée du haut écrite en premier,
+    // image relue identique (octets de bourrage compris) et réécrite octet pour octet
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+        t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+        img->topDown = 1;
+        bmp8_saveImage(img, "tests_topdown.bmp");
+        t_bmp8 *loaded = bmp8_loadImage("tests_topdown.bmp");
+        size_t size = 0, resavedSize = 0;
+        unsigned char *file = test_readFile("tests_topdown.bmp", &size);
+        if (loaded != NULL) bmp8_saveImage(loaded, "tests_topdown2.bmp");
+        unsigned char *resaved = loaded != NULL ? test_readFile("tests_topdown2.bmp", &resavedSize) : NULL;
+
+        topDown->cases++;
+        if (loaded == NULL || file == NULL || resaved == NULL || size != 54 + 1024 + img->dataSize ||
+            resavedSize != size || !loaded->topDown) {
+            topDown->mismatches++;
+        } else {
+            int32_t fileHeight;
+            memcpy(&fileHeight, file + 22, 4);
+            if (fileHeight != -height) topDown->mismatches++;
+            unsigned int stride = bmp8_rowSize(img);
+            test_compare(topDown, file + 54 + 1024, img->data + (size_t) (height - 1) * stride, stride);
+            test_compareBmp8(topDown, loaded, img);
+            test_compare(topDown, resaved, file, size);
+        }
+
+        free(resaved);
+        free(file);
+        bmp8_free(loaded);
+        bmp8_free(img);
+    }
+    remove("../images/tests_topdown.bmp");
+    remove("../images/tests_topdown2.bmp");
+
+    // 32 bits : l'octet réservé de BI_RGB est lu opaque, l'alpha d'un fichier BI_BITFIELDS est conservé,
+    // dans les deux orientations (lecture rangée par rangée ou en un bloc)
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+        t_bmp24 *img = test_makeBmp24(width, height, FILL_NOISE);
+        img->colorDepth = 32;
+        img->topDown = s % 2;
+        t_bmp24 *opaque = test_cloneBmp24(img);
+        for (int i = 0; i < width * height; i++) opaque->data[0][i].alpha = 255;
+
+        for (int bitfields = 0; bitfields < 2; bitfields++) {
+            img->header_info.compression = bitfields ? BMP_BI_BITFIELDS : BMP_BI_RGB;
+            bmp24_saveImage(img, "tests_alpha.bmp");
+            t_bmp24 *loaded = bmp24_loadImage("tests_alpha.bmp");
+            alpha->cases++;
+            if (loaded == NULL || loaded->width != width || loaded->height != height) {
+                alpha->mismatches++;
+            } else {
+                test_compareBmp24(alpha, loaded, bitfields ? img : opaque);
+            }
+            bmp24_free(loaded);
+        }
+        bmp24_free(opaque);
+        bmp24_free(img);
+    }
+    remove("../images/tests_alpha.bmp");
+}
+
+/**
+ * Vues : même orientation en 8 et 24 bits, opérations ponctuelles 24 bits sur une zone,
+ * cache d'histogramme invalidé seulement par les modifications faites à travers une vue
+ */
+static void test_views(void) {
+    t_test_check *orientation = test_check("bmp8_view / bmp24_view", 0);
+    t_test_check *point = test_check("view24 opérations ponctuelles", 0);
+    t_test_check *cache = test_check("bmp8_view (cache)", 0);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+
+        // Orientation : la rangée r d'une vue 8 bits est la rangée r de la même vue 24 bits
+        t_bmp24 *color = test_makeBmp24(width, height, FILL_NOISE);
+        bmp24_grayscale(color);
+        t_bmp8 *gray = bmp24_toBmp8(color);
+        unsigned char *red = (unsigned char *) malloc((size_t) width);
+        if (gray == NULL || red == NULL) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour le test des vues\n");
+            exit(1);
+        }
+        int x, y, w, h;
+        test_randomRect(width, height, &x, &y, &w, &h);
+        t_view8 view8 = bmp8_view(gray, x, y, w, h);
+        t_view24 view24 = bmp24_view(color, x, y, w, h);
+        t_view8 sub = view8_sub(bmp8_view(gray, 0, 0, width, height), x, y, w, h);
+        for (int r = 0; r < h; r++) {
+            for (int c = 0; c < w; c++) red[c] = view24.data[(size_t) r * view24.stride + c].red;
+            test_compare(orientation, view8.data + (ptrdiff_t) r * view8.stride, red, (size_t) w);
+            test_compare(orientation, sub.data + (ptrdiff_t) r * sub.stride, red, (size_t) w);
+        }
+
+        // Le recadrage 8 bits suit la même convention que le recadrage 24 bits
+        t_bmp8 *crop8 = bmp8_crop(gray, x, y, w, h);
+        t_bmp24 *crop24 = bmp24_crop(color, x, y, w, h);
+        t_bmp8 *expectedCrop = bmp24_toBmp8(crop24);
+        test_compareBmp8(orientation, crop8, expectedCrop);
+        bmp8_free(expectedCrop);
+        bmp24_free(crop24);
+        bmp8_free(crop8);
+        free(red);
+
+        // Opérations ponctuelles sur une zone : même résultat que sur le recadrage recollé
+        for (int op = 0; op < 3; op++) {
+            t_bmp24 *img = test_makeBmp24(width, height, FILL_NOISE);
+            t_bmp24 *expected = test_cloneBmp24(img);
+            int value = test_randomInt(-255, 255);
+            test_randomRect(width, height, &x, &y, &w, &h);
+            t_view24 view = bmp24_view(img, x, y, w, h);
+            t_bmp24 *crop = bmp24_crop(expected, x, y, w, h);
+            if (op == 0) {
+                view24_negative(view);
+                bmp24_negative(crop);
+            } else if (op == 1) {
+                view24_brightness(view, value);
+                bmp24_brightness(crop, value);
+            } else {
+                view24_grayscale(view);
+                bmp24_grayscale(crop);
+            }
+            for (int r = 0; r < h; r++) {
+                memcpy(expected->data[y + r] + x, crop->data[r], (size_t) w * sizeof(t_pixel));
+            }
+            test_compareBmp24(point, img, expected);
+            bmp24_free(crop);
+            bmp24_free(expected);
+            bmp24_free(img);
+        }
+
+        // Cache : créer une vue ne l'invalide pas, la modifier à travers la vue si
+        t_bmp8 *work = test_cloneBmp8(gray);
+        unsigned int hist[256], expectedHist[256];
+        bmp8_enableHistogramCache(work, 1);
+        bmp8_computeHistogramInto(work, hist);
+        t_view8 zone = bmp8_view(work, x % width, y % height, 1, 1);
+        cache->cases++;
+        if (!work->histogramValid) cache->mismatches++;
+        unsigned char lut[256];
+        for (int i = 0; i < 256; i++) lut[i] = (unsigned char) (255 - i);
+        view8_applyLut(view8_sub(zone, 0, 0, 1, 1), lut);
+        bmp8_computeHistogramInto(work, hist);
+        t_bmp8 *fresh = test_cloneBmp8(work);
+        bmp8_computeHistogramInto(fresh, expectedHist);
+        test_compare(cache, (const unsigned char *) hist, (const unsigned char *) expectedHist, sizeof(hist));
+        bmp8_free(fresh);
+        bmp8_free(work);
+
+        bmp8_free(gray);
+        bmp24_free(color);
+    }
+}
+
+/**
+ * Compte les tuiles d'historique couvertes par un rectangle (rangées dans l'ordre de stockage)
+ */
+static int test_historyTiles(int x, int y, int w, int h) {
+    return ((x + w - 1) / HISTORY_TILE - x / HISTORY_TILE + 1) * ((y + h - 1) / HISTORY_TILE - y / HISTORY_TILE + 1);
+}
+
+/**
+ * Reporte dans la vérification l'écart entre le nombre de tuiles copiées et le nombre attendu
+ */
+static void test_historyCopied(t_test_check *check, const t_history *history, unsigned long before, int expected) {
+    long diff = labs((long) (history->tilesCopied - before) - expected);
+    check->cases++;
+    if (diff == 0) return;
+    check->mismatches++;
+    if (diff > check->maxDiff) check->maxDiff = diff > 255 ? 255 : (int) diff;
+}
+
+static void test_history(void) {
+    t_test_check *restore = test_check("history_undo / history_redo", 0);
+    t_test_check *copied = test_check("history_markDirty (tuiles)", 0);
+    unsigned char lut[256];
+    for (int i = 0; i < 256; i++) lut[i] = (unsigned char) (255 - i);
+
+    for (int s = 0; s < TEST_SIZE_COUNT; s++) {
+        int width = testSizes[s].width, height = testSizes[s].height;
+        t_history *history = history_create((size_t) 1 << 30);
+        t_bmp8 *img = test_makeBmp8(width, height, FILL_NOISE);
+        t_bmp24 *img24 = NULL;
+        if (history == NULL || img == NULL || history_commitBmp8(history, img) != 0) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour le test de l'historique\n");
+            exit(1);
+        }
+        t_bmp8 *original = test_cloneBmp8(img);
+
+        // Zone modifiée à travers une vue : seules ses tuiles sont copiées (8 bits : tuiles de bas en haut)
+        int x, y, w, h;
+        test_randomRect(width, height, &x, &y, &w, &h);
+        view8_applyLut(bmp8_view(img, x, y, w, h), lut);
+        history_markDirty(history, x, y, w, h);
+        unsigned long before = history->tilesCopied;
+        history_commitBmp8(history, img);
+        test_historyCopied(copied, history, before, test_historyTiles(x, height - y - h, w, h));
+        t_bmp8 *modified = test_cloneBmp8(img);
+
+        history_undo(history, &img, &img24);
+        test_compareBmp8(restore, img, original);
+        history_redo(history, &img, &img24);
+        test_compareBmp8(restore, img, modified);
+
+        // Après une annulation, les zones sont relatives à l'étape restaurée
+        history_undo(history, &img, &img24);
+        test_randomRect(width, height, &x, &y, &w, &h);
+        view8_applyLut(bmp8_view(img, x, y, w, h), lut);
+        history_markDirty(history, x, y, w, h);
+        history_commitBmp8(history, img);
+        history_undo(history, &img, &img24);
+        test_compareBmp8(restore, img, original);
+
+        // Sans zone déclarée, toute l'image est copiée
+        before = history->tilesCopied;
+        bmp8_negative(img);
+        history_commitBmp8(history, img);
+        test_historyCopied(copied, history, before, test_historyTiles(0, 0, width, height));
+        bmp8_free(modified);
+        bmp8_free(original);
+        bmp8_free(img);
+
+        // 24 bits : rangées de haut en bas
+        history_clear(history);
+        img = NULL;
+        img24 = test_makeBmp24(width, height, FILL_NOISE);
+        if (img24 == NULL || history_commitBmp24(history, img24) != 0) {
+            fprintf(stderr, "Erreur d'allocation mémoire pour le test de l'historique\n");
+            exit(1);
+        }
+        t_bmp24 *original24 = test_cloneBmp24(img24);
+        test_randomRect(width, height, &x, &y, &w, &h);
+        view24_negative(bmp24_view(img24, x, y, w, h));
+        history_markDirty(history, x, y, w, h);
+        before = history->tilesCopied;
+        history_commitBmp24(history, img24);
+        test_historyCopied(copied, history, before, test_historyTiles(x, y, w, h));
+        t_bmp24 *modified24 = test_cloneBmp24(img24);
+
+        history_undo(history, &img, &img24);
+        test_compareBmp24(restore, img24, original24);
+        history_redo(history, &img, &img24);
+        test_compareBmp24(restore, img24, modified24);
+
+        bmp24_free(modified24);
+        bmp24_free(original24);
+        bmp24_free(img24);
+        history_destroy(history);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--seed") == 0) {
+        testState = (uint32_t) strtoul(argv[2], NULL, 10);
+        if (testState == 0) testState = 1;
+    } else if (argc != 1) {
+        printf("Usage: %s [--seed n]\n", argv[0]);
+        return 1;
+    }
+    printf("Graine : %u\n", testState);
+
+    test_filters8();
+    test_filters24();
+    test_equalize8();
+    test_equalize24();
+    test_colorspace();
+    test_morphology();
+    test_bitmap();
+    test_loaders();
+    test_views();
+    test_history();
+
+    int failures = 0;
+    printf("\n%-30s %6s %10s %14s  %s\n", "Vérification", "Cas", "Écart max", "Octets diff.", "Résultat");
+    for (int c = 0; c < testCheckCount; c++) {
+        const t_test_check *check = &testChecks[c];
+        const char *result = "OK";
+        // Certaines vérifications comptent des différences sans écart (en-tête, indicateur) : échec si exactes
+        if (check->mismatches > 0 && (check->tolerance == 0 || check->maxDiff > check->tolerance)) {
+            result = "ÉCHEC";
+            failures++;
+        } else if (check->mismatches > 0) {
+            result = "écart toléré";
+        }
+        printf("%-30s %6ld %10d %14ld  %s\n", check->name, check->cases, check->maxDiff, check->mismatches, result);
+    }
+
+    if (failures > 0) {
+        printf("\n%d vérification(s) en échec\n", failures);
+        return 1;
+    }
+    printf("\nToutes les variantes sont identiques à leur référence (ou dans leur tolérance)\n");
+    return 0;
+}